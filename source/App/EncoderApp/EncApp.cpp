@@ -44,6 +44,7 @@
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "EncoderLib/AQp.h"
 #if EXTENSION_360_VIDEO
 #include "AppEncHelper360/TExt360AppEncTop.h"
 #endif
@@ -62,6 +63,18 @@ EncApp::EncApp()
   m_iFrameRcvd = 0;
   m_totalBytes = 0;
   m_essentialBytes = 0;
+  m_inputStop = false;
+  m_analysisMode = ANALYSIS_OFF;
+  m_analysis = NULL;
+  m_bitrate = 0.0;
+  for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    m_avgPsnr[comp] = 0.0;
+  }
+  for( int tId = 0; tId < MAX_TLAYER; tId++ )
+  {
+    m_layerBits[tId] = 0.0;
+  }
 }
 
 EncApp::~EncApp()
@@ -523,13 +536,14 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setSignDataHidingEnabledFlag                         ( m_signDataHidingEnabledFlag);
 #endif
 #endif
-  m_cEncLib.setUseRateCtrl                                       ( m_RCEnableRateControl );
+  m_cEncLib.setUseRateCtrl                                       ( m_RCEnableRateControl && m_RCPass != 1 );
   m_cEncLib.setTargetBitrate                                     ( m_RCTargetBitrate );
   m_cEncLib.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
   m_cEncLib.setLCULevelRC                                        ( m_RCLCULevelRC );
   m_cEncLib.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
   m_cEncLib.setInitialQP                                         ( m_RCInitialQP );
   m_cEncLib.setForceIntraQP                                      ( m_RCForceIntraQP );
+  m_cEncLib.setRCStats                                           ( m_RCPass, &m_RCStats );
 #if U0132_TARGET_BITS_SATURATION
   m_cEncLib.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
   m_cEncLib.setCpbSize                                           ( m_RCCpbSize );
@@ -593,8 +607,10 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setForceDecodeBitstream1                             ( m_forceDecodeBitstream1 );
   m_cEncLib.setStopAfterFFtoPOC                                  ( m_stopAfterFFtoPOC );
   m_cEncLib.setBs2ModPOCAndType                                  ( m_bs2ModPOCAndType );
+  m_cEncLib.setAnalysis                                          ( m_analysisMode, m_analysis );
 #if ENABLE_SPLIT_PARALLELISM
   m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
+  m_cEncLib.setNumSplitLevels                                    ( m_numSplitLevels );
   m_cEncLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
 #endif
 #if ENABLE_WPP_PARALLELISM
@@ -603,6 +619,18 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
 
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  m_cEncLib.setNumDeltaQpRDThreads                               ( m_numDeltaQpRDThreads );
+#endif
+#if ENABLE_ME_PARALLELISM
+  m_cEncLib.setNumMEThreads                                      ( m_numMEThreads );
+#endif
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  m_cEncLib.setNumLoopFilterThreads                              ( m_numLoopFilterThreads );
+#endif
 #if JVET_K0371_ALF
   m_cEncLib.setUseALF                                            ( m_alf );
 #endif
@@ -638,7 +666,11 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
   m_cEncLib.create();
 
   // create the output buffer
+#if ENABLE_FRAME_PARALLELISM
+  for( int i = 0; i < (m_cEncLib.getNumPicsPerGOP() + 1 + (m_isField ? 1 : 0)); i++ )
+#else
   for( int i = 0; i < (m_iGOPSize + 1 + (m_isField ? 1 : 0)); i++ )
+#endif
   {
     recBufList.push_back( new PelUnitBuf );
   }
@@ -679,6 +711,25 @@ void EncApp::encode()
     EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
   }
 
+  if( !m_analysisLoadFileName.empty() )
+  {
+    m_fileAnalysis.read( m_analysisLoadFileName, Size( m_iSourceWidth, m_iSourceHeight ) );
+    setAnalysis( ANALYSIS_REUSE, &m_fileAnalysis );
+  }
+  else if( !m_analysisSaveFileName.empty() )
+  {
+    setAnalysis( ANALYSIS_RECORD, &m_fileAnalysis );
+  }
+
+  if( m_RCPass == 2 )
+  {
+    m_RCStats.read( m_RCStatsFileName );
+    if( m_RCStats.getNumPictures() != m_framesToBeEncoded )
+    {
+      EXIT( "The rate control statistics file " << m_RCStatsFileName << " holds " << m_RCStats.getNumPictures() << " pictures instead of " << m_framesToBeEncoded );
+    }
+  }
+
   std::list<PelUnitBuf*> recBufList;
   // initialize internal class & member variables
   xInitLibCfg();
@@ -706,21 +757,50 @@ void EncApp::encode()
   TExt360AppEncTop           ext360(*this, m_cEncLib.getGOPEncoder()->getExt360Data(), *(m_cEncLib.getGOPEncoder()), orgPic);
 #endif
 
+  // the 360 video reader projects the input with the encoder's 360 data, it is not moved to the input thread
+#if EXTENSION_360_VIDEO
+  if( m_inputQueueSize > 0 && !ext360.isEnabled() )
+#else
+  if( m_inputQueueSize > 0 )
+#endif
+  {
+    xCreateInputQueue( unitArea );
+  }
+
   while ( !bEos )
   {
-    // read input YUV file
-#if EXTENSION_360_VIDEO
-    if (ext360.isEnabled())
+    PelStorage*                   pcOrgPic     = &orgPic;
+    PelStorage*                   pcTrueOrgPic = &trueOrgPic;
+    const std::vector<AQpLayer*>* aqLayers     = NULL;
+    InputFrame*                   inputFrame   = NULL;
+    bool                          isEof;
+
+    if( m_inputThread.joinable() )
     {
-      ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      // take the next frame of the input queue
+      inputFrame   = xGetInputFrame();
+      pcOrgPic     = &inputFrame->orgPic;
+      pcTrueOrgPic = &inputFrame->trueOrgPic;
+      aqLayers     = inputFrame->aqLayers.empty() ? NULL : &inputFrame->aqLayers;
+      isEof        = inputFrame->isEof;
     }
     else
     {
-      m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-    }
+      // read input YUV file
+#if EXTENSION_360_VIDEO
+      if (ext360.isEnabled())
+      {
+        ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      }
+      else
+      {
+        m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+      }
 #else
-    m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
 #endif
+      isEof = m_cVideoIOYuvInputFile.isEof();
+    }
 
     // increase number of received frames
     m_iFrameRcvd++;
@@ -729,7 +809,7 @@ void EncApp::encode()
 
     bool flush = 0;
     // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cVideoIOYuvInputFile.isEof())
+    if (isEof)
     {
       flush = true;
       bEos = true;
@@ -740,13 +820,18 @@ void EncApp::encode()
     // call encoding function for one frame
     if ( m_isField )
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
+      m_cEncLib.encode( bEos, flush ? 0 : pcOrgPic, flush ? 0 : pcTrueOrgPic, snrCSC, recBufList,
                         iNumEncoded, m_isTopFieldFirst );
     }
     else
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
-                        iNumEncoded );
+      m_cEncLib.encode( bEos, flush ? 0 : pcOrgPic, flush ? 0 : pcTrueOrgPic, snrCSC, recBufList,
+                        iNumEncoded, aqLayers );
+    }
+
+    if( inputFrame )
+    {
+      xReleaseInputFrame( inputFrame );
     }
 
     // write bistream to file if necessary
@@ -755,8 +840,8 @@ void EncApp::encode()
       xWriteOutput( iNumEncoded, recBufList
       );
     }
-    // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    // temporally skip frames, the input thread skips them itself
+    if( m_temporalSubsampleRatio > 1 && !inputFrame )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
@@ -766,8 +851,33 @@ void EncApp::encode()
     }
   }
 
+  xDestroyInputQueue();
+
   m_cEncLib.printSummary(m_isField);
 
+  if( !m_analysisSaveFileName.empty() )
+  {
+    m_fileAnalysis.write( m_analysisSaveFileName );
+  }
+  if( m_RCPass == 1 )
+  {
+    m_RCStats.write( m_RCStatsFileName );
+  }
+
+  const Analyze& analyzeAll = m_cEncLib.getGOPEncoder()->getAnalyzeAllData();
+  if( analyzeAll.getNumPic() )
+  {
+    m_bitrate = analyzeAll.getBits() * analyzeAll.getFrmRate() / 1000 / analyzeAll.getNumPic();
+    for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+    {
+      m_avgPsnr[comp] = analyzeAll.getPsnr( ComponentID( comp ) ) / analyzeAll.getNumPic();
+    }
+  }
+  for( int tId = 0; tId < MAX_TLAYER; tId++ )
+  {
+    m_layerBits[tId] = m_cEncLib.getGOPEncoder()->getLayerBits( tId );
+  }
+
 
   // delete used buffers in encoder class
   m_cEncLib.deletePicBuffer();
@@ -791,6 +901,123 @@ void EncApp::encode()
 // Protected member functions
 // ====================================================================================================================
 
+void EncApp::xCreateInputQueue( const UnitArea& unitArea )
+{
+  m_inputStop = false;
+
+  for( int i = 0; i < m_inputQueueSize; i++ )
+  {
+    InputFrame* inputFrame = new InputFrame;
+    inputFrame->orgPic    .create( unitArea );
+    inputFrame->trueOrgPic.create( unitArea );
+    inputFrame->isEof = false;
+    // fields are separated by the encoder, they are pre-analysed there
+    if( !m_isField )
+    {
+      m_cEncLib.createAQpLayers( inputFrame->aqLayers );
+    }
+    m_inputFrames    .push_back( inputFrame );
+    m_inputFreeFrames.push_back( inputFrame );
+  }
+
+  m_inputThread = std::thread( &EncApp::xReadInputFrames, this, m_isField ? m_framesToBeEncoded >> 1 : m_framesToBeEncoded );
+}
+
+void EncApp::xDestroyInputQueue()
+{
+  if( m_inputThread.joinable() )
+  {
+    {
+      std::unique_lock< std::mutex > lock( m_inputMutex );
+      m_inputStop = true;
+    }
+    m_inputCond.notify_all();
+    m_inputThread.join();
+  }
+
+  for( auto inputFrame : m_inputFrames )
+  {
+    inputFrame->orgPic    .destroy();
+    inputFrame->trueOrgPic.destroy();
+    for( auto aqLayer : inputFrame->aqLayers )
+    {
+      delete aqLayer;
+    }
+    delete inputFrame;
+  }
+  m_inputFrames    .clear();
+  m_inputQueue     .clear();
+  m_inputFreeFrames.clear();
+}
+
+/**
+  Input thread: reads the source frames into the free frames of the input queue, converts them and runs the AQp pre-analysis.
+  \param numFrames  number of frames to be read, the thread stops earlier at the end of the file (0: until the end of the file)
+ */
+void EncApp::xReadInputFrames( int numFrames )
+{
+  const InputColourSpaceConversion ipCSC = m_inputColourSpaceConvert;
+
+  for( int frame = 0; numFrames <= 0 || frame < numFrames; frame++ )
+  {
+    InputFrame* inputFrame = NULL;
+    {
+      std::unique_lock< std::mutex > lock( m_inputMutex );
+      m_inputCond.wait( lock, [this]{ return m_inputStop || !m_inputFreeFrames.empty(); } );
+      if( m_inputStop )
+      {
+        return;
+      }
+      inputFrame = m_inputFreeFrames.front();
+      m_inputFreeFrames.pop_front();
+    }
+
+    m_cVideoIOYuvInputFile.read( inputFrame->orgPic, inputFrame->trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+    inputFrame->isEof = m_cVideoIOYuvInputFile.isEof();
+
+    if( !inputFrame->isEof && !inputFrame->aqLayers.empty() )
+    {
+      AQpPreanalyzer::preanalyze( inputFrame->orgPic.Y(), inputFrame->aqLayers );
+    }
+
+    // temporally skip frames
+    if( m_temporalSubsampleRatio > 1 )
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
+    }
+
+    {
+      std::unique_lock< std::mutex > lock( m_inputMutex );
+      m_inputQueue.push_back( inputFrame );
+    }
+    m_inputCond.notify_all();
+
+    if( inputFrame->isEof )
+    {
+      return;
+    }
+  }
+}
+
+EncApp::InputFrame* EncApp::xGetInputFrame()
+{
+  std::unique_lock< std::mutex > lock( m_inputMutex );
+  m_inputCond.wait( lock, [this]{ return !m_inputQueue.empty(); } );
+
+  InputFrame* inputFrame = m_inputQueue.front();
+  m_inputQueue.pop_front();
+  return inputFrame;
+}
+
+void EncApp::xReleaseInputFrame( InputFrame* inputFrame )
+{
+  {
+    std::unique_lock< std::mutex > lock( m_inputMutex );
+    m_inputFreeFrames.push_back( inputFrame );
+  }
+  m_inputCond.notify_all();
+}
+
 /**
   Write access units to output file.
   \param bitstreamFile  target bitstream file
@@ -39,9 +39,14 @@
 #define __ENCAPP__
 
 #include <list>
+#include <deque>
 #include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "EncoderLib/EncLib.h"
+#include "EncoderLib/EncAnalysis.h"
 #include "Utilities/VideoIOYuv.h"
 #include "CommonLib/NAL.h"
 #include "EncAppCfg.h"
@@ -66,6 +71,30 @@ private:
   uint32_t              m_totalBytes;
   fstream           m_bitstream;
 
+  /// source frame read, converted and pre-analysed ahead of the encoder
+  struct InputFrame
+  {
+    PelStorage             orgPic;
+    PelStorage             trueOrgPic;
+    std::vector<AQpLayer*> aqLayers;
+    bool                   isEof;
+  };
+  std::vector<InputFrame*>  m_inputFrames;            ///< frames of the input queue
+  std::deque<InputFrame*>   m_inputQueue;             ///< frames ready to be encoded, in input order
+  std::deque<InputFrame*>   m_inputFreeFrames;        ///< frames available to the input thread
+  std::mutex                m_inputMutex;
+  std::condition_variable   m_inputCond;
+  bool                      m_inputStop;
+  std::thread               m_inputThread;
+
+  EncAnalysisMode   m_analysisMode;               ///< use of the analysis shared between the encodes of a multi-rate ladder
+  EncAnalysis*      m_analysis;                   ///< analysis store of the multi-rate ladder
+  EncAnalysis       m_fileAnalysis;               ///< analysis saved to or loaded from the analysis file
+  EncRCStats        m_RCStats;                    ///< statistics of the first rate control pass
+  double            m_bitrate;                    ///< sequence bitrate of the last encode in kbps
+  double            m_avgPsnr[MAX_NUM_COMPONENT]; ///< sequence PSNR of the last encode
+  double            m_layerBits[MAX_TLAYER];      ///< bits per non-intra picture of each temporal layer of the last encode (0: no such picture)
+
 private:
   // initialization
   void xCreateLib  ( std::list<PelUnitBuf*>& recBufList
@@ -78,6 +107,13 @@ private:
   void xWriteOutput     ( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
                          );                      ///< write bitstream to file
   void rateStatsAccum   ( const AccessUnit& au, const std::vector<uint32_t>& stats);
+
+  // input queue
+  void        xCreateInputQueue  ( const UnitArea& unitArea );     ///< allocate the input queue and start the input thread
+  void        xDestroyInputQueue ();                               ///< stop the input thread and free the input queue
+  void        xReadInputFrames   ( int numFrames );                ///< input thread
+  InputFrame* xGetInputFrame     ();                               ///< wait for the next source frame
+  void        xReleaseInputFrame ( InputFrame* inputFrame );       ///< give a frame back to the input thread
   void printRateSummary ();
   void printChromaFormat();
 
@@ -86,6 +122,11 @@ public:
   virtual ~EncApp();
 
   void  encode();                               ///< main encoding function
+  void  setAnalysis( EncAnalysisMode mode, EncAnalysis* analysis ) { m_analysisMode = mode; m_analysis = analysis; }
+
+  double getBitrate() const                     { return m_bitrate;         }
+  double getAvgPsnr( ComponentID compID ) const { return m_avgPsnr[compID]; }
+  double getLayerBits( int tId ) const          { return m_layerBits[tId];  }
 
   void  outputAU( const AccessUnit& au );
 
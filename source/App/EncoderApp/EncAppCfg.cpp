@@ -665,6 +665,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   SMultiValueInput<int>  cfg_codedPivotValue                 (std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), 0, 1<<16);
   SMultiValueInput<int>  cfg_targetPivotValue                (std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), 0, 1<<16);
 
+  SMultiValueInput<int>  cfg_multiRateQPs                    (-MAX_QP, MAX_QP, 0, MAX_QP + 1);
+  SMultiValueInput<double> cfg_lambdaModifierTargets         (0, std::numeric_limits<double>::max(), 0, MAX_TLAYER);
   SMultiValueInput<double> cfg_adIntraLambdaModifier         (0, std::numeric_limits<double>::max(), 0, MAX_TLAYER); ///< Lambda modifier for Intra pictures, one for each temporal layer. If size>temporalLayer, then use [temporalLayer], else if size>0, use [size()-1], else use m_adLambdaModifier.
 
 #if SHARP_LUMA_DELTA_QP
@@ -765,6 +767,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+  ("ChunkStartFrame",                                 m_chunkStartFrame,                                   -1, "First frame of the chunk to encode in a distributed encoding, counted from FrameSkip and aligned to the intra period (-1: off)")
+  ("ChunkEndFrame",                                   m_chunkEndFrame,                                     -1, "Frame following the chunk. Its IRAP picture is encoded as well, so that parcat can join the chunks (-1: end of the sequence)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("PYUV",                                            m_packedYUVMode,                                  false, "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
@@ -1166,6 +1170,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "RCLCUSeparateModel",                             m_RCUseLCUSeparateModel,                           true, "Rate control: use CTU level separate R-lambda model" )
   ( "InitialQP",                                      m_RCInitialQP,                                        0, "Rate control: initial QP" )
   ( "RCForceIntraQP",                                 m_RCForceIntraQP,                                 false, "Rate control: force intra QP to be equal to initial QP" )
+  ( "RCPass",                                         m_RCPass,                                             0, "Rate control: 0: single pass; 1: fast first pass at the fixed QP writing the statistics file; 2: second pass allocating the bits with the statistics file" )
+  ( "RCStatsFile",                                    m_RCStatsFileName,                               string(""), "Rate control: statistics file written by the first and read by the second pass" )
 #if U0132_TARGET_BITS_SATURATION
   ( "RCCpbSaturation",                                m_RCCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
   ( "RCCpbSize",                                      m_RCCpbSize,                                         0u, "Rate control: CPB size" )
@@ -1346,6 +1352,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("ForceDecodeBitstream1",                           m_forceDecodeBitstream1,                  false, "force decoding of bitstream 1 - use this only if you are realy sure about what you are doing ")
   ("DecodeBitstream2ModPOCAndType",                   m_bs2ModPOCAndType,                       false, "Modify POC and NALU-type of second input bitstream, to use second BS as closing I-slice")
   ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to parallelize splitting")
+  ("NumSplitLevels",                                  m_numSplitLevels,                             1, "Number of nested CU levels whose split alternatives are evaluated as parallel tasks")
   ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Force single thread execution even if taking the parallelized path")
   ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization")
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
@@ -1354,6 +1361,17 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 #else
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
 #endif
+  ("NumFrameThreads",                                 m_numFrameThreads,                            1, "Number of threads used to compress independent pictures of the same temporal layer (or of an all-intra sequence) in parallel")
+  ("NumDeltaQpRDThreads",                             m_numDeltaQpRDThreads,                        1, "Number of threads used to compress the slice QP candidates of DeltaQpRD in parallel")
+  ("NumMEThreads",                                    m_numMEThreads,                               1, "Number of threads used to run the uni-directional motion searches over reference lists and indices in parallel")
+  ("NumLoopFilterThreads",                            m_numLoopFilterThreads,                       1, "Number of threads sharing the CTUs of a picture when collecting the in-loop filter statistics, or the trials of the deblocking parameter selection")
+  ("InputQueueSize",                                  m_inputQueueSize,                             0, "Number of source frames read, converted and pre-analysed ahead of the encoder on a separate thread (0: read synchronously)")
+  ("MultiRateQPs",                                    cfg_multiRateQPs,                      cfg_multiRateQPs, "QPs of further encodes of the same sequence, run after this encode and restricting their mode search to the recorded decisions of this encode, comma separated")
+  ("AnalysisSaveFile",                                m_analysisSaveFileName,                      string(""), "File to which the CU decisions of this encode are saved for later encodes (AnalysisLoadFile)")
+  ("AnalysisLoadFile",                                m_analysisLoadFileName,                      string(""), "File with the CU decisions of an earlier encode (AnalysisSaveFile), to which the mode search of this encode is restricted")
+  ("LambdaModifierTargets",                           cfg_lambdaModifierTargets,      cfg_lambdaModifierTargets, "Target bits per non-intra picture of each temporal layer, comma separated. If set, LambdaModifier0.. of the encode are searched by training encodes of the first frames")
+  ("LambdaModifierSearchFrames",                      m_lambdaModifierSearchFrames,                 0, "Number of frames of the training encodes of the lambda modifier search (0: two GOPs)")
+  ("LambdaModifierSearchRounds",                      m_lambdaModifierSearchRounds,                 4, "Maximum number of training encodes of the lambda modifier search")
 #if JVET_K0371_ALF
   ( "ALF",                                             m_alf,                                    true, "Adpative Loop Filter\n" )
 #endif
@@ -1428,7 +1446,20 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   }
   m_inputFileName   = inputPathPrefix + m_inputFileName;
   m_framesToBeEncoded = ( m_framesToBeEncoded + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
+  if( m_chunkStartFrame >= 0 )
+  {
+    // a chunk [start,end) also encodes the IRAP picture at its end, which closes the leading pictures exactly like
+    // in the sequential encoding, the IDR duplicate of that picture starting the next chunk is dropped by parcat
+    if( m_chunkEndFrame < 0 )
+    {
+      m_chunkEndFrame = m_framesToBeEncoded;
+    }
+    m_FrameSkip        += m_chunkStartFrame;
+    m_framesToBeEncoded = std::min( m_chunkEndFrame + 1, m_framesToBeEncoded ) - m_chunkStartFrame;
+  }
   m_adIntraLambdaModifier = cfg_adIntraLambdaModifier.values;
+  m_multiRateQPs          = cfg_multiRateQPs.values;
+  m_lambdaModifierTargets = cfg_lambdaModifierTargets.values;
   if(m_isField)
   {
     //Frame height
@@ -1534,6 +1565,19 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   CHECK( tmpMotionEstimationSearchMethod < 0 || tmpMotionEstimationSearchMethod >= MESEARCH_NUMBER_OF_METHODS, "Error in cfg" );
   m_motionEstimationSearchMethod=MESearchMethod(tmpMotionEstimationSearchMethod);
 
+  if( m_RCPass == 1 )
+  {
+    // the first rate control pass only gathers statistics, use the fast encoder settings
+    m_bUseEarlyCU             = true;
+    m_useFastDecisionForMerge = true;
+    m_bUseCbfFastMode         = true;
+    m_iSearchRange            = std::min( m_iSearchRange, 32 );
+    if( m_fastInterSearchMode == FASTINTERSEARCH_DISABLED )
+    {
+      m_fastInterSearchMode = FASTINTERSEARCH_MODE1;
+    }
+  }
+
   if (extendedProfile >= 1000 && extendedProfile <= 12316)
   {
     m_profile = Profile::MAINREXT;
@@ -2159,11 +2203,17 @@ bool EncAppCfg::xCheckParameter()
 #if ENABLE_SPLIT_PARALLELISM
   xConfirmPara( m_numSplitThreads < 1, "Number of used threads cannot be smaller than 1" );
   xConfirmPara( m_numSplitThreads > PARL_SPLIT_MAX_NUM_THREADS, "Number of used threads cannot be higher than the number of actual jobs" );
+  xConfirmPara( m_numSplitLevels < 1, "Number of parallel split levels cannot be smaller than 1" );
+  xConfirmPara( m_numSplitLevels > PARL_SPLIT_MAX_NUM_LEVELS, "Number of parallel split levels cannot be higher than PARL_SPLIT_MAX_NUM_LEVELS" );
 #if _MSC_VER && ENABLE_WPP_PARALLELISM
   xConfirmPara( m_numSplitThreads > 1 && m_numSplitThreads != NUM_SPLIT_THREADS_IF_MSVC, "Due to poor implementation by Microsoft, NumSplitThreads cannot be set dynamically on runtime!" );
 #endif
+#if _MSC_VER
+  xConfirmPara( m_numSplitLevels > 1, "Nested split parallelism needs OpenMP tasks, which are not supported by MSVC" );
+#endif
 #else
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
+  xConfirmPara( m_numSplitLevels != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitLevels has to be 1" );
 #endif
 
 #if ENABLE_WPP_PARALLELISM
@@ -2180,6 +2230,90 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
 #endif
 
+#if ENABLE_FRAME_PARALLELISM
+  xConfirmPara( m_numFrameThreads < 1, "Number of used frame threads cannot be smaller than 1" );
+  xConfirmPara( m_numFrameThreads > PARL_FRAME_MAX_NUM_THREADS, "Number of used frame threads cannot be bigger than PARL_FRAME_MAX_NUM_THREADS" );
+  if( m_numFrameThreads > 1 )
+  {
+    xConfirmPara( m_RCEnableRateControl, "Frame-parallel encoding cannot be used together with rate control" );
+    xConfirmPara( m_numSplitThreads > 1 || m_numWppThreads > 1, "Frame-parallel encoding cannot be combined with split or WPP-style parallelization" );
+#if JVET_K0157
+    xConfirmPara( m_compositeRefEnabled, "Frame-parallel encoding cannot be used together with the composite long term reference" );
+#endif
+#if JEM_TOOLS
+    xConfirmPara( m_CIPF != 0 || m_CABACEngineMode > 1, "Frame-parallel encoding requires CIPF to be off and a CABAC engine without adaptive window" );
+#endif
+  }
+#else
+  xConfirmPara( m_numFrameThreads != 1, "ENABLE_FRAME_PARALLELISM is disabled, numFrameThreads has to be 1" );
+#endif
+
+#if ENABLE_DQP_RD_PARALLELISM
+  xConfirmPara( m_numDeltaQpRDThreads < 1, "Number of used DeltaQpRD threads cannot be smaller than 1" );
+  xConfirmPara( m_numDeltaQpRDThreads > PARL_DQP_RD_MAX_NUM_THREADS, "Number of used DeltaQpRD threads cannot be bigger than PARL_DQP_RD_MAX_NUM_THREADS" );
+  if( m_numDeltaQpRDThreads > 1 )
+  {
+    xConfirmPara( m_numFrameThreads > 1, "Parallel DeltaQpRD candidates cannot be combined with frame-parallel encoding" );
+    xConfirmPara( m_numSplitThreads > 1 || m_numWppThreads > 1, "Parallel DeltaQpRD candidates cannot be combined with split or WPP-style parallelization" );
+    xConfirmPara( m_sliceMode != NO_SLICES, "Parallel DeltaQpRD candidates require a single slice per picture" );
+#if JVET_K0157
+    xConfirmPara( m_compositeRefEnabled, "Parallel DeltaQpRD candidates cannot be used together with the composite long term reference" );
+#endif
+#if JEM_TOOLS
+    xConfirmPara( m_CIPF != 0 || m_CABACEngineMode > 1, "Parallel DeltaQpRD candidates require CIPF to be off and a CABAC engine without adaptive window" );
+#endif
+  }
+#else
+  xConfirmPara( m_numDeltaQpRDThreads != 1, "ENABLE_DQP_RD_PARALLELISM is disabled, numDeltaQpRDThreads has to be 1" );
+#endif
+
+#if ENABLE_ME_PARALLELISM
+  xConfirmPara( m_numMEThreads < 1, "Number of motion estimation threads cannot be smaller than 1" );
+  xConfirmPara( m_numMEThreads > PARL_ME_MAX_NUM_THREADS, "Number of motion estimation threads cannot be bigger than PARL_ME_MAX_NUM_THREADS" );
+  if( m_numMEThreads > 1 )
+  {
+    xConfirmPara( m_numFrameThreads > 1 || m_numDeltaQpRDThreads > 1, "Parallel motion estimation cannot be combined with frame-parallel encoding or parallel DeltaQpRD candidates" );
+    xConfirmPara( m_numSplitThreads > 1 || m_numWppThreads > 1, "Parallel motion estimation cannot be combined with split or WPP-style parallelization" );
+  }
+#else
+  xConfirmPara( m_numMEThreads != 1, "ENABLE_ME_PARALLELISM is disabled, numMEThreads has to be 1" );
+#endif
+
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  xConfirmPara( m_numLoopFilterThreads < 1, "Number of loop filter threads cannot be smaller than 1" );
+  xConfirmPara( m_numLoopFilterThreads > PARL_LOOP_FILTER_MAX_NUM_THREADS, "Number of loop filter threads cannot be bigger than PARL_LOOP_FILTER_MAX_NUM_THREADS" );
+#else
+  xConfirmPara( m_numLoopFilterThreads != 1, "ENABLE_LOOP_FILTER_PARALLELISM is disabled, numLoopFilterThreads has to be 1" );
+#endif
+  xConfirmPara( m_inputQueueSize < 0, "Input queue size cannot be negative" );
+  if( !m_multiRateQPs.empty() )
+  {
+    for( int qp : m_multiRateQPs )
+    {
+      xConfirmPara( qp < -6 * ( m_internalBitDepth[CHANNEL_TYPE_LUMA] - 8 ) || qp > MAX_QP, "Multi-rate QP exceeds supported range (-QpBDOffsety to 63)" );
+    }
+    xConfirmPara( m_RCEnableRateControl, "Multi-rate encoding cannot be used together with rate control" );
+    xConfirmPara( m_fastForwardToPOC != -1 || m_switchPOC != -1, "Multi-rate encoding cannot be used together with FastForwardToPOC or SwitchPOC" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(), "Multi-rate encoding cannot be used together with decoding bitstreams" );
+    xConfirmPara( !m_analysisSaveFileName.empty() || !m_analysisLoadFileName.empty(), "Multi-rate encoding cannot be used together with analysis files" );
+  }
+  xConfirmPara( !m_analysisSaveFileName.empty() && !m_analysisLoadFileName.empty(), "An analysis file cannot be saved and loaded by the same encode" );
+  if( !m_lambdaModifierTargets.empty() )
+  {
+    for( double target : m_lambdaModifierTargets )
+    {
+      xConfirmPara( target <= 0.0, "Lambda modifier targets have to be larger than 0" );
+    }
+    xConfirmPara( m_lambdaModifierSearchFrames < 0, "LambdaModifierSearchFrames cannot be negative" );
+    xConfirmPara( m_lambdaModifierSearchRounds < 1, "LambdaModifierSearchRounds has to be at least 1" );
+    xConfirmPara( m_RCEnableRateControl, "The lambda modifier search cannot be used together with rate control" );
+    xConfirmPara( !m_multiRateQPs.empty(), "The lambda modifier search cannot be used together with multi-rate encoding" );
+    xConfirmPara( m_chunkStartFrame >= 0, "The lambda modifier search cannot be used together with chunked encoding" );
+    xConfirmPara( m_fastForwardToPOC != -1 || m_switchPOC != -1, "The lambda modifier search cannot be used together with FastForwardToPOC or SwitchPOC" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(), "The lambda modifier search cannot be used together with decoding bitstreams" );
+    xConfirmPara( !m_analysisSaveFileName.empty() || !m_analysisLoadFileName.empty(), "The lambda modifier search cannot be used together with analysis files" );
+  }
+
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
   xConfirmPara( m_bUsePerceptQPA && m_lumaLevelToDeltaQPMapping.mode >= 2, "QPA and SharpDeltaQP mode 2 cannot be used together" );
@@ -2333,6 +2467,20 @@ bool EncAppCfg::xCheckParameter()
   {
     xConfirmPara( !m_recoveryPointSEIEnabled,                                               "When using RecoveryPointSEI messages as RA points, recoveryPointSEI must be enabled" );
   }
+  if( m_chunkStartFrame >= 0 )
+  {
+    xConfirmPara( m_iIntraPeriod <= 0,                                                      "Chunked encoding requires a positive intra period" );
+    xConfirmPara( m_chunkStartFrame % std::max( m_iIntraPeriod, 1 ) != 0,                   "ChunkStartFrame must be aligned to the intra period" );
+    xConfirmPara( m_chunkEndFrame <= m_chunkStartFrame,                                     "ChunkEndFrame must be larger than ChunkStartFrame" );
+    xConfirmPara( m_chunkEndFrame < m_chunkStartFrame + m_framesToBeEncoded && m_chunkEndFrame % std::max( m_iIntraPeriod, 1 ) != 0,
+                                                                                            "ChunkEndFrame must be aligned to the intra period or cover the end of the sequence" );
+    xConfirmPara( m_iDecodingRefreshType != 1,                                              "Chunked encoding requires CRA pictures at the chunk boundaries (DecodingRefreshType 1)" );
+    xConfirmPara( m_isField || m_temporalSubsampleRatio != 1,                               "Chunked encoding does not support field coding or temporal subsampling" );
+    xConfirmPara( m_sliceMode != NO_SLICES,                                                 "Chunked encoding requires one slice per picture, parcat counts the slices to renumber the POCs" );
+#if HEVC_DEPENDENT_SLICES
+    xConfirmPara( m_sliceSegmentMode != NO_SLICES,                                          "Chunked encoding requires one slice segment per picture, parcat counts the slices to renumber the POCs" );
+#endif
+  }
 
   if (m_isField)
   {
@@ -3045,6 +3193,12 @@ bool EncAppCfg::xCheckParameter()
     xConfirmPara(m_vuiParametersPresentFlag && m_chromaLocInfoPresentFlag && (m_chromaSampleLocTypeTopField != m_chromaSampleLocTypeBottomField ), "When chromaResamplingFilterSEI is enabled, ChromaSampleLocTypeTopField has to be equal to ChromaSampleLocTypeBottomField" );
   }
 
+  xConfirmPara( m_RCPass < 0 || m_RCPass > 2, "RCPass has to be 0, 1 or 2" );
+  if ( m_RCPass > 0 )
+  {
+    xConfirmPara( !m_RCEnableRateControl, "Two-pass rate control requires RateControl to be enabled" );
+    xConfirmPara( m_RCStatsFileName.empty(), "Two-pass rate control requires a statistics file (RCStatsFile)" );
+  }
   if ( m_RCEnableRateControl )
   {
     if ( m_RCForceIntraQP )
@@ -3154,6 +3308,14 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Input          File                    : %s\n", m_inputFileName.c_str() );
   msg( DETAILS, "Bitstream      File                    : %s\n", m_bitstreamFileName.c_str() );
   msg( DETAILS, "Reconstruction File                    : %s\n", m_reconFileName.c_str() );
+  if( !m_analysisSaveFileName.empty() )
+  {
+    msg( DETAILS, "Analysis save File                     : %s\n", m_analysisSaveFileName.c_str() );
+  }
+  if( !m_analysisLoadFileName.empty() )
+  {
+    msg( DETAILS, "Analysis load File                     : %s\n", m_analysisLoadFileName.c_str() );
+  }
   msg( DETAILS, "Real     Format                        : %dx%d %gHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, (double)m_iFrameRate / m_temporalSubsampleRatio );
   msg( DETAILS, "Internal Format                        : %dx%d %gHz\n", m_iSourceWidth, m_iSourceHeight, (double)m_iFrameRate / m_temporalSubsampleRatio );
   msg( DETAILS, "Sequence PSNR output                   : %s\n", ( m_printMSEBasedSequencePSNR ? "Linear average, MSE-based" : "Linear average only" ) );
@@ -3172,6 +3334,10 @@ void EncAppCfg::xPrintParameter()
   {
     msg( DETAILS, "Frame/Field                            : Frame based coding\n" );
     msg( DETAILS, "Frame index                            : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip + m_framesToBeEncoded - 1, m_framesToBeEncoded );
+    if( m_chunkStartFrame >= 0 )
+    {
+      msg( DETAILS, "Chunk                                  : %d - %d (closing IRAP included)\n", m_chunkStartFrame, m_chunkEndFrame );
+    }
   }
   if (m_profile == Profile::MAINREXT)
   {
@@ -3270,6 +3436,11 @@ void EncAppCfg::xPrintParameter()
     msg( DETAILS, "UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
     msg( DETAILS, "InitialQP                              : %d\n", m_RCInitialQP );
     msg( DETAILS, "ForceIntraQP                           : %d\n", m_RCForceIntraQP );
+    if( m_RCPass > 0 )
+    {
+      msg( DETAILS, "RCPass                                 : %d\n", m_RCPass );
+      msg( DETAILS, "RCStatsFile                            : %s\n", m_RCStatsFileName.c_str() );
+    }
 #if U0132_TARGET_BITS_SATURATION
     msg( DETAILS, "CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
     if (m_RCCpbSaturationEnabled)
@@ -3504,10 +3675,18 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "NumSplitThreads:%d ", m_numSplitThreads );
   if( m_numSplitThreads > 1 )
   {
+    msg( VERBOSE, "NumSplitLevels:%d ", m_numSplitLevels );
     msg( VERBOSE, "ForceSingleSplitThread:%d ", m_forceSplitSequential );
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "NumFrameThreads:%d ", m_numFrameThreads );
+  msg( VERBOSE, "NumDeltaQpRDThreads:%d ", m_numDeltaQpRDThreads );
+  msg( VERBOSE, "NumMEThreads:%d ", m_numMEThreads );
+  msg( VERBOSE, "NumLoopFilterThreads:%d ", m_numLoopFilterThreads );
+  msg( VERBOSE, "InputQueueSize:%d ", m_inputQueueSize );
+  msg( VERBOSE, "MultiRateQPs:%d ", int( m_multiRateQPs.size() ) );
+  msg( VERBOSE, "LambdaModifierTargets:%d ", int( m_lambdaModifierTargets.size() ) );
 
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
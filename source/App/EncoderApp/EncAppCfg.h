@@ -101,6 +101,8 @@ protected:
   int       m_confWinTop;
   int       m_confWinBottom;
   int       m_framesToBeEncoded;                              ///< number of encoded frames
+  int       m_chunkStartFrame;                                ///< first frame of the chunk of a distributed encoding (-1: off)
+  int       m_chunkEndFrame;                                  ///< frame following the chunk, its IRAP picture is encoded as well (-1: end of the sequence)
   int       m_aiPad[2];                                       ///< number of padded pixels for width and height
   bool      m_AccessUnitDelimiter;                            ///< add Access Unit Delimiter NAL units
   InputColourSpaceConversion m_inputColourSpaceConvert;       ///< colour space conversion to apply to input video
@@ -322,10 +324,22 @@ protected:
 
 
   int       m_numSplitThreads;
+  int       m_numSplitLevels;
   bool      m_forceSplitSequential;
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numFrameThreads;
+  int       m_numDeltaQpRDThreads;
+  int       m_numMEThreads;
+  int       m_numLoopFilterThreads;
+  int       m_inputQueueSize;                                 ///< number of source frames read and pre-analysed ahead on a separate thread (0: read synchronously)
+  std::vector<int> m_multiRateQPs;                            ///< QPs of the dependent encodes of a multi-rate ladder, which reuse the analysis of this encode
+  std::string m_analysisSaveFileName;                         ///< file to which the CU decisions of this encode are saved
+  std::string m_analysisLoadFileName;                         ///< file with the CU decisions restricting the mode search of this encode
+  std::vector<double> m_lambdaModifierTargets;                ///< target bits per non-intra picture of each temporal layer of the lambda modifier search
+  int       m_lambdaModifierSearchFrames;                     ///< number of frames of the training encodes of the lambda modifier search (0: two GOPs)
+  int       m_lambdaModifierSearchRounds;                     ///< maximum number of training encodes of the lambda modifier search
 
   // transfom unit (TU) definition
   int       m_quadtreeTULog2MaxSize;
@@ -514,6 +528,8 @@ protected:
   bool      m_RCUseLCUSeparateModel;              ///< use separate R-lambda model at LCU level                        NOTE: code-tidy - rename to m_RCUseCtuSeparateModel
   int       m_RCInitialQP;                        ///< inital QP for rate control
   bool      m_RCForceIntraQP;                     ///< force all intra picture to use initial QP or not
+  int       m_RCPass;                             ///< 0: single pass; 1: fast first pass writing the statistics; 2: second pass reading them
+  std::string m_RCStatsFileName;                  ///< statistics file of the two-pass rate control
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;             ///< enable target bits saturation to avoid CPB overflow and underflow
   uint32_t      m_RCCpbSize;                          ///< CPB size
@@ -614,6 +630,18 @@ public:
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
 
+  const std::vector<int>& getMultiRateQPs     () const { return m_multiRateQPs;      }
+  const std::string&      getBitstreamFileName() const { return m_bitstreamFileName; }
+  const std::string&      getReconFileName    () const { return m_reconFileName;     }
+  int                     getQP               () const { return m_iQP;               }
+  int                     getGOPSize          () const { return m_iGOPSize;          }
+  int                     getFramesToBeEncoded() const { return m_framesToBeEncoded; }
+  double                  getLambdaModifier   ( int tId ) const { return m_adLambdaModifier[tId]; }
+
+  const std::vector<double>& getLambdaModifierTargets     () const { return m_lambdaModifierTargets;      }
+  int                        getLambdaModifierSearchFrames() const { return m_lambdaModifierSearchFrames; }
+  int                        getLambdaModifierSearchRounds() const { return m_lambdaModifierSearchRounds; }
+
 };// END CLASS DEFINITION EncAppCfg
 
 //! \}
@@ -39,8 +39,11 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <cmath>
+#include <cstdio>
 
 #include "EncApp.h"
+#include "EncoderLib/EncAnalysis.h"
 #include "Utilities/program_options_lite.h"
 
 //! \ingroup EncoderApp
@@ -76,6 +79,277 @@ static void printMacroSettings()
   }
 }
 
+/// result of one encode of a multi-rate ladder
+struct RateResult
+{
+  int    qp;
+  double bitrate;
+  double psnr[MAX_NUM_COMPONENT];
+  double time;
+};
+
+/// output file name of a further encode of the same sequence, e.g. str_qp27.bin for str.bin and the suffix _qp27
+static std::string getRateFileName( const std::string& fileName, const std::string& suffix )
+{
+  const size_t      extPos = fileName.find_last_of( '.' );
+  const size_t      dirPos = fileName.find_last_of( "/\\" );
+
+  if( extPos == std::string::npos || ( dirPos != std::string::npos && extPos < dirPos ) )
+  {
+    return fileName + suffix;
+  }
+
+  return fileName.substr( 0, extPos ) + suffix + fileName.substr( extPos );
+}
+
+/// runs the encode of pcEncApp, returns false if it failed
+static bool encodeRate( EncApp* pcEncApp )
+{
+#ifndef _DEBUG
+  try
+  {
+#endif
+    pcEncApp->encode();
+#ifndef _DEBUG
+  }
+  catch( Exception &e )
+  {
+    std::cerr << e.what() << std::endl;
+    return false;
+  }
+  catch( ... )
+  {
+    std::cerr << "Unspecified error occurred" << std::endl;
+    return false;
+  }
+#endif
+  return true;
+}
+
+/// creates an encoder configured by the command line args, returns NULL if the configuration is invalid
+static EncApp* createEncApp( std::vector<std::string>& args )
+{
+  std::vector<char*> encArgv;
+  for( std::string& arg : args )
+  {
+    encArgv.push_back( &arg[0] );
+  }
+
+  EncApp* pcEncApp = new EncApp;
+  pcEncApp->create();
+
+  if( !pcEncApp->parseCfg( int( encArgv.size() ), encArgv.data() ) )
+  {
+    pcEncApp->destroy();
+    delete pcEncApp;
+    return NULL;
+  }
+  return pcEncApp;
+}
+
+static RateResult getRateResult( const EncApp* pcEncApp, int qp, double time )
+{
+  RateResult result;
+  result.qp      = qp;
+  result.bitrate = pcEncApp->getBitrate();
+  result.time    = time;
+  for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    result.psnr[comp] = pcEncApp->getAvgPsnr( ComponentID( comp ) );
+  }
+  return result;
+}
+
+/// encodes the dependent rates of a multi-rate ladder, each restricted to the decisions recorded by the reference encode
+static bool encodeDependentRates( int argc, char* argv[], const std::vector<int>& qps, const std::string& bitstreamFileName, const std::string& reconFileName,
+                                  EncAnalysis& analysis, std::vector<RateResult>& results )
+{
+  for( int qp : qps )
+  {
+    std::vector<std::string> args( argv, argv + argc );
+    args.push_back( "--QP=" + std::to_string( qp ) );
+    args.push_back( "--BitstreamFile=" + getRateFileName( bitstreamFileName, "_qp" + std::to_string( qp ) ) );
+    if( !reconFileName.empty() )
+    {
+      args.push_back( "--ReconFile=" + getRateFileName( reconFileName, "_qp" + std::to_string( qp ) ) );
+    }
+
+    fprintf( stdout, "\nMulti-rate encode at QP %d reusing the analysis of the reference encode\n", qp );
+
+    EncApp* pcEncApp = createEncApp( args );
+    if( !pcEncApp )
+    {
+      return false;
+    }
+
+    pcEncApp->setAnalysis( ANALYSIS_REUSE, &analysis );
+
+    auto startTime = std::chrono::steady_clock::now();
+    if( !encodeRate( pcEncApp ) )
+    {
+      return false;
+    }
+    auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - startTime ).count();
+
+    results.push_back( getRateResult( pcEncApp, qp, encTime / 1000.0 ) );
+
+    pcEncApp->destroy();
+    delete pcEncApp;
+  }
+
+  return true;
+}
+
+/// one training encode of the lambda modifier search
+struct LambdaModifierPoint
+{
+  double modifier[MAX_TLAYER];
+  double bits    [MAX_TLAYER];
+};
+
+/// command line args setting the lambda modifiers of the first numLayers temporal layers
+static std::vector<std::string> getLambdaModifierArgs( const double* modifiers, int numLayers )
+{
+  std::vector<std::string> args;
+  for( int tId = 0; tId < numLayers; tId++ )
+  {
+    char arg[64];
+    snprintf( arg, sizeof( arg ), "--LambdaModifier%d=%.8g", tId, modifiers[tId] );
+    args.push_back( arg );
+  }
+  return args;
+}
+
+/// searches the lambda modifiers, for which the non-intra pictures of each temporal layer of the first frames meet the targets
+/// of pcEncApp. The training encodes fit the rate model  log( bits ) = a + b * log( modifier )  of each layer, the slope b
+/// by least squares over all training encodes and the offset a by the latest one, until the bits are within 1% of the targets.
+/// Returns the args setting the found modifiers.
+static bool searchLambdaModifiers( int argc, char* argv[], const EncApp* pcEncApp, std::vector<std::string>& modifierArgs )
+{
+  const std::vector<double>& targets   = pcEncApp->getLambdaModifierTargets();
+  const int                  numLayers = int( targets.size() );
+  const int                  numRounds = pcEncApp->getLambdaModifierSearchRounds();
+  int                        numFrames = pcEncApp->getLambdaModifierSearchFrames() > 0 ? pcEncApp->getLambdaModifierSearchFrames() : 2 * pcEncApp->getGOPSize() + 1;
+  if( pcEncApp->getFramesToBeEncoded() > 0 )
+  {
+    numFrames = std::min( numFrames, pcEncApp->getFramesToBeEncoded() );
+  }
+  const std::string bitstreamFileName = getRateFileName( pcEncApp->getBitstreamFileName(), "_lmsearch" );
+
+  double modifiers[MAX_TLAYER];
+  for( int tId = 0; tId < numLayers; tId++ )
+  {
+    modifiers[tId] = pcEncApp->getLambdaModifier( tId );
+  }
+
+  fprintf( stdout, "\nLambda modifier search on the first %d frames\n", numFrames );
+
+  std::vector<LambdaModifierPoint> points;
+  for( int round = 0; round < numRounds; round++ )
+  {
+    std::vector<std::string> args( argv, argv + argc );
+    std::vector<std::string> roundArgs = getLambdaModifierArgs( modifiers, numLayers );
+    args.insert( args.end(), roundArgs.begin(), roundArgs.end() );
+    args.push_back( "--FramesToBeEncoded=" + std::to_string( numFrames ) );
+    args.push_back( "--BitstreamFile=" + bitstreamFileName );
+    args.push_back( "--ReconFile=" );
+    args.push_back( "--Verbosity=" + std::to_string( int( WARNING ) ) );
+
+    EncApp* pcTrainEncApp = createEncApp( args );
+    if( !pcTrainEncApp )
+    {
+      return false;
+    }
+    if( !encodeRate( pcTrainEncApp ) )
+    {
+      return false;
+    }
+
+    LambdaModifierPoint point;
+    for( int tId = 0; tId < numLayers; tId++ )
+    {
+      point.modifier[tId] = modifiers[tId];
+      point.bits    [tId] = pcTrainEncApp->getLayerBits( tId );
+    }
+    points.push_back( point );
+
+    pcTrainEncApp->destroy();
+    delete pcTrainEncApp;
+
+    fprintf( stdout, "\tRound %d:", round );
+    bool converged = true;
+    for( int tId = 0; tId < numLayers; tId++ )
+    {
+      fprintf( stdout, "  LM%d %.4f %10.1f bits", tId, point.modifier[tId], point.bits[tId] );
+      converged &= point.bits[tId] == 0.0 || std::abs( point.bits[tId] - targets[tId] ) <= 0.01 * targets[tId];
+    }
+    fprintf( stdout, "\n" );
+
+    if( converged )
+    {
+      break;
+    }
+
+    for( int tId = 0; tId < numLayers; tId++ )
+    {
+      if( point.bits[tId] == 0.0 )
+      {
+        continue;
+      }
+
+      // the slope of the rate model, assuming the bits to be inversely proportional to the modifier until two encodes differ
+      double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+      for( const LambdaModifierPoint& p : points )
+      {
+        const double x = log( p.modifier[tId] );
+        const double y = log( std::max( p.bits[tId], 1.0 ) );
+        sumX += x; sumY += y; sumXX += x * x; sumXY += x * y;
+      }
+      const double num   = double( points.size() );
+      const double varX  = sumXX - sumX * sumX / num;
+      double       slope = -1.0;
+      if( varX > 1e-6 )
+      {
+        slope = Clip3( -4.0, -0.25, ( sumXY - sumX * sumY / num ) / varX );
+      }
+
+      const double step = Clip3( -log( 4.0 ), log( 4.0 ), ( log( targets[tId] ) - log( std::max( point.bits[tId], 1.0 ) ) ) / slope );
+      modifiers[tId]    = Clip3( 0.01, 100.0, modifiers[tId] * exp( step ) );
+    }
+  }
+
+  remove( bitstreamFileName.c_str() );
+
+  for( int tId = 0; tId < numLayers; tId++ )
+  {
+    if( points.back().bits[tId] == 0.0 )
+    {
+      fprintf( stdout, "\tNo non-intra picture of temporal layer %d in the training frames, LambdaModifier%d is kept\n", tId, tId );
+    }
+  }
+
+  modifierArgs = getLambdaModifierArgs( modifiers, numLayers );
+  fprintf( stdout, "Lambda modifiers:" );
+  for( int tId = 0; tId < numLayers; tId++ )
+  {
+    fprintf( stdout, " %.4f", modifiers[tId] );
+  }
+  fprintf( stdout, "\n\n" );
+
+  return true;
+}
+
+static void printRateResults( const std::vector<RateResult>& results )
+{
+  printf( "\n\nMulti-rate summary (the first encode is the reference, the others reuse its analysis)\n" );
+  printf( "\t  QP    Bitrate     Y-PSNR    U-PSNR    V-PSNR    Time [sec.]\n" );
+  for( const RateResult& result : results )
+  {
+    printf( "\t%4d %10.4lf   %8.4lf  %8.4lf  %8.4lf  %12.3f\n", result.qp, result.bitrate,
+            result.psnr[COMPONENT_Y], result.psnr[COMPONENT_Cb], result.psnr[COMPONENT_Cr], result.time );
+  }
+}
+
 // ====================================================================================================================
 // Main function
 // ====================================================================================================================
@@ -145,32 +419,73 @@ int main(int argc, char* argv[])
   fprintf(stdout, " started @ %s", std::ctime(&startTime2) );
   clock_t startClock = clock();
 
-  // call encoding function
-#ifndef _DEBUG
-  try
+  // the lambda modifier search replaces the encoder by one configured with the found modifiers
+  if( !pcEncApp->getLambdaModifierTargets().empty() )
   {
-#endif
-    pcEncApp->encode();
-#ifndef _DEBUG
+    std::vector<std::string> modifierArgs;
+    if( !searchLambdaModifiers( argc, argv, pcEncApp, modifierArgs ) )
+    {
+      return 1;
+    }
+
+    pcEncApp->destroy();
+    delete pcEncApp;
+
+    std::vector<std::string> args( argv, argv + argc );
+    args.insert( args.end(), modifierArgs.begin(), modifierArgs.end() );
+    pcEncApp = createEncApp( args );
+    if( !pcEncApp )
+    {
+      return 1;
+    }
   }
-  catch( Exception &e )
+
+  // a multi-rate ladder records the decisions of this encode for the encodes at the further QPs
+  EncAnalysis             analysis;
+  const std::vector<int>  multiRateQPs = pcEncApp->getMultiRateQPs();
+  std::vector<RateResult> rateResults;
+
+  if( !multiRateQPs.empty() )
   {
-    std::cerr << e.what() << std::endl;
-    return 1;
+    pcEncApp->setAnalysis( ANALYSIS_RECORD, &analysis );
   }
-  catch( ... )
+
+  // call encoding function
+  if( !encodeRate( pcEncApp ) )
   {
-    std::cerr << "Unspecified error occurred" << std::endl;
     return 1;
   }
-#endif
+
+  if( !multiRateQPs.empty() )
+  {
+    auto refTime = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - startTime ).count();
+    rateResults.push_back( getRateResult( pcEncApp, pcEncApp->getQP(), refTime / 1000.0 ) );
+
+    const std::string bitstreamFileName = pcEncApp->getBitstreamFileName();
+    const std::string reconFileName     = pcEncApp->getReconFileName();
+
+    pcEncApp->destroy();
+    delete pcEncApp;
+    pcEncApp = NULL;
+
+    if( !encodeDependentRates( argc, argv, multiRateQPs, bitstreamFileName, reconFileName, analysis, rateResults ) )
+    {
+      return 1;
+    }
+
+    printRateResults( rateResults );
+  }
+
   // ending time
   clock_t endClock = clock();
   auto endTime = std::chrono::steady_clock::now();
   std::time_t endTime2 = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
   auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( endTime- startTime ).count();
   // destroy application encoder class
-  pcEncApp->destroy();
+  if( pcEncApp )
+  {
+    pcEncApp->destroy();
+  }
 
   delete pcEncApp;
 
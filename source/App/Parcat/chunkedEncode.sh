@@ -0,0 +1,152 @@
+#! /bin/bash
+
+# The copyright in this software is being made available under the BSD
+# License, included below. This software may be subject to other third party
+# and contributor rights, including patent rights, and no such rights are
+# granted under this license.
+#
+# Copyright (c) 2010-2018, ITU/ISO/IEC
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#  * Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+#    be used to endorse or promote products derived from this software without
+#    specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+# Encodes a sequence as independent chunks aligned to the intra period, running the chunks as local processes,
+# joins the chunk bitstreams with parcat, decodes the joined bitstream and checks that it reconstructs to the
+# concatenated reconstructions of the chunk encoders.
+
+function outputUsageAndExit {
+  echo "Usage: $0 -e encoder -d decoder -p parcat -n numFrames -i intraPeriod [-l chunkLength] [-j numJobs] -o outputDirectory -- encoderArguments" >&2
+  echo "  encoder, decoder and parcat are the paths of the executables." >&2
+  echo "  numFrames is the number of frames of the whole sequence, counted from FrameSkip." >&2
+  echo "  intraPeriod is the intra period used by the encoder configuration." >&2
+  echo "  chunkLength is the number of frames per chunk, a multiple of intraPeriod. The default is intraPeriod." >&2
+  echo "  numJobs is the number of chunks encoded at the same time. The default is the number of processors." >&2
+  echo "  encoderArguments are passed to every chunk encoder and must not contain -b, -o or -f." >&2
+  exit 1
+}
+
+numJobs=$(nproc 2> /dev/null || echo 1)
+
+while [ $# -gt 0 ] ; do
+  case $1 in
+    --) shift ; break ;;
+    -e) encoder=$2 ;;
+    -d) decoder=$2 ;;
+    -p) parcat=$2 ;;
+    -n) numFrames=$2 ;;
+    -i) intraPeriod=$2 ;;
+    -l) chunkLength=$2 ;;
+    -j) numJobs=$2 ;;
+    -o) outputDirectory=$2 ;;
+    *)
+      printf "You entered an invalid option: \"$1\".\n" >&2
+      outputUsageAndExit
+    ;;
+  esac
+  if [ $# -lt 2 ] ; then
+    outputUsageAndExit
+  fi
+  shift 2
+done
+
+if [[ -z $encoder || -z $decoder || -z $parcat || -z $numFrames || -z $intraPeriod || -z $outputDirectory ]] ; then
+  outputUsageAndExit
+fi
+
+chunkLength=${chunkLength:-$intraPeriod}
+
+if [[ $intraPeriod -le 0 || $chunkLength -le 0 || $(( chunkLength % intraPeriod )) -ne 0 ]] ; then
+  printf "The chunk length has to be a positive multiple of the intra period.\n" >&2
+  exit 1
+fi
+
+mkdir -p "$outputDirectory" || exit 1
+
+# encode the chunks, at most numJobs at the same time, a last chunk consisting only of the closing IRAP
+# picture of its predecessor is not needed
+numChunks=$(( numFrames > 1 ? ( numFrames + chunkLength - 2 ) / chunkLength : 1 ))
+
+for (( chunk = 0; chunk < numChunks; chunk++ )) ; do
+  if [[ $( jobs -r -p | wc -l ) -ge $numJobs ]] ; then
+    wait -n
+  fi
+
+  start=$(( chunk * chunkLength ))
+  end=$(( chunk + 1 < numChunks ? start + chunkLength : numFrames ))
+  prefix="$outputDirectory/chunk$chunk"
+
+  echo "Encoding chunk $chunk: frames $start - $(( end - 1 ))"
+  (
+    "$encoder" "$@" -f $numFrames --ChunkStartFrame=$start --ChunkEndFrame=$end -b "$prefix.bin" -o "$prefix.yuv" > "$prefix.log" 2>&1
+    echo $? > "$prefix.status"
+  ) &
+done
+
+wait
+
+for (( chunk = 0; chunk < numChunks; chunk++ )) ; do
+  if [[ "$( cat "$outputDirectory/chunk$chunk.status" 2> /dev/null )" != "0" ]] ; then
+    printf "Encoding chunk $chunk failed, see $outputDirectory/chunk$chunk.log\n" >&2
+    exit 1
+  fi
+done
+
+# join the chunks, parcat drops the parameter sets and the leading IDR picture of all chunks but the first
+segments=()
+for (( chunk = 0; chunk < numChunks; chunk++ )) ; do
+  segments+=( "$outputDirectory/chunk$chunk.bin" )
+done
+
+"$parcat" "${segments[@]}" "$outputDirectory/joined.bin" || exit 1
+
+# the reconstruction of a chunk ends with the IRAP picture that starts the next chunk
+rm -f "$outputDirectory/chunks.yuv"
+
+for (( chunk = 0; chunk < numChunks; chunk++ )) ; do
+  start=$(( chunk * chunkLength ))
+  end=$(( chunk + 1 < numChunks ? start + chunkLength : numFrames ))
+  numChunkFrames=$(( end < numFrames ? end - start + 1 : end - start ))
+  reconSize=$( wc -c < "$outputDirectory/chunk$chunk.yuv" )
+  frameSize=$(( reconSize / numChunkFrames ))
+
+  head -c $(( ( end - start ) * frameSize )) "$outputDirectory/chunk$chunk.yuv" >> "$outputDirectory/chunks.yuv"
+done
+
+"$decoder" -b "$outputDirectory/joined.bin" -o "$outputDirectory/joined.yuv" > "$outputDirectory/joined.log" 2>&1
+if [[ $? -ne 0 ]] ; then
+  printf "Decoding the joined bitstream failed, see $outputDirectory/joined.log\n" >&2
+  exit 1
+fi
+
+decodedMD5=$( md5sum < "$outputDirectory/joined.yuv" | cut -d ' ' -f 1 )
+chunksMD5=$( md5sum < "$outputDirectory/chunks.yuv" | cut -d ' ' -f 1 )
+
+if [[ $decodedMD5 != $chunksMD5 ]] ; then
+  printf "MD5 mismatch: joined bitstream decodes to $decodedMD5, chunk reconstructions are $chunksMD5\n" >&2
+  exit 1
+fi
+
+echo "Joined bitstream: $outputDirectory/joined.bin (MD5 of the reconstruction $decodedMD5)"
+exit 0
@@ -51,21 +51,29 @@ const unsigned short maxPosList[34] = {6, 12, 18, 23, 29, 35, 41, 46, 52, 58, 64
 BilateralFilter::BilateralFilter()
 {
   int numQP = MAX_QP-18+1;
-  // allocation
+  // allocation, one entry of padding allows reading the last weight as a 32-bit value
   m_bilateralFilterTable = new uint16_t*[numQP];
   for(int i = 0; i < numQP; i++)
   {
-    m_bilateralFilterTable[i] = new uint16_t[maxPosList[i]+1];
+    m_bilateralFilterTable[i] = new uint16_t[maxPosList[i]+2];
   }
 
   // initialization
   for(int i = 0; i < numQP; i++)
   {
-    for(int k = 0; k < (maxPosList[i]+1); k++)
+    for(int k = 0; k < (maxPosList[i]+2); k++)
     {
       m_bilateralFilterTable[i][k] = 0;
     }
   }
+
+  m_smoothBlock = smoothBlockBilateralFilterCore;
+
+#if ENABLE_SIMD_OPT_BIF
+#ifdef TARGET_SIMD_X86
+  initBilateralFilterX86();
+#endif
+#endif
 }
 
 BilateralFilter::~BilateralFilter()
@@ -162,14 +170,8 @@ void BilateralFilter::createBilateralFilterTable(int qp)
 void BilateralFilter::smoothBlockBilateralFilter(unsigned uiWidth, unsigned uiHeight, short block[], int isInterBlock, int qp)
 {
   int length = (int)std::min(uiWidth, uiHeight);
-  int rightPixel, centerPixel;
-  int rightWeight, bottomWeight, centerWeight;
-  int sumWeights[MAX_CU_SIZE];
-  int sumDelta[MAX_CU_SIZE];
   int blockLengthIndex;
 
-  int dIB, dIR;
-
   if( length >= 16 )
   {
     blockLengthIndex = 2;
@@ -183,13 +185,22 @@ void BilateralFilter::smoothBlockBilateralFilter(unsigned uiWidth, unsigned uiHe
     blockLengthIndex = 0;
   }
 
+  const int centerWeight = m_bilateralCenterWeightTable[blockLengthIndex + 3 * isInterBlock];
+
+  m_smoothBlock( uiWidth, uiHeight, block, centerWeight, m_bilateralFilterTable[qp-18], maxPosList[qp-18], divToMulOneOverN, divToMulShift );
+}
 
-  uint16_t *lookupTablePtr;
+void BilateralFilter::smoothBlockBilateralFilterCore( const unsigned uiWidth, const unsigned uiHeight, short block[], const int centerWeight, const uint16_t* lookupTable, const int maxPos, const unsigned* divToMulOneOverN, const unsigned* divToMulShift )
+{
+  int rightPixel, centerPixel;
+  int rightWeight, bottomWeight;
+  int sumWeights[MAX_CU_SIZE];
+  int sumDelta[MAX_CU_SIZE];
 
-  centerWeight = m_bilateralCenterWeightTable[blockLengthIndex + 3 * isInterBlock];
+  int dIB, dIR;
 
-  int theMaxPos = maxPosList[qp-18];
-  lookupTablePtr = m_bilateralFilterTable[qp-18];
+  const uint16_t *lookupTablePtr = lookupTable;
+  const int theMaxPos = maxPos;
 
   // for each pixel in block
 
@@ -546,37 +557,17 @@ void BilateralFilter::bilateralFilterInter( PelBuf& resiBuf, const CPelBuf& pred
 {
   const unsigned uiWidth      = predBuf.width;
   const unsigned uiHeight     = predBuf.height;
-  const unsigned uiPredStride = predBuf.stride;
-  const unsigned uiStrideRes  = resiBuf.stride;
-  const Pel *piPred           = predBuf.buf;
-        Pel *piResi           = resiBuf.buf;
 
-  for( unsigned  uiY = 0; uiY < uiHeight; ++uiY)
-  {
-    for( unsigned uiX = 0; uiX < uiWidth; ++uiX)
-    {
-      tempblock[ uiX + uiY*uiWidth ] = ClipPel( piPred[uiX] + piResi[uiX], clpRng);
-    }
-    piPred += uiPredStride;
-    piResi += uiStrideRes;
-  }
+  PelBuf tempBuf( tempblock, uiWidth, uiWidth, uiHeight );
 
-  smoothBlockBilateralFilter(uiWidth, uiHeight, tempblock, 1, qp);
+  tempBuf.reconstruct( predBuf, resiBuf, clpRng );
 
-  piPred = predBuf.buf;
-  piResi = resiBuf.buf;
+  smoothBlockBilateralFilter(uiWidth, uiHeight, tempblock, 1, qp);
 
   // need to be performed if residual  is used
   // Resi' = Reco' - Pred
-  for (uint32_t uiY = 0; uiY < uiHeight; ++uiY)
-  {
-    for (uint32_t uiX = 0; uiX < uiWidth; ++uiX)
-    {
-      piResi[uiX] = tempblock[ uiX + uiY*uiWidth ] - piPred[uiX];
-    }
-    piPred += uiPredStride;
-    piResi += uiStrideRes;
-  }
+  resiBuf.copyFrom( tempBuf );
+  resiBuf.subtract( predBuf );
 }
 
 #endif
@@ -53,10 +53,14 @@ private:
   int m_bilateralCenterWeightTable[5];
   short tempblock[ MAX_CU_SIZE*MAX_CU_SIZE ];
   unsigned divToMulOneOverN[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];
-  uint8_t divToMulShift[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];
+  unsigned divToMulShift[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];
 
   void smoothBlockBilateralFilter( unsigned uiWidth, unsigned uiHeight, short block[], int isInterBlock, int qp);
 
+protected:
+  // filtering kernel, set to the C++ version in the constructor and replaced by the SIMD version
+  void ( *m_smoothBlock )( const unsigned uiWidth, const unsigned uiHeight, short block[], const int centerWeight, const uint16_t* lookupTable, const int maxPos, const unsigned* divToMulOneOverN, const unsigned* divToMulShift );
+
 public:
   BilateralFilter();
   ~BilateralFilter();
@@ -68,6 +72,15 @@ public:
   void createBilateralFilterTable(int qp);
   void bilateralFilterInter(PelBuf& resiBuf, const CPelBuf& predBuf, int qp, const ClpRng& clpRng);
   void bilateralFilterIntra(PelBuf& recoBuf, int qp);
+
+  // C++ version of the filtering kernel, lookupTable holds the weights of the absolute sample differences 0..maxPos
+  static void smoothBlockBilateralFilterCore( const unsigned uiWidth, const unsigned uiHeight, short block[], const int centerWeight, const uint16_t* lookupTable, const int maxPos, const unsigned* divToMulOneOverN, const unsigned* divToMulShift );
+
+#ifdef TARGET_SIMD_X86
+  void initBilateralFilterX86();
+  template <X86_VEXT vext>
+  void _initBilateralFilterX86();
+#endif
 };
 
 #endif
@@ -179,6 +179,35 @@ void linTfCore( const T* src, int srcStride, Pel *dst, int dstStride, int width,
 #undef LINTF_CORE_INC
 }
 
+template<typename T>
+void wghtAvgCore( const T* src1, int src1Stride, const T* src2, int src2Stride, T* dest, int dstStride, int width, int height, int w0, int w1, int rshift, int offset, const ClpRng& clpRng )
+{
+#define WGHT_AVG_CORE_OP( ADDR ) dest[ADDR] = ClipPel( rightShift( ( w0 * src1[ADDR] + w1 * src2[ADDR] + offset ), rshift ), clpRng )
+#define WGHT_AVG_CORE_INC   \
+  src1 += src1Stride;       \
+  src2 += src2Stride;       \
+  dest +=  dstStride;       \
+
+  SIZE_AWARE_PER_EL_OP( WGHT_AVG_CORE_OP, WGHT_AVG_CORE_INC );
+
+#undef WGHT_AVG_CORE_OP
+#undef WGHT_AVG_CORE_INC
+}
+
+template<typename T>
+void wghtUniCore( const T* src, int srcStride, T* dest, int dstStride, int width, int height, int scale, int round, int rshift, int offset, const ClpRng& clpRng )
+{
+#define WGHT_UNI_CORE_OP( ADDR ) dest[ADDR] = ClipPel( rightShift( ( scale * src[ADDR] + round ), rshift ) + offset, clpRng )
+#define WGHT_UNI_CORE_INC   \
+  src  +=  srcStride;       \
+  dest +=  dstStride;       \
+
+  SIZE_AWARE_PER_EL_OP( WGHT_UNI_CORE_OP, WGHT_UNI_CORE_INC );
+
+#undef WGHT_UNI_CORE_OP
+#undef WGHT_UNI_CORE_INC
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -197,6 +226,12 @@ PelBufferOps::PelBufferOps()
 
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
+
+  wghtAvg4 = wghtAvgCore<Pel>;
+  wghtAvg8 = wghtAvgCore<Pel>;
+
+  wghtUni4 = wghtUniCore<Pel>;
+  wghtUni8 = wghtUniCore<Pel>;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -226,6 +261,19 @@ void AreaBuf<Pel>::addWeightedAvg( const AreaBuf<const Pel> &other1, const AreaB
   const int shiftNum = std::max<int>(2, (IF_INTERNAL_PREC - clipbd)) + log2WeightBase;
   const int offset = (1 << (shiftNum - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  if( ( width & 7 ) == 0 )
+  {
+    g_pelBufOP.wghtAvg8( src0, src1Stride, src2, src2Stride, dest, destStride, width, height, w0, w1, shiftNum, offset, clpRng );
+    return;
+  }
+  else if( ( width & 3 ) == 0 )
+  {
+    g_pelBufOP.wghtAvg4( src0, src1Stride, src2, src2Stride, dest, destStride, width, height, w0, w1, shiftNum, offset, clpRng );
+    return;
+  }
+#endif
+
   for (int i = 0; i < other1.height; i++)
   {
     for (int j = 0; j < other1.width; j++)
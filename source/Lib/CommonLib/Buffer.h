@@ -68,6 +68,12 @@ struct PelBufferOps
   void ( *reco8 )         ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,                                   const ClpRng& clpRng );
   void ( *linTf4 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
   void ( *linTf8 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
+  // dst = Clip( ( w0 * src0 + w1 * src1 + offset ) >> shift )
+  void ( *wghtAvg4 )      ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng );
+  void ( *wghtAvg8 )      ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng );
+  // dst = Clip( ( ( scale * src0 + round ) >> shift ) + offset )
+  void ( *wghtUni4 )      ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int round, int shift, int offset, const ClpRng& clpRng );
+  void ( *wghtUni8 )      ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int round, int shift, int offset, const ClpRng& clpRng );
 #if JVET_K0485_BIO
   void ( *addBIOAvg4 )    ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel*pGradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng);
 #if JVET_K0248_GBI
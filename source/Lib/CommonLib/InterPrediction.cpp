@@ -209,6 +209,8 @@ InterPrediction::InterPrediction()
 #if JVET_K0485_BIO
 , m_pBIOPadRef      ( nullptr )
 #endif
+, m_obmcCacheActive ( false )
+, m_obmcCacheSlice  ( nullptr )
 #endif
 {
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
@@ -304,7 +306,12 @@ void InterPrediction::destroy()
 #if JVET_K0485_BIO
   xFree(m_pBIOPadRef);  m_pBIOPadRef = nullptr;
 #endif
-  m_tmpObmcBuf.destroy();
+  for( auto &tmpObmcBuf : m_tmpObmcBuf )
+  {
+    tmpObmcBuf.destroy();
+  }
+  m_obmcCacheBuf[0].destroy();
+  m_obmcCacheBuf[1].destroy();
 
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
   {
@@ -399,7 +406,12 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC )
     m_pBIOPadRef = (Pel*)xMalloc(Pel, (MAX_CU_SIZE + 2 * JVET_K0485_BIO_EXTEND_SIZE + 2 + 7) * (MAX_CU_SIZE + 2 * JVET_K0485_BIO_EXTEND_SIZE + 2 + 7));
 #endif
 
-    m_tmpObmcBuf.create( UnitArea( chromaFormatIDC, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
+    for( auto &tmpObmcBuf : m_tmpObmcBuf )
+    {
+      tmpObmcBuf.create( UnitArea( chromaFormatIDC, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
+    }
+    m_obmcCacheBuf[0].create( UnitArea( chromaFormatIDC, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
+    m_obmcCacheBuf[1].create( UnitArea( chromaFormatIDC, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
 
     for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
     {
@@ -420,13 +432,23 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC )
 
 #if JEM_TOOLS
 #if JVET_K0485_BIO
-  bioGradFilter = InterPrediction::gradFilter;
+  bioGradFilter      = InterPrediction::gradFilter;
+  bioDotProducts     = InterPrediction::dotProducts;
+  bioCalcBlkGradient = InterPrediction::calcBlkGradient;
 #else
   m_uiaBIOShift[0] = 0;
   for (int i = 1; i < 64; i++)
   {
     m_uiaBIOShift[i] = ((1 << 15) + i / 2) / i;
   }
+#endif
+  licCalcSums        = InterPrediction::calcLICSums;
+  obmcBlend          = InterPrediction::blendOBMC;
+
+#if ENABLE_SIMD_OPT_BIO || ENABLE_SIMD_OPT_LIC || ENABLE_SIMD_OPT_OBMC
+#ifdef TARGET_SIMD_X86
+  initInterPredictionX86();
+#endif
 #endif
 #endif
 #if !JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -1420,6 +1442,21 @@ int getMSB( unsigned x )
 }
 
 #if JEM_TOOLS
+void InterPrediction::calcLICSums( const Pel* ref, int refStride, const Pel* rec, int recStride, int length, int dimShift, int precShift, int& x, int& y, int& xx, int& xy )
+{
+  const int numSteps = 1 << dimShift;
+
+  for( int k = 0; k < numSteps; k++ )
+  {
+    int refVal  = ref[refStride * ( ( k * length ) >> dimShift )] >> precShift;
+    int recVal  = rec[recStride * ( ( k * length ) >> dimShift )] >> precShift;
+    x          += refVal;
+    y          += recVal;
+    xx         += refVal * refVal;
+    xy         += refVal * recVal;
+  }
+}
+
 void InterPrediction::xGetLICParams( const CodingUnit& cu,
                                      const ComponentID compID,
                                      const Picture&    refPic,
@@ -1446,7 +1483,6 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
   const int       minDim        = 1 << minDimBit;
         int       minStepBit    = ( !cu.cs->pcv->rectCUs || minDim > 8 ? 1 : 0 );
         while   ( minDimBit > minStepBit + maxNumMinus1 )  { minStepBit++; } //make sure log2(2*minDim/tmpStep) + 2*min(bitDepth,12) <= 30
-  const int       numSteps      = minDim >> minStepBit;
   const Picture&  currPic       = *cu.cs->picture;
   const int       dimShift      = minDimBit - minStepBit;
 
@@ -1471,17 +1507,13 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
     const Pel*    ref     = refBuf.bufAt( cu.blocks[compID].pos().offset( hOff, vOff ) );
     const Pel*    rec     = recBuf.bufAt( cu.blocks[compID].pos().offset(    0,   -1 ) );
 
-    for( int k = 0; k < numSteps; k++ )
+    licCalcSums( ref, 1, rec, 1, cuWidth, dimShift, precShift, x, y, xx, xy );
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+    for( int k = 0; k < ( 1 << dimShift ); k++ )
     {
-      int refVal  = ref[( ( k * cuWidth ) >> dimShift )] >> precShift;
-      int recVal  = rec[( ( k * cuWidth ) >> dimShift )] >> precShift;
-
       JVET_J0090_CACHE_ACCESS( &ref[( ( k * cuWidth ) >> dimShift )], __FILE__, __LINE__ );
-      x          += refVal;
-      y          += recVal;
-      xx         += refVal * refVal;
-      xy         += refVal * recVal;
     }
+#endif
 
     cntShift = dimShift;
   }
@@ -1499,15 +1531,7 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
     const Pel*    ref     = refBuf.bufAt( cu.blocks[compID].pos().offset( hOff, vOff ) );
     const Pel*    rec     = recBuf.bufAt( cu.blocks[compID].pos().offset(   -1,    0 ) );
 
-    for( int k = 0; k < numSteps; k++ )
-    {
-      int refVal     = ref[refBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
-      int recVal     = rec[recBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
-      x             += refVal;
-      y             += recVal;
-      xx            += refVal * refVal;
-      xy            += refVal * recVal;
-    }
+    licCalcSums( ref, refBuf.stride, rec, recBuf.stride, cuHeight, dimShift, precShift, x, y, xx, xy );
 
     cntShift += ( cntShift ? 1 : dimShift );
   }
@@ -1670,20 +1694,18 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
   int64_t* m_piDotProductTemp5 = m_piDotProduct5;
   int64_t* m_piDotProductTemp6 = m_piDotProduct6;
 
+#if JVET_K0485_BIO
+  bioDotProducts(pSrcY0Temp, iSrc0Stride, pSrcY1Temp, iSrc1Stride, pGradX0, pGradX1, pGradY0, pGradY1, iWidthG, iWidthG, iHeightG,
+                 m_piDotProductTemp1, m_piDotProductTemp2, m_piDotProductTemp3, m_piDotProductTemp5, m_piDotProductTemp6);
+#else
   int64_t temp=0, tempX=0, tempY=0;
   for( int y = 0; y < iHeightG; y++ )
   {
     for( int x = 0; x < iWidthG; x++ )
     {
-#if JVET_K0485_BIO
-      temp  = (pSrcY0Temp[x] - pSrcY1Temp[x]);
-      tempX = (pGradX0[x] + pGradX1[x]);
-      tempY = (pGradY0[x] + pGradY1[x]);
-#else
       temp  = (int64_t)( pSrcY0Temp[x] - pSrcY1Temp[x] );
       tempX = (int64_t)( pGradX0   [x] + pGradX1   [x] );
       tempY = (int64_t)( pGradY0   [x] + pGradY1   [x] );
-#endif
       m_piDotProductTemp1[x] =  tempX * tempX;
       m_piDotProductTemp2[x] =  tempX * tempY;
       m_piDotProductTemp3[x] = -tempX * temp<<5;
@@ -1702,6 +1724,7 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
     m_piDotProductTemp5 += iWidthG;
     m_piDotProductTemp6 += iWidthG;
   }
+#endif
 
   int xUnit = (iWidth >> 2);
   int yUnit = (iHeight >> 2);
@@ -1739,8 +1762,8 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
       m_piDotProductTemp5 = m_piDotProduct5 + offsetPos + ((yu*iWidthG + xu) << 2);
       m_piDotProductTemp6 = m_piDotProduct6 + offsetPos + ((yu*iWidthG + xu) << 2);
 
-      calcBlkGradient(xu << 2, yu << 2, m_piDotProductTemp1, m_piDotProductTemp2, m_piDotProductTemp3, m_piDotProductTemp5, m_piDotProductTemp6,
-                      sGx2, sGy2, sGxGy, sGxdI, sGydI, iWidthG, iHeightG, (1 << 2));
+      bioCalcBlkGradient(xu << 2, yu << 2, m_piDotProductTemp1, m_piDotProductTemp2, m_piDotProductTemp3, m_piDotProductTemp5, m_piDotProductTemp6,
+                         sGx2, sGy2, sGxGy, sGxdI, sGydI, iWidthG, iHeightG, (1 << 2));
 #else
       m_piDotProductTemp1 = m_piDotProduct1 + ((yu*iWidthG + xu) << 2);
       m_piDotProductTemp2 = m_piDotProduct2 + ((yu*iWidthG + xu) << 2);
@@ -2074,7 +2097,11 @@ void InterPrediction::subBlockOBMC( PredictionUnit  &pu, PelUnitBuf* pDst, bool
   CodingStructure &cs        = *pu.cs;
 
   PelUnitBuf pcYuvPred       = pDst == nullptr ? pu.cs->getPredBuf( pu ) : *pDst;
-  PelUnitBuf pcYuvTmpPred1   = m_tmpObmcBuf.subBuf( UnitAreaRelative( *pu.cu, pu ) );
+  PelUnitBuf pcYuvTmpPred1[4];
+  for( int iDir = 0; iDir < 4; iDir++ )
+  {
+    pcYuvTmpPred1[iDir] = m_tmpObmcBuf[iDir].subBuf( UnitAreaRelative( *pu.cu, pu ) );
+  }
 
   const PartSize   ePartSize = pu.cu->partSize;
   const UnitArea   orgPuArea = pu;
@@ -2131,192 +2158,255 @@ void InterPrediction::subBlockOBMC( PredictionUnit  &pu, PelUnitBuf* pDst, bool
 
   int maxDir =  bNormal2Nx2N ? 2 : 4;
 
-  for (int iSubX = 0; iSubX < uiWidthInBlock; iSubX += uiStep)
+#if JVET_K0346
+  bool bSubBlockOBMCSimp = (bOBMCSimp || ((pu.mergeType == MRG_TYPE_SUBPU_ATMVP || pu.mergeType == MRG_TYPE_SUBPU_ATMVP_EXT) && (1 << pu.cs->slice->getSubPuMvpSubblkLog2Size()) == 4));
+#else
+  bool bSubBlockOBMCSimp = ( bOBMCSimp || ( (pu.mergeType == MRG_TYPE_SUBPU_ATMVP || pu.mergeType == MRG_TYPE_SUBPU_ATMVP_EXT ) && ( 1 << pu.cs->sps->getSpsNext().getSubPuMvpLog2Size() ) == 4 ) );
+#endif
+  bSubBlockOBMCSimp |= ( bFruc && nRefineBlkSize == 4 );
+  bSubBlockOBMCSimp |= bAffine;
+
+  // the neighbour predictions along the top and left CU boundary are reused across the modes tested for the CU, unless the motion
+  // compensation depends on more than the neighbour motion: LIC derives its parameters from the current reconstruction
+  const bool bUseCache     = m_obmcCacheActive && ePartSize == SIZE_2Nx2N && !pu.cu->LICFlag;
+
+  if( bUseCache && ( m_obmcCacheSlice != pu.cs->slice || m_obmcCacheArea != pu.cu->Y() ) )
   {
-    for (int iSubY = 0; iSubY < uiHeightInBlock; iSubY += uiStep)
+    m_obmcCacheSlice = pu.cs->slice;
+    m_obmcCacheArea  = pu.cu->Y();
+
+    for( auto &entries : m_obmcCache )
     {
-      if (bNormal2Nx2N && iSubX && iSubY)
+      for( auto &entry : entries )
       {
-        continue;
+        entry.valid = false;
       }
+    }
+  }
+
+  // adjacent sub-blocks sharing the neighbour motion of a direction are predicted by one motion compensation into the buffer of the
+  // direction, except for LIC, whose parameters depend on the block size
+  const bool bMergeMC = !pu.cu->LICFlag;
+
+  // returns whether the sub-block is blended with the prediction from the neighbour motion in direction iDir
+  auto getOBMCNeighborMotion = [&]( const int iSubX, const int iSubY, const int iDir, MotionInfo &mi )
+  {
+    if( bNormal2Nx2N && iSubX && iSubY )
+    {
+      return false;
+    }
+
+    bool bCURBoundary = bVerticalPU   ? ( iSubX == uiWidhtInCU  - uiStep ) : b2ndPU ? iSubX + i1stPUWidth   == uiWidhtInCU  - uiStep : ( iSubX == uiWidhtInCU  - uiStep ) ;
+    bool bCUBBoundary = bHorizontalPU ? ( iSubY == uiHeightInCU - uiStep ) : b2ndPU ? iSubY + i1stPUHeight  == uiHeightInCU - uiStep : ( iSubY == uiHeightInCU - uiStep ) ;
+
+    if ((iDir == 3 && bCURBoundary) || (iDir == 2 && bCUBBoundary))
+    {
+      return false;
+    }
 
-      bool bCURBoundary = bVerticalPU   ? ( iSubX == uiWidhtInCU  - uiStep ) : b2ndPU ? iSubX + i1stPUWidth   == uiWidhtInCU  - uiStep : ( iSubX == uiWidhtInCU  - uiStep ) ;
-      bool bCUBBoundary = bHorizontalPU ? ( iSubY == uiHeightInCU - uiStep ) : b2ndPU ? iSubY + i1stPUHeight  == uiHeightInCU - uiStep : ( iSubY == uiHeightInCU - uiStep ) ;
+    bool bVerPUBound = false;
+    bool bHorPUBound = false;
 
-      for (int iDir = 0; iDir < maxDir; iDir++) //iDir: 0 - above, 1 - left, 2 - below, 3 - right
+    if( bNormal2Nx2N ) //skip unnecessary check for CU boundary
+    {
+      if( ( iDir == 1 && !iSubY && iSubX ) || ( iDir == 0 && !iSubX && iSubY ) )
+      {
+        return false;
+      }
+    }
+    else
+    {
+      bool bCheckNeig = bSubMotion || ( iSubX == 0 && iDir == 1 ) || ( iSubY == 0 && iDir == 0 ); //CU boundary or NxN or 2nx2n_ATMVP
+      if( !bCheckNeig && bTwoPUs )
       {
-        if ((iDir == 3 && bCURBoundary) || (iDir == 2 && bCUBBoundary))
+        bCheckNeig |= bFruc;
+        bCheckNeig |= bATMVP;
+
+        //PU boundary
+        if( !b2ndPU )
         {
-          continue;
+          bVerPUBound = bVerticalPU   && ( ( iDir == 2 && iSubY == i1stPUHeight - uiStep ) );
+          bHorPUBound = bHorizontalPU && ( ( iDir == 3 && iSubX == i1stPUWidth  - uiStep ) );
         }
 
-        bool bVerPUBound = false;
-        bool bHorPUBound = false;
+        bCheckNeig |= ( bVerPUBound || bHorPUBound );
+      }
+      if( !bCheckNeig )
+      {
+        return false;
+      }
+    }
+
+    return PU::getNeighborMotion( pu, mi, Position( iSubX * uiMinCUW, iSubY * uiMinCUW ), iDir, ( bATMVP || bFruc || bAffine ) );
+  };
 
-        if( bNormal2Nx2N ) //skip unnecessary check for CU boundary
+  // blends the span of sub-blocks [iBeg, iEnd) of a row (above, below) or column (left, right) of sub-blocks with one call per
+  // component, so that the kernels see the whole length of the span
+  auto blendSpan = [&]( const int iDir, const int iLine, const int iBeg, const int iEnd, PelUnitBuf &cTmpBuf )
+  {
+    const bool bRows = iDir == 0 || iDir == 2;
+
+    pu.UnitArea::operator=( UnitArea( pu.chromaFormat, Area( orgPuArea.lumaPos().offset( ( bRows ? iBeg : iLine ) * uiMinCUW, ( bRows ? iLine : iBeg ) * uiMinCUW ),
+                                                             Size( bRows ? ( iEnd - iBeg ) * uiMinCUW : uiOBMCBlkSize, bRows ? uiOBMCBlkSize : ( iEnd - iBeg ) * uiMinCUW ) ) ) );
+
+    const UnitArea predArea = UnitAreaRelative( orgPuArea, pu );
+
+    PelUnitBuf cPred = pcYuvPred.subBuf( predArea );
+    PelUnitBuf cTmp1 = cTmpBuf  .subBuf( predArea );
+
+    if( bOBMC4ME )
+    {
+      xSubtractOBMC( pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
+    }
+    else
+    {
+      xSubblockOBMC( COMPONENT_Y,  pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
+      xSubblockOBMC( COMPONENT_Cb, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
+      xSubblockOBMC( COMPONENT_Cr, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
+    }
+
+    pu.UnitArea::operator=( orgPuArea );
+  };
+
+  // the directions are blended one after the other over the whole PU, every sample still sees them in the order above, left, below,
+  // right, as it belongs to a single sub-block
+  for( int iDir = 0; iDir < maxDir; iDir++ ) //iDir: 0 - above, 1 - left, 2 - below, 3 - right
+  {
+    const bool bRows    = iDir == 0 || iDir == 2;
+    const int  iLineEnd = bRows ? uiHeightInBlock : uiWidthInBlock;
+    const int  iPosEnd  = bRows ? uiWidthInBlock  : uiHeightInBlock;
+
+    // only the top row and the left column of a regular 2Nx2N PU are blended
+    for( int iLine = 0; iLine < ( bNormal2Nx2N ? 1 : iLineEnd ); iLine += uiStep )
+    {
+      const bool  bCached  = bUseCache && ( iDir == 0 || iDir == 1 ) && !iLine;
+      PelUnitBuf &cTmpBuf  = bCached ? m_obmcCacheBuf[iDir] : pcYuvTmpPred1[iDir];
+      int         runEnd   = 0;
+      int         blendBeg = -1;
+
+      for( int iPos = 0; iPos < iPosEnd; iPos += uiStep )
+      {
+        const int  iSubX  = bRows ? iPos  : iLine;
+        const int  iSubY  = bRows ? iLine : iPos;
+        const bool bInRun = iPos < runEnd;
+
+        // the sub-blocks of a predicted run were checked when the run was formed
+        if( !bInRun && !getOBMCNeighborMotion( iSubX, iSubY, iDir, NeighMi ) )
         {
-          if( ( iDir == 1 && !iSubY && iSubX ) || ( iDir == 0 && !iSubX && iSubY ) )
+          if( blendBeg >= 0 )
           {
-            continue;
+            blendSpan( iDir, iLine, blendBeg, iPos, cTmpBuf );
+            blendBeg = -1;
           }
+          continue;
         }
-        else
+
+        if( blendBeg < 0 )
         {
-          bool bCheckNeig = bSubMotion || ( iSubX == 0 && iDir == 1 ) || ( iSubY == 0 && iDir == 0 ); //CU boundary or NxN or 2nx2n_ATMVP
-          if( !bCheckNeig && bTwoPUs )
+          blendBeg = iPos;
+        }
+
+        if( !bInRun )
+        {
+          OBMCCacheEntry *pEntry = bCached ? &m_obmcCache[iDir][iPos] : nullptr;
+
+          const bool bHit  = pEntry && pEntry->valid && pEntry->maxCompID >= m_maxCompIDToPred
+#if JVET_K0248_GBI
+                             && pEntry->gbiIdx == pu.cu->GBiIdx
+#endif
+                             && xIsSameOBMCMotion( pEntry->mi, NeighMi );
+
+          if( !bHit )
           {
-            bCheckNeig |= bFruc;
-            bCheckNeig |= bATMVP;
+            int        iEnd    = iPos + uiStep;
+            MotionInfo runMi;
 
-            //PU boundary
-            if( !b2ndPU )
+            while( bMergeMC && iEnd < iPosEnd && getOBMCNeighborMotion( bRows ? iEnd : iSubX, bRows ? iSubY : iEnd, iDir, runMi ) && xIsSameOBMCMotion( runMi, NeighMi ) )
             {
-              bVerPUBound = bVerticalPU   && ( ( iDir == 2 && iSubY == i1stPUHeight - uiStep ) );
-              bHorPUBound = bHorizontalPU && ( ( iDir == 3 && iSubX == i1stPUWidth  - uiStep ) );
+              iEnd += uiStep;
             }
 
-            bCheckNeig |= ( bVerPUBound || bHorPUBound );
-          }
-          if( !bCheckNeig )
-          {
-            continue;
-          }
-        }
+            runEnd = iEnd;
 
-#if JVET_K0346
-        bool bSubBlockOBMCSimp = (bOBMCSimp || ((pu.mergeType == MRG_TYPE_SUBPU_ATMVP || pu.mergeType == MRG_TYPE_SUBPU_ATMVP_EXT) && (1 << pu.cs->slice->getSubPuMvpSubblkLog2Size()) == 4));
-#else
-        bool bSubBlockOBMCSimp = ( bOBMCSimp || ( (pu.mergeType == MRG_TYPE_SUBPU_ATMVP || pu.mergeType == MRG_TYPE_SUBPU_ATMVP_EXT ) && ( 1 << pu.cs->sps->getSpsNext().getSubPuMvpLog2Size() ) == 4 ) );
-#endif
-        bSubBlockOBMCSimp |= ( bFruc && nRefineBlkSize == 4 );
-        bSubBlockOBMCSimp |= bAffine;
+            //store temporary motion information
+            pu              = NeighMi;
+            pu.cu->partSize = SIZE_2Nx2N;
+            pu.cu->affine   = false;
+            pu.UnitArea::operator=( UnitArea( pu.chromaFormat, Area( orgPuArea.lumaPos().offset( iSubX * uiMinCUW, iSubY * uiMinCUW ),
+                                                                     Size( bRows ? ( iEnd - iPos ) * uiMinCUW : uiOBMCBlkSize, bRows ? uiOBMCBlkSize : ( iEnd - iPos ) * uiMinCUW ) ) ) );
 
-        if( PU::getNeighborMotion( pu, NeighMi, Position( iSubX * uiMinCUW, iSubY * uiMinCUW ), iDir, ( bATMVP || bFruc || bAffine ) ) )
-        {
-          //store temporary motion information
-          pu              = NeighMi;
-          pu.cu->partSize = SIZE_2Nx2N;
-          pu.cu->affine   = false;
-          pu.UnitArea::operator=( UnitArea( pu.chromaFormat, Area( orgPuArea.lumaPos().offset( iSubX * uiMinCUW, iSubY * uiMinCUW ), Size{ uiOBMCBlkSize, uiOBMCBlkSize } ) ) );
+            PelUnitBuf cTmpRun = cTmpBuf.subBuf( UnitAreaRelative( orgPuArea, pu ) );
 
-          const UnitArea predArea = UnitAreaRelative( orgPuArea, pu );
+            xSubBlockMotionCompensation( pu, cTmpRun );
 
-          PelUnitBuf cPred = pcYuvPred    .subBuf( predArea );
-          PelUnitBuf cTmp1 = pcYuvTmpPred1.subBuf( predArea );
+            for( int iRunPos = iPos; pEntry && iRunPos < iEnd; iRunPos += uiStep )
+            {
+              OBMCCacheEntry &entry = m_obmcCache[iDir][iRunPos];
 
-          xSubBlockMotionCompensation( pu, cTmp1 );
+              entry.valid     = true;
+              entry.mi        = NeighMi;
+#if JVET_K0248_GBI
+              entry.gbiIdx    = pu.cu->GBiIdx;
+#endif
+              entry.maxCompID = m_maxCompIDToPred;
+            }
 
-          if( bOBMC4ME )
-          {
-            xSubtractOBMC( pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-          }
-          else
-          {
-            xSubblockOBMC( COMPONENT_Y,  pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-            xSubblockOBMC( COMPONENT_Cb, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-            xSubblockOBMC( COMPONENT_Cr, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
+            //restore motion information
+            pu.cu->partSize  = ePartSize;
+            pu               = currMi;
+            pu.cu->affine    = bAffine;
+            pu.UnitArea::operator=( orgPuArea );
           }
-
-          //restore motion information
-          pu.cu->partSize  = ePartSize;
-          pu               = currMi;
-          pu.cu->affine    = bAffine;
-          pu.UnitArea::operator=( orgPuArea );
         }
       }
+
+      if( blendBeg >= 0 )
+      {
+        blendSpan( iDir, iLine, blendBeg, iPosEnd, cTmpBuf );
+      }
     }
   }
 }
 
 
-// Function for (weighted) averaging predictors of current block and predictors generated by applying neighboring motions to current block.
-void InterPrediction::xSubblockOBMC(const ComponentID eComp, PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, int iDir, bool bOBMCSimp)
+void InterPrediction::resetOBMCCache()
 {
-  int iWidth  = pu.blocks[eComp].width;
-  int iHeight = pu.blocks[eComp].height;
-
-  if( iWidth == 0 || iHeight == 0 )
-  {
-    return;
-  }
-
-  PelBuf *pDst = &pcYuvPredDst.bufs[eComp];//.at(0, 0);
-  PelBuf *pSrc = &pcYuvPredSrc.bufs[eComp];//.at(0, 0);
+  m_obmcCacheActive = true;
+  m_obmcCacheSlice  = nullptr;
+  m_obmcCacheArea   = Area();
+}
 
-  if( iDir == 0 ) //above
+bool InterPrediction::xIsSameOBMCMotion( const MotionInfo &mi0, const MotionInfo &mi1 )
+{
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
   {
-    for( int i = 0; i < iWidth; i++ )
+    if( mi0.refIdx[refList] != mi1.refIdx[refList] || ( mi0.refIdx[refList] >= 0 && mi0.mv[refList] != mi1.mv[refList] ) )
     {
-      pDst->at( i, 0 ) = ( 3 * pDst->at( i, 0 ) + pSrc->at( i, 0 ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( i, 1 ) = ( 7 * pDst->at( i, 1 ) + pSrc->at( i, 1 ) + 4 ) >> 3;
-      }
-
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( i, 2 ) = ( 15 * pDst->at( i, 2 ) + pSrc->at( i, 2 ) +  8 ) >> 4;
-        pDst->at( i, 3 ) = ( 31 * pDst->at( i, 3 ) + pSrc->at( i, 3 ) + 16 ) >> 5;
-      }
+      return false;
     }
   }
 
-  if( iDir == 1 ) //left
-  {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( 0, i ) = ( 3 * pDst->at( 0, i ) + pSrc->at( 0, i ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( 1, i ) = ( 7 * pDst->at( 1, i ) + pSrc->at( 1, i ) + 4 ) >> 3;
-      }
+  return mi0.interDir == mi1.interDir;
+}
 
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( 2, i ) = ( 15 * pDst->at( 2, i ) + pSrc->at( 2, i ) +  8 ) >> 4;
-        pDst->at( 3, i ) = ( 31 * pDst->at( 3, i ) + pSrc->at( 3, i ) + 16 ) >> 5;
-      }
-    }
-  }
+// Function for (weighted) averaging predictors of current block and predictors generated by applying neighboring motions to current block.
+void InterPrediction::xSubblockOBMC(const ComponentID eComp, PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, int iDir, bool bOBMCSimp)
+{
+  int iWidth  = pu.blocks[eComp].width;
+  int iHeight = pu.blocks[eComp].height;
 
-  if( iDir == 2 ) //below
+  if( iWidth == 0 || iHeight == 0 )
   {
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, iHeight - 1 ) = ( 3 * pDst->at( i, iHeight - 1 ) + pSrc->at( i, iHeight - 1 ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( i, iHeight - 2 ) = ( 7 * pDst->at( i, iHeight - 2 ) + pSrc->at( i, iHeight - 2 ) + 4 ) >> 3;
-      }
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( i, iHeight - 3 ) = ( 15 * pDst->at( i, iHeight - 3 ) + pSrc->at( i, iHeight - 3 ) +  8 ) >> 4;
-        pDst->at( i, iHeight - 4 ) = ( 31 * pDst->at( i, iHeight - 4 ) + pSrc->at( i, iHeight - 4 ) + 16 ) >> 5;
-      }
-    }
+    return;
   }
 
-  if( iDir == 3 ) //right
-  {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( iWidth - 1, i ) = ( 3 * pDst->at( iWidth - 1, i ) + pSrc->at( iWidth - 1, i ) + 2 ) >> 2;
+  PelBuf &dst = pcYuvPredDst.bufs[eComp];
+  PelBuf &src = pcYuvPredSrc.bufs[eComp];
 
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( iWidth - 2, i ) = ( 7 * pDst->at( iWidth - 2, i ) + pSrc->at( iWidth - 2, i ) + 4 ) >> 3;
-      }
+  // luma is blended over four lines next to the boundary and chroma over two, the simplified OBMC halves both
+  const int numLines = ( eComp == COMPONENT_Y ? 4 : 2 ) >> ( bOBMCSimp ? 1 : 0 );
 
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( iWidth - 3, i ) = ( 15 * pDst->at( iWidth - 3, i ) + pSrc->at( iWidth - 3, i ) +  8 ) >> 4;
-        pDst->at( iWidth - 4, i ) = ( 31 * pDst->at( iWidth - 4, i ) + pSrc->at( iWidth - 4, i ) + 16 ) >> 5;
-      }
-    }
-  }
+  obmcBlend( dst.buf, dst.stride, src.buf, src.stride, iWidth, iHeight, iDir, numLines, false );
 }
 
 // Function for subtracting (scaled) predictors generated by applying neighboring motions to current block from the original signal of current block.
@@ -2325,79 +2415,40 @@ void InterPrediction::xSubtractOBMC( PredictionUnit &pu, PelUnitBuf &pcYuvPredDs
   int iWidth  = pu.lwidth();
   int iHeight = pu.lheight();
 
-  PelBuf *pDst = &pcYuvPredDst.bufs[COMPONENT_Y];
-  PelBuf *pSrc = &pcYuvPredSrc.bufs[COMPONENT_Y];
+  PelBuf &dst = pcYuvPredDst.bufs[COMPONENT_Y];
+  PelBuf &src = pcYuvPredSrc.bufs[COMPONENT_Y];
 
-  if( iDir == 0 ) //above
-  {
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, 0 ) += ( pDst->at( i, 0 ) - pSrc->at( i, 0 ) + 2 ) >> 2;
-      pDst->at( i, 1 ) += ( pDst->at( i, 1 ) - pSrc->at( i, 1 ) + 4 ) >> 3;
-    }
+  obmcBlend( dst.buf, dst.stride, src.buf, src.stride, iWidth, iHeight, iDir, bOBMCSimp ? 2 : 4, true );
+}
 
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iWidth; i++ )
-      {
-        pDst->at( i, 2 ) += ( pDst->at( i, 2 ) - pSrc->at( i, 2 ) +  8 ) >> 4;
-        pDst->at( i, 3 ) += ( pDst->at( i, 3 ) - pSrc->at( i, 3 ) + 16 ) >> 5;
-      }
-    }
-  }
+void InterPrediction::blendOBMC( Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, int dir, int numLines, bool subtract )
+{
+  // line k counted from the boundary (dir: 0 - above, 1 - left, 2 - below, 3 - right) is weighted ( 2^(k+2) - 1 ) : 1 when blending,
+  // when subtracting for the motion estimation 1 / 2^(k+2) of its difference to the neighbour prediction is added instead
+  const bool rows   = dir == 0 || dir == 2;
+  const int  length = rows ? width : height;
+  const int  dStep  = rows ? 1 : dstStride;
+  const int  sStep  = rows ? 1 : srcStride;
 
-  if( iDir == 1 ) //left
+  for( int k = 0; k < numLines; k++ )
   {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( 0, i ) += ( pDst->at( 0, i ) - pSrc->at( 0, i ) + 2 ) >> 2;
-      pDst->at( 1, i ) += ( pDst->at( 1, i ) - pSrc->at( 1, i ) + 4 ) >> 3;
-    }
+    const int  line  = dir < 2 ? k : ( rows ? height : width ) - 1 - k;
+    const int  shift = k + 2;
+    const int  add   = 1 << ( k + 1 );
+    Pel*       d     = rows ? dst + line * dstStride : dst + line;
+    const Pel* s     = rows ? src + line * srcStride : src + line;
 
-    if( !bOBMCSimp )
+    for( int i = 0; i < length; i++ )
     {
-      for( int i = 0; i < iHeight; i++ )
+      if( subtract )
       {
-        pDst->at( 2, i ) += ( pDst->at( 2, i ) - pSrc->at( 2, i ) +  8 ) >> 4;
-        pDst->at( 3, i ) += ( pDst->at( 3, i ) - pSrc->at( 3, i ) + 16 ) >> 5;
+        d[i * dStep] += ( d[i * dStep] - s[i * sStep] + add ) >> shift;
       }
-    }
-  }
-
-  if( iDir == 2 ) //below
-  {
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iWidth; i++ )
-      {
-        pDst->at( i, iHeight - 4 ) += ( pDst->at( i, iHeight - 4 ) - pSrc->at( i, iHeight - 4 ) + 16 ) >> 5;
-        pDst->at( i, iHeight - 3 ) += ( pDst->at( i, iHeight - 3 ) - pSrc->at( i, iHeight - 3 ) +  8 ) >> 4;
-      }
-    }
-
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, iHeight - 2 ) += ( pDst->at( i, iHeight - 2 ) - pSrc->at( i, iHeight - 2 ) + 4 ) >> 3;
-      pDst->at( i, iHeight - 1 ) += ( pDst->at( i, iHeight - 1 ) - pSrc->at( i, iHeight - 1 ) + 2 ) >> 2;
-    }
-  }
-
-  if( iDir == 3 ) //right
-  {
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iHeight; i++ )
+      else
       {
-        pDst->at( iWidth - 4, i ) += ( pDst->at( iWidth - 4, i ) - pSrc->at( iWidth - 4, i ) + 16 ) >> 5;
-        pDst->at( iWidth - 3, i ) += ( pDst->at( iWidth - 3, i ) - pSrc->at( iWidth - 3, i ) +  8 ) >> 4;
+        d[i * dStep] = ( ( ( 1 << shift ) - 1 ) * d[i * dStep] + s[i * sStep] + add ) >> shift;
       }
     }
-
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( iWidth - 2, i ) += ( pDst->at( iWidth - 2, i ) - pSrc->at( iWidth - 2, i ) + 4 ) >> 3;
-      pDst->at( iWidth - 1, i ) += ( pDst->at( iWidth - 1, i ) - pSrc->at( iWidth - 1, i ) + 2 ) >> 2;
-    }
   }
 }
 #endif
@@ -2432,6 +2483,37 @@ void InterPrediction::gradFilter(Pel* pSrc, int srcStride, int width, int height
     pSrc += srcStride;
   }
 }
+
+void InterPrediction::dotProducts(const Pel* pSrc0, int src0Stride, const Pel* pSrc1, int src1Stride, const Pel* pGradX0, const Pel* pGradX1, const Pel* pGradY0, const Pel* pGradY1, int gradStride,
+                                  int width, int height, int64_t* pDotProduct1, int64_t* pDotProduct2, int64_t* pDotProduct3, int64_t* pDotProduct5, int64_t* pDotProduct6)
+{
+  int64_t temp = 0, tempX = 0, tempY = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      temp  = (pSrc0[x] - pSrc1[x]);
+      tempX = (pGradX0[x] + pGradX1[x]);
+      tempY = (pGradY0[x] + pGradY1[x]);
+      pDotProduct1[x] =  tempX * tempX;
+      pDotProduct2[x] =  tempX * tempY;
+      pDotProduct3[x] = -tempX * temp << 5;
+      pDotProduct5[x] =  tempY * tempY << 1;
+      pDotProduct6[x] = -tempY * temp << 6;
+    }
+    pSrc0        += src0Stride;
+    pSrc1        += src1Stride;
+    pGradX0      += gradStride;
+    pGradX1      += gradStride;
+    pGradY0      += gradStride;
+    pGradY1      += gradStride;
+    pDotProduct1 += gradStride;
+    pDotProduct2 += gradStride;
+    pDotProduct3 += gradStride;
+    pDotProduct5 += gradStride;
+    pDotProduct6 += gradStride;
+  }
+}
 #else
 void InterPrediction::xGradFilterX( const Pel* piRefY, int iRefStride, Pel* piDstY, int iDstStride, int iWidth, int iHeight, int iMVyFrac, int iMVxFrac, const int bitDepth )
 {
@@ -4358,19 +4440,29 @@ void InterPrediction::xBIPMVRefine( PredictionUnit& pu, RefPicList eRefPicList,
 #else
 MRSADtype InterPrediction::xDirectMCCostDMVR(const Pel* pSrcL0, const Pel* pSrcL1, uint32_t stride, SizeType width, SizeType height, const DistParam &cDistParam)
 {
-  MRSADtype sum = 0;
-  const int16_t deltaC = (int16_t)round((double)(cDistParam.meanL0 - cDistParam.meanL1) / (width * height));
+  MRSADtype cost;
+  xDirectMCCostsDMVR(&pSrcL0, &pSrcL1, stride, width, height, &cDistParam.meanL0, &cDistParam.meanL1, 1, &cost);
+  return cost;
+}
 
-  for (SizeType j = 0; j < height; j++)
+void InterPrediction::xDirectMCCostsDMVR(const Pel* const* pSrcL0, const Pel* const* pSrcL1, uint32_t stride, SizeType width, SizeType height, const int32_t* meanL0, const int32_t* meanL1, int numCand, MRSADtype* costs)
+{
+  int deltaC[SAD_POINT_INDEX::COUNT] = { 0 };
+  CHECK(numCand > SAD_POINT_INDEX::COUNT, "Too many DMVR search points");
+
+  for (int c = 0; c < numCand; c++)
   {
-    for (SizeType i = 0; i < width; i++)
-    {
-      sum += abs(pSrcL0[i] - pSrcL1[i] - deltaC);
-    }
-    pSrcL0 += stride;
-    pSrcL1 += stride;
+    deltaC[c] = (int16_t)round((double)(meanL0[c] - meanL1[c]) / (width * height));
+  }
+
+  // the kernels score into Distortion, which is wider than MRSADtype without DISTORTION_TYPE_BUGFIX and FULL_NBIT
+  Distortion dist[SAD_POINT_INDEX::COUNT];
+  RdCost::getDMVRCosts(pSrcL0, pSrcL1, stride, width, height, deltaC, numCand, dist);
+
+  for (int c = 0; c < numCand; c++)
+  {
+    costs[c] = (MRSADtype)dist[c];
   }
-  return sum;
 }
 
 void InterPrediction::sumUpSamples(const Pel * pDst, uint32_t  refStride, SizeType cuWidth, SizeType cuHeight, int32_t& Avg)
@@ -4418,6 +4510,14 @@ void InterPrediction::xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift
     int32_t LineMeanL0[4] = { 0, 0, 0, 0 };
     int32_t LineMeanL1[4] = { 0, 0, 0, 0 };
     const int32_t refStride = m_cYuvPredTempL0.Y().stride;
+    // the cross positions without a cost of the previous round are scored in one pass, then compared in their order
+    Mv crossMvDL0[4];
+    int32_t crossMeanL0[4], crossMeanL1[4];
+    const Pel* scoredRefL0[4];
+    const Pel* scoredRefL1[4];
+    int32_t scoredMeanL0[4], scoredMeanL1[4];
+    SAD_POINT_INDEX scoredIndex[4];
+    int numScored = 0;
     for (SAD_POINT_INDEX nIdx = SAD_POINT_INDEX::BOTTOM; nIdx <= SAD_POINT_INDEX::TOP_LEFT; ++nIdx)
     {
 #if REMOVE_MV_ADAPT_PREC
@@ -4502,14 +4602,37 @@ void InterPrediction::xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift
       }
       const SAD_POINT_INDEX currentIndex = (nIdx != SAD_POINT_INDEX::TOP_LEFT) ? (SAD_POINT_INDEX)nIdx : cornerIndex;
       const SAD_POINT_INDEX currentPoint = lastDirectionIndexesArray[currentIndex];
+      const bool isKnown = currentPoint != SAD_POINT_INDEX::NOT_AVAILABLE && m_previousSADsArray[currentPoint] != NotDefinedSAD;
 
-      const MRSADtype cost = (currentPoint != SAD_POINT_INDEX::NOT_AVAILABLE && m_previousSADsArray[currentPoint] != NotDefinedSAD) ?
-        m_previousSADsArray[currentPoint] 
-        : xDirectMCCostDMVR(pRefL0, pRefL1, refStride, cuWidth, cuHeight, cDistParam);
-
-      m_currentSADsArray[currentIndex] = cost;
-      if (nIdx == SAD_POINT_INDEX::LEFT)
+      if (nIdx != SAD_POINT_INDEX::TOP_LEFT)
       {
+        crossMvDL0[nIdx] = cMvDL0;
+        crossMeanL0[nIdx] = cDistParam.meanL0;
+        crossMeanL1[nIdx] = cDistParam.meanL1;
+        if (isKnown)
+        {
+          m_currentSADsArray[currentIndex] = m_previousSADsArray[currentPoint];
+        }
+        else
+        {
+          scoredRefL0[numScored] = pRefL0;
+          scoredRefL1[numScored] = pRefL1;
+          scoredMeanL0[numScored] = cDistParam.meanL0;
+          scoredMeanL1[numScored] = cDistParam.meanL1;
+          scoredIndex[numScored++] = currentIndex;
+        }
+        if (nIdx != SAD_POINT_INDEX::LEFT)
+        {
+          continue;
+        }
+
+        MRSADtype scoredCost[4];
+        xDirectMCCostsDMVR(scoredRefL0, scoredRefL1, refStride, cuWidth, cuHeight, scoredMeanL0, scoredMeanL1, numScored, scoredCost);
+        for (int k = 0; k < numScored; k++)
+        {
+          m_currentSADsArray[scoredIndex[k]] = scoredCost[k];
+        }
+
         int32_t down = -1, right = -1;
         if (m_currentSADsArray[SAD_POINT_INDEX::BOTTOM] < m_currentSADsArray[SAD_POINT_INDEX::TOP])
         {
@@ -4522,7 +4645,24 @@ void InterPrediction::xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift
           cornerIndex += 1;
         }
         m_pSearchOffset[SAD_POINT_INDEX::TOP_LEFT].set(right, down);
+
+        for (SAD_POINT_INDEX crossIdx = SAD_POINT_INDEX::BOTTOM; crossIdx <= SAD_POINT_INDEX::LEFT; ++crossIdx)
+        {
+          if (m_currentSADsArray[crossIdx] < minCost)
+          {
+            minCost = m_currentSADsArray[crossIdx];
+            cBestMvL0 = crossMvDL0[crossIdx];
+            m_lastDirection = crossIdx;
+            bestL0Mean = crossMeanL0[crossIdx];
+            bestL1Mean = crossMeanL1[crossIdx];
+          }
+        }
+        continue;
       }
+
+      const MRSADtype cost = isKnown ? m_previousSADsArray[currentPoint] : xDirectMCCostDMVR(pRefL0, pRefL1, refStride, cuWidth, cuHeight, cDistParam);
+
+      m_currentSADsArray[currentIndex] = cost;
       if (cost < minCost)
       {
         minCost = cost;
@@ -4536,6 +4676,11 @@ void InterPrediction::xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift
   else
   {
     const int32_t refStride = m_HalfPelFilteredBuffL0[0][1].Y().stride;
+    // the means of the four positions are derived first, so that all of them are scored in one pass
+    Mv crossMvDL0[4];
+    const Pel* crossRefL0[4];
+    const Pel* crossRefL1[4];
+    int32_t crossMeanL0[4], crossMeanL1[4];
     for (SAD_POINT_INDEX nIdx = SAD_POINT_INDEX::BOTTOM; nIdx <= SAD_POINT_INDEX::LEFT; ++nIdx)
     {
 #if REMOVE_MV_ADAPT_PREC
@@ -4594,14 +4739,24 @@ void InterPrediction::xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift
       default:
         CHECK(1, "WRONG INDEX");
       }
-      const MRSADtype cost = xDirectMCCostDMVR(pRefL0, pRefL1, refStride, cuWidth, cuHeight, cDistParam);
-      if (cost < minCost)
+      crossMvDL0[nIdx] = cMvDL0;
+      crossRefL0[nIdx] = pRefL0;
+      crossRefL1[nIdx] = pRefL1;
+      crossMeanL0[nIdx] = cDistParam.meanL0;
+      crossMeanL1[nIdx] = cDistParam.meanL1;
+    }
+
+    MRSADtype crossCost[4];
+    xDirectMCCostsDMVR(crossRefL0, crossRefL1, refStride, cuWidth, cuHeight, crossMeanL0, crossMeanL1, 4, crossCost);
+    for (SAD_POINT_INDEX nIdx = SAD_POINT_INDEX::BOTTOM; nIdx <= SAD_POINT_INDEX::LEFT; ++nIdx)
+    {
+      if (crossCost[nIdx] < minCost)
       {
-        minCost = cost;
-        cBestMvL0 = cMvDL0;
+        minCost = crossCost[nIdx];
+        cBestMvL0 = crossMvDL0[nIdx];
         if (refineMv)
         {
-          *refineMv = cMvDL0;
+          *refineMv = crossMvDL0[nIdx];
         }
       }
     }
@@ -152,7 +152,25 @@ protected:
   Pel*                 m_pBIOPadRef;
 #endif
 
-  PelStorage           m_tmpObmcBuf;
+  PelStorage           m_tmpObmcBuf[4];
+
+  struct OBMCCacheEntry
+  {
+    bool               valid;
+    MotionInfo         mi;
+#if JVET_K0248_GBI
+    uint8_t            gbiIdx;
+#endif
+    ComponentID        maxCompID;
+  };
+
+  // predictions of the sub-blocks along the top and left CU boundary from the motion of the neighbouring blocks,
+  // kept while the encoder tests the modes of one CU
+  bool                 m_obmcCacheActive;
+  const Slice*         m_obmcCacheSlice;
+  Area                 m_obmcCacheArea;
+  PelStorage           m_obmcCacheBuf[2];
+  OBMCCacheEntry       m_obmcCache   [2][MAX_CU_SIZE >> MIN_CU_LOG2];
 
 #if !DMVR_JVET_K0217
   Pel*                 m_cYuvPredTempDMVR[MAX_NUM_COMPONENT];
@@ -188,7 +206,8 @@ protected:
 
 #if JVET_K0485_BIO
   void          (*bioGradFilter)(Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* pGradX, Pel* pGradY);
-  static void   gradFilter      (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* pGradX, Pel* pGradY);
+  void          (*bioDotProducts)(const Pel* pSrc0, int src0Stride, const Pel* pSrc1, int src1Stride, const Pel* pGradX0, const Pel* pGradX1, const Pel* pGradY0, const Pel* pGradY1, int gradStride,
+                                  int width, int height, int64_t* pDotProduct1, int64_t* pDotProduct2, int64_t* pDotProduct3, int64_t* pDotProduct5, int64_t* pDotProduct6);
 #else
   void          xGradFilterX    ( const Pel* piRefY, int iRefStride, Pel*  piDstY, int iDstStride, int iWidth, int iHeight, int iMVyFrac, int iMVxFrac, const int bitDepth );
   void          xGradFilterY    ( const Pel* piRefY, int iRefStride, Pel*  piDstY, int iDstStride, int iWidth, int iHeight, int iMVyFrac, int iMVxFrac, const int bitDepth );
@@ -202,8 +221,8 @@ protected:
 
   inline int64_t  divide64        ( int64_t numer, int64_t denom);
 #if JVET_K0485_BIO
-  inline void     calcBlkGradient(int sx, int sy, int64_t *arraysGx2, int64_t *arraysGxGy, int64_t *arraysGxdI, int64_t *arraysGy2, int64_t *arraysGydI,
-                                  int64_t &sGx2,  int64_t &sGy2,      int64_t &sGxGy,      int64_t &sGxdI,      int64_t &sGydI,     int width, int height, int unitSize);
+  void          (*bioCalcBlkGradient)(int sx, int sy, int64_t *arraysGx2, int64_t *arraysGxGy, int64_t *arraysGxdI, int64_t *arraysGy2, int64_t *arraysGydI,
+                                      int64_t &sGx2,  int64_t &sGy2,      int64_t &sGxGy,      int64_t &sGxdI,      int64_t &sGydI,     int width, int height, int unitSize);
 #else
   inline void   calcBlkGradient ( int sx, int sy, int64_t *arraysGx2, int64_t *arraysGxGy, int64_t *arraysGxdI, int64_t *arraysGy2, int64_t *arraysGydI, int64_t &sGx2, int64_t &sGy2, int64_t &sGxGy, int64_t &sGxdI, int64_t &sGydI, int iWidth, int iHeight);
   Pel  optical_flow_averaging   ( int64_t s1, int64_t s2, int64_t s3, int64_t s5, int64_t s6,
@@ -214,6 +233,8 @@ protected:
 #if JVET_K0485_BIO
   bool xCalcBiPredSubBlkDist    (const PredictionUnit &pu, const Pel* pYuvSrc0, const int src0Stride, const Pel* pYuvSrc1, const int src1Stride, const BitDepths &clipBitDepths);
 #endif
+  void          (*licCalcSums)(const Pel* ref, int refStride, const Pel* rec, int recStride, int length, int dimShift, int precShift, int& x, int& y, int& xx, int& xy);
+  void          (*obmcBlend)(Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, int dir, int numLines, bool subtract);
 #endif
 
 #if JEM_TOOLS
@@ -263,6 +284,7 @@ protected:
   void xSubPuMC                 ( PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X );
   void xSubblockOBMC            ( const ComponentID eComp, PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, int iDir, bool bOBMCSimp );
   void xSubtractOBMC            ( PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, int iDir, bool bOBMCSimp );
+  static bool xIsSameOBMCMotion ( const MotionInfo &mi0, const MotionInfo &mi1 );
 #endif
 #if !JEM_TOOLS && JVET_K0346
   void xSubPuMC(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X);
@@ -351,6 +373,7 @@ protected:
 #else
   void xBIPMVRefine(PredictionUnit& pu, uint32_t nSearchStepShift, MRSADtype& minCost, DistParam &cDistParam, Mv *refineMv = nullptr);
   MRSADtype xDirectMCCostDMVR(const Pel* pSrcL0, const Pel* pSrcL1, uint32_t stride, SizeType width, SizeType height, const DistParam &cDistParam);
+  void xDirectMCCostsDMVR(const Pel* const* pSrcL0, const Pel* const* pSrcL1, uint32_t stride, SizeType width, SizeType height, const int32_t* meanL0, const int32_t* meanL1, int numCand, MRSADtype* costs);
   void sumUpSamples(const Pel *pRef, uint32_t  refStride, SizeType cuWidth, SizeType cuHeight, int32_t& Avg);
   void xGenerateFracPixel(PredictionUnit& pu, uint32_t nSearchStepShift, const ClpRngs &clpRngs);
 #endif  
@@ -387,6 +410,7 @@ public:
 #if JEM_TOOLS
   void    subBlockOBMC        (CodingUnit      &cu);
   void    subBlockOBMC        (PredictionUnit  &pu, PelUnitBuf *pDst = nullptr, bool bOBMC4ME = false);
+  void    resetOBMCCache      ();
 
   bool    deriveFRUCMV        (PredictionUnit &pu);
   bool    frucFindBlkMv4Pred  (PredictionUnit& pu, RefPicList eTargetRefPicList, const int nTargetRefIdx, AMVPInfo* pInfo = NULL);
@@ -395,6 +419,23 @@ public:
   void    cacheAssign( CacheModel *cache );
 #endif
 
+#if JEM_TOOLS && JVET_K0485_BIO
+  static void gradFilter     ( Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* pGradX, Pel* pGradY );
+  static void dotProducts    ( const Pel* pSrc0, int src0Stride, const Pel* pSrc1, int src1Stride, const Pel* pGradX0, const Pel* pGradX1, const Pel* pGradY0, const Pel* pGradY1, int gradStride,
+                               int width, int height, int64_t* pDotProduct1, int64_t* pDotProduct2, int64_t* pDotProduct3, int64_t* pDotProduct5, int64_t* pDotProduct6 );
+  static void calcBlkGradient( int sx, int sy, int64_t *arraysGx2, int64_t *arraysGxGy, int64_t *arraysGxdI, int64_t *arraysGy2, int64_t *arraysGydI,
+                               int64_t &sGx2, int64_t &sGy2, int64_t &sGxGy, int64_t &sGxdI, int64_t &sGydI, int width, int height, int unitSize );
+
+#endif
+#if JEM_TOOLS
+  static void calcLICSums    ( const Pel* ref, int refStride, const Pel* rec, int recStride, int length, int dimShift, int precShift, int& x, int& y, int& xx, int& xy );
+  static void blendOBMC      ( Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, int dir, int numLines, bool subtract );
+#endif
+#ifdef TARGET_SIMD_X86
+  void initInterPredictionX86();
+  template <X86_VEXT vext>
+  void _initInterPredictionX86();
+#endif
 };
 
 //! \}
@@ -108,6 +108,24 @@ IntraPrediction::IntraPrediction()
   {
     m_pLumaRecBufferMul[i] = nullptr;
   }
+#endif
+
+  m_predIntraPlanar    = xPredIntraPlanarCore;
+  m_predIntraDc        = xPredIntraDcCore;
+  m_predIntraAngLinear = xPredIntraAngLinearCore;
+#if JEM_TOOLS
+  m_predIntraAng4Tap   = xPredIntraAng4TapCore;
+#endif
+#if JVET_K0063_PDPC_SIMP
+  m_filterPDPC         = xFilterPDPCCore;
+#endif
+  m_filterReferenceRow = xFilterReferenceRowCore;
+  m_transposeBlock     = xTransposeBlockCore;
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
 #endif
 }
 
@@ -320,69 +338,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
   bool pdpcCondition = (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX || uiDirMode == HOR_IDX || uiDirMode == VER_IDX);
   if (pdpcCondition)
   {
-    const CPelBuf srcBuf = CPelBuf(ptrSrc, srcStride, srcStride);
-    PelBuf dstBuf = piPred;
-    const int scale = ((g_aucLog2[iWidth] - 2 + g_aucLog2[iHeight] - 2 + 2) >> 2);
-    CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
-
-    if (uiDirMode == PLANAR_IDX)
-    {
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == DC_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = (wL >> 4) + (wT >> 4);
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == HOR_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wTL = wT;
-          dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == VER_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = wL;
-          dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
+    m_filterPDPC( CPelBuf( ptrSrc, srcStride, srcStride ), piPred, uiDirMode, clpRng );
   }
 #else
 #if HEVC_USE_HOR_VER_PREDFILTERING
@@ -719,6 +675,11 @@ void IntraPrediction::xFilterGroup(Pel* pMulDst[], int i, Pel const * const piSr
 
 //NOTE: Bit-Limit - 24-bit source
 void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst, const SPS& sps )
+{
+  m_predIntraPlanar( pSrc, pDst );
+}
+
+void IntraPrediction::xPredIntraPlanarCore( const CPelBuf &pSrc, PelBuf &pDst )
 {
   const uint32_t width  = pDst.width;
   const uint32_t height = pDst.height;
@@ -778,8 +739,7 @@ void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst, const
 
 void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
 {
-  const Pel dcval = xGetPredValDc( pSrc, pDst );
-  pDst.fill( dcval );
+  m_predIntraDc( pSrc, pDst );
 
 #if HEVC_USE_DC_PREDFILTERING
   if( enableBoundaryFilter )
@@ -789,6 +749,12 @@ void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const Cha
 #endif
 }
 
+void IntraPrediction::xPredIntraDcCore( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const Pel dcval = xGetPredValDc( pSrc, pDst );
+  pDst.fill( dcval );
+}
+
 #if HEVC_USE_DC_PREDFILTERING
 /** Function for filtering intra DC predictor. This function performs filtering left and top edges of the prediction samples for DC mode (intra coding).
  */
@@ -971,39 +937,17 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
 #if JEM_TOOLS
         if( sps.getSpsNext().getUseIntra4Tap() )
         {
-          int         p[4];
           const bool  useCubicFilter = (width <= 8);
           const int  *f              = (useCubicFilter) ? g_intraCubicFilter[deltaFract] : g_intraGaussFilter[deltaFract];
-          int         refMainIndex   = deltaInt + 1;
 
-          for( int x = 0; x < width; x++, refMainIndex++ )
-          {
-            p[1] = refMain[refMainIndex];
-            p[2] = refMain[refMainIndex + 1];
-
-            p[0] = x == 0 ? p[1] : refMain[refMainIndex - 1];
-            p[3] = x == (width - 1) ? p[2] : refMain[refMainIndex + 2];
-
-            pDstBuf[y*dstStride + x] =  (Pel)((f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 128) >> 8);
-
-            if( useCubicFilter ) // only cubic filter has negative coefficients and requires clipping
-            {
-              pDstBuf[y*dstStride + x] = ClipPel( pDstBuf[y*dstStride + x], clpRng );
-            }
-          }
+          // only cubic filter has negative coefficients and requires clipping
+          m_predIntraAng4Tap( pDsty, refMain + deltaInt + 1, width, f, useCubicFilter, clpRng );
         }
         else
 #endif
         {
           // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          int lastRefMainPel = *pRM++;
-          for( int x = 0; x < width; pRM++, x++ )
-          {
-            int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
+          m_predIntraAngLinear( pDsty, refMain + deltaInt + 1, width, deltaFract );
         }
       }
       else
@@ -1084,14 +1028,7 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   // Flip the block if this is the horizontal mode
   if( !bIsModeVer )
   {
-    for( int y = 0; y < height; y++ )
-    {
-      for( int x = 0; x < width; x++ )
-      {
-        pDst.at( y, x ) = pDstBuf[x];
-      }
-      pDstBuf += dstStride;
-    }
+    m_transposeBlock( pDstBuf, dstStride, pDst.buf, pDst.stride, width, height );
   }
 #if JEM_TOOLS && JEM_USE_INTRA_BOUNDARY
 
@@ -1624,14 +1561,136 @@ void IntraPrediction::xFilterReferenceSamples( const Pel* refBufUnfiltered, Pel*
   piDestPtr++;
   piSrcPtr++;
   //top row (left-to-right)
-  for( uint32_t i=1; i < predSize; i++, piDestPtr++, piSrcPtr++ )
-  {
-    *piDestPtr = (piSrcPtr[1] + 2 * piSrcPtr[0] + piSrcPtr[-1] + 2) >> 2;
-  }
+  m_filterReferenceRow( piSrcPtr, piDestPtr, predSize - 1 );
+  piDestPtr += predSize - 1;
+  piSrcPtr  += predSize - 1;
   // top right (not filtered)
   *piDestPtr=*piSrcPtr;
 }
 
+void IntraPrediction::xPredIntraAngLinearCore( Pel* pDst, const Pel* pRef, const int width, const int deltaFract )
+{
+  int lastRefMainPel = *pRef++;
+  for( int x = 0; x < width; pRef++, x++ )
+  {
+    int thisRefMainPel = *pRef;
+    pDst[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+    lastRefMainPel = thisRefMainPel;
+  }
+}
+
+#if JEM_TOOLS
+void IntraPrediction::xPredIntraAng4TapCore( Pel* pDst, const Pel* pRef, const int width, const int* filter, const bool useClip, const ClpRng& clpRng )
+{
+  int p[4];
+
+  for( int x = 0; x < width; x++ )
+  {
+    p[1] = pRef[x];
+    p[2] = pRef[x + 1];
+
+    p[0] = x == 0 ? p[1] : pRef[x - 1];
+    p[3] = x == (width - 1) ? p[2] : pRef[x + 2];
+
+    pDst[x] = (Pel)((filter[0] * p[0] + filter[1] * p[1] + filter[2] * p[2] + filter[3] * p[3] + 128) >> 8);
+
+    if( useClip )
+    {
+      pDst[x] = ClipPel( pDst[x], clpRng );
+    }
+  }
+}
+#endif
+
+#if JVET_K0063_PDPC_SIMP
+void IntraPrediction::xFilterPDPCCore( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const ClpRng& clpRng )
+{
+  const int iWidth  = dstBuf.width;
+  const int iHeight = dstBuf.height;
+  const int scale = ((g_aucLog2[iWidth] - 2 + g_aucLog2[iHeight] - 2 + 2) >> 2);
+  CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
+
+  if (uiDirMode == PLANAR_IDX)
+  {
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == DC_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = (wL >> 4) + (wT >> 4);
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == HOR_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wTL = wT;
+        dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == VER_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = wL;
+        dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+}
+#endif
+
+void IntraPrediction::xFilterReferenceRowCore( const Pel* pSrc, Pel* pDst, const int length )
+{
+  for( int i = 0; i < length; i++ )
+  {
+    pDst[i] = (pSrc[i + 1] + 2 * pSrc[i] + pSrc[i - 1] + 2) >> 2;
+  }
+}
+
+void IntraPrediction::xTransposeBlockCore( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      pDst[x * dstStride + y] = pSrc[x];
+    }
+    pSrc += srcStride;
+  }
+}
+
 bool IntraPrediction::useFilteredIntraRefSamples( const ComponentID &compID, const PredictionUnit &pu, bool modeSpecific, const UnitArea &tuArea )
 {
   const SPS         &sps    = *pu.cs->sps;
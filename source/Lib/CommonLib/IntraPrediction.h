@@ -96,6 +96,20 @@ protected:
   int m_topRefLength;
   int m_leftRefLength;
 #endif
+
+  // sample processing kernels, set to the C++ versions in the constructor and replaced by the SIMD versions
+  void ( *m_predIntraPlanar    )( const CPelBuf &pSrc, PelBuf &pDst );
+  void ( *m_predIntraDc        )( const CPelBuf &pSrc, PelBuf &pDst );
+  void ( *m_predIntraAngLinear )( Pel* pDst, const Pel* pRef, const int width, const int deltaFract );
+#if JEM_TOOLS
+  void ( *m_predIntraAng4Tap   )( Pel* pDst, const Pel* pRef, const int width, const int* filter, const bool useClip, const ClpRng& clpRng );
+#endif
+#if JVET_K0063_PDPC_SIMP
+  void ( *m_filterPDPC         )( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const ClpRng& clpRng );
+#endif
+  void ( *m_filterReferenceRow )( const Pel* pSrc, Pel* pDst, const int length );
+  void ( *m_transposeBlock     )( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height );
+
   // prediction
   void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst,                                                                                                         const SPS& sps );
   void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType,                                                                                          const bool enableBoundaryFilter = true );
@@ -104,7 +118,6 @@ protected:
 #else
   void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const uint32_t dirMode, const ClpRng& clpRng, const SPS& sps, const bool enableBoundaryFilter = true );
 #endif
-  Pel  xGetPredValDc              ( const CPelBuf &pSrc, const Size &dstSize );
 
   void xFillReferenceSamples      ( const CPelBuf &recoBuf,      Pel* refBufUnfiltered, const CompArea &area, const CodingUnit &cu );
   void xFilterReferenceSamples    ( const Pel* refBufUnfiltered, Pel* refBufFiltered, const CompArea &area, const SPS &sps );
@@ -184,6 +197,26 @@ static bool useFilteredIntraRefSamples( const ComponentID &compID, const Predict
   static bool getPlanarMDISCondition( const UnitArea &tuArea ) { return abs(PLANAR_IDX - HOR_IDX) > m_aucIntraFilter[CHANNEL_TYPE_LUMA][((g_aucLog2[tuArea.Y().width] + g_aucLog2[tuArea.Y().height]) >> 1)]; }
 #endif
   static bool useDPCMForFirstPassIntraEstimation(const PredictionUnit &pu, const uint32_t &uiDirMode);
+
+  // C++ versions of the sample processing kernels, the SIMD versions use them for the block sizes they do not cover
+  static Pel  xGetPredValDc           ( const CPelBuf &pSrc, const Size &dstSize );
+  static void xPredIntraPlanarCore    ( const CPelBuf &pSrc, PelBuf &pDst );
+  static void xPredIntraDcCore        ( const CPelBuf &pSrc, PelBuf &pDst );
+  static void xPredIntraAngLinearCore ( Pel* pDst, const Pel* pRef, const int width, const int deltaFract );
+#if JEM_TOOLS
+  static void xPredIntraAng4TapCore   ( Pel* pDst, const Pel* pRef, const int width, const int* filter, const bool useClip, const ClpRng& clpRng );
+#endif
+#if JVET_K0063_PDPC_SIMP
+  static void xFilterPDPCCore         ( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const ClpRng& clpRng );
+#endif
+  static void xFilterReferenceRowCore ( const Pel* pSrc, Pel* pDst, const int length );
+  static void xTransposeBlockCore     ( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height );
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
 };
 
 //! \}
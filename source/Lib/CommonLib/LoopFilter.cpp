@@ -111,7 +111,19 @@ static bool isAvailable( const CodingUnit& cu, const CodingUnit& cu2, const bool
 // ====================================================================================================================
 
 LoopFilter::LoopFilter()
+#if W0038_DB_OPT
+  : m_trialBetaOffsetDiv2( 0 )
+  , m_trialTcOffsetDiv2  ( 0 )
+#endif
 {
+  m_filterLumaEdge   = xFilterLumaEdgeCore;
+  m_filterChromaEdge = xFilterChromaEdgeCore;
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -229,6 +241,25 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
 }
 
+#if W0038_DB_OPT
+/**
+ - deblock recoBuf, a copy of the reconstruction of the picture, as if all slices had the given offsets
+ .
+ the slices and the reconstruction of the picture are left untouched, so several trials can run at the same time
+ with one LoopFilter object each
+ */
+void LoopFilter::loopFilterPicTrial( CodingStructure& cs, PelUnitBuf& recoBuf, const int betaOffsetDiv2, const int tcOffsetDiv2 )
+{
+  m_trialReco           = recoBuf;
+  m_trialBetaOffsetDiv2 = betaOffsetDiv2;
+  m_trialTcOffsetDiv2   = tcOffsetDiv2;
+
+  loopFilterPic( cs );
+
+  m_trialReco.bufs.clear();
+}
+#endif
+
 
 // ====================================================================================================================
 // Protected member functions
@@ -431,7 +462,11 @@ void LoopFilter::xSetLoopfilterParam( const CodingUnit& cu )
   const PPS&   pps   = *cu.cs->pps;
 #endif
 
+#if W0038_DB_OPT
+  if( m_trialReco.bufs.empty() && slice.getDeblockingFilterDisable() )
+#else
   if( slice.getDeblockingFilterDisable() )
+#endif
   {
     m_stLFCUParam.leftEdge = m_stLFCUParam.topEdge = m_stLFCUParam.internalEdge = false;
     return;
@@ -592,7 +627,11 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   const CompArea&  lumaArea = cu.block(COMPONENT_Y);
   const PreCalcValues& pcv = *cu.cs->pcv;
 
+#if W0038_DB_OPT
+  PelBuf        picYuvRec = xGetRecoBuf( cu, lumaArea );
+#else
   PelBuf        picYuvRec = cu.cs->getRecoBuf( lumaArea );
+#endif
   Pel           *piSrc    = picYuvRec.buf;
   const int     iStride   = picYuvRec.stride;
   Pel           *piTmpSrc = piSrc;
@@ -607,13 +646,17 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   unsigned     uiNumParts   = ( pcv.rectCUs ? ( ( edgeDir == EDGE_VER ) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth ) : pcv.partsInCtuWidth >> cu.qtDepth );
   int          pelsInPart   = pcv.minCUWidth;
   unsigned     uiBsAbsIdx   = 0, uiBs = 0;
-  int          iOffset, iSrcStep;
 
   bool  bPCMFilter      = (sps.getUsePCM() && sps.getPCMFilterDisableFlag()) ? true : false;
   bool  bPartPNoFilter  = false;
   bool  bPartQNoFilter  = false;
+#if W0038_DB_OPT
+  int   betaOffsetDiv2  = m_trialReco.bufs.empty() ? slice.getDeblockingFilterBetaOffsetDiv2() : m_trialBetaOffsetDiv2;
+  int   tcOffsetDiv2    = m_trialReco.bufs.empty() ? slice.getDeblockingFilterTcOffsetDiv2()   : m_trialTcOffsetDiv2;
+#else
   int   betaOffsetDiv2  = slice.getDeblockingFilterBetaOffsetDiv2();
   int   tcOffsetDiv2    = slice.getDeblockingFilterTcOffsetDiv2();
+#endif
   int   xoffset, yoffset;
 
   Position pos;
@@ -622,8 +665,6 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   {
     xoffset   = 0;
     yoffset   = pelsInPart;
-    iOffset   = 1;
-    iSrcStep  = iStride;
     piTmpSrc += iEdge * pelsInPart;
     pos       = Position{ lumaArea.x + iEdge * pelsInPart, lumaArea.y - yoffset };
   }
@@ -631,13 +672,14 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
   {
     xoffset   = pelsInPart;
     yoffset   = 0;
-    iOffset   = iStride;
-    iSrcStep  = 1;
     piTmpSrc += iEdge*pelsInPart*iStride;
     pos       = Position{ lumaArea.x - xoffset, lumaArea.y + iEdge * pelsInPart };
   }
 
   const int iBitdepthScale = 1 << (bitDepthLuma - 8);
+  const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
+
+  DeblockSegment segments[MAX_CU_SIZE / 4];
 
   // dec pos since within the loop we first calc the pos
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
@@ -648,6 +690,8 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     uiBs       = m_aapucBS[edgeDir][uiBsAbsIdx];
 
+    DeblockSegment segment = { 0, 0, false, false };
+
     if( uiBs )
     {
       const CodingUnit& cuQ =  cu;
@@ -675,53 +719,88 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
       const int iIndexTC  = Clip3(0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, int(iQP + DEFAULT_INTRA_TC_OFFSET*(uiBs - 1) + (tcOffsetDiv2 << 1)));
       const int iIndexB   = Clip3(0, MAX_QP, iQP + (betaOffsetDiv2 << 1));
 
-      const int iTc       = sm_tcTable  [iIndexTC] * iBitdepthScale;
-      const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
+      segment.tc          = sm_tcTable  [iIndexTC] * iBitdepthScale;
+      segment.beta        = sm_betaTable[iIndexB ] * iBitdepthScale;
 
-      const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
-
-      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      bPartPNoFilter = bPartQNoFilter = false;
+      if( bPCMFilter )
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
-
-        const int dp = dp0 + dp3;
-        const int dq = dq0 + dq3;
-        const int d  = d0  + d3;
-
-        bPartPNoFilter = bPartQNoFilter = false;
-        if( bPCMFilter )
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = cuP.ipcm;
-          bPartQNoFilter = cuQ.ipcm;
-        }
-        if( ppsTransquantBypassEnabledFlag )
-        {
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
-          bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
-        }
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = cuP.ipcm;
+        bPartQNoFilter = cuQ.ipcm;
+      }
+      if( ppsTransquantBypassEnabledFlag )
+      {
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
+        bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
+      }
 
-        if( d < iBeta )
-        {
-          const bool bFilterP = (dp < iSideThreshold);
-          const bool bFilterQ = (dq < iSideThreshold);
+      segment.partPNoFilter = bPartPNoFilter;
+      segment.partQNoFilter = bPartQNoFilter;
+    }
 
-          const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 0 ), iOffset, 2 * d0, iBeta, iTc )
-                       && xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 3 ), iOffset, 2 * d3, iBeta, iTc );
+    for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+    {
+      segments[iIdx * uiBlocksInPart + iBlkIdx] = segment;
+    }
+  }
 
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
-        }
+  m_filterLumaEdge( piTmpSrc, iStride, edgeDir, uiNumParts * uiBlocksInPart, segments, clpRng );
+}
+
+/**
+ - Deblocking of the luma samples across an edge, the edge is split into segments of four lines with their own parameters
+ .
+ \param piSrc           pointer to the first sample of the Q side of the edge
+ \param iStride         stride of the picture data
+ \param edgeDir         direction of the edge
+ \param numSegments     number of consecutive segments along the edge
+ \param segments        filter parameters of the segments
+ \param clpRng          clipping range of the samples
+*/
+void LoopFilter::xFilterLumaEdgeCore( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const DeblockSegment* segments, const ClpRng& clpRng )
+{
+  const int iOffset  = edgeDir == EDGE_VER ? 1 : iStride;
+  const int iSrcStep = edgeDir == EDGE_VER ? iStride : 1;
+
+  for( int iSeg = 0; iSeg < numSegments; iSeg++ )
+  {
+    const DeblockSegment& segment = segments[iSeg];
+
+    // a zero tc leaves all samples unchanged
+    if( segment.tc == 0 )
+    {
+      continue;
+    }
+
+    Pel* piTmpSrc = piSrc + iSrcStep * iSeg * ( DEBLOCK_SMALLEST_BLOCK / 2 );
+
+    const int iSideThreshold = ( segment.beta + ( segment.beta >> 1 ) ) >> 3;
+    const int iThrCut   = segment.tc * 10;
+
+    const int dp0 = xCalcDP( piTmpSrc + iSrcStep * 0, iOffset );
+    const int dq0 = xCalcDQ( piTmpSrc + iSrcStep * 0, iOffset );
+    const int dp3 = xCalcDP( piTmpSrc + iSrcStep * 3, iOffset );
+    const int dq3 = xCalcDQ( piTmpSrc + iSrcStep * 3, iOffset );
+    const int d0 = dp0 + dq0;
+    const int d3 = dp3 + dq3;
+
+    const int dp = dp0 + dp3;
+    const int dq = dq0 + dq3;
+    const int d  = d0  + d3;
+
+    if( d < segment.beta )
+    {
+      const bool bFilterP = (dp < iSideThreshold);
+      const bool bFilterQ = (dq < iSideThreshold);
+
+      const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * 0, iOffset, 2 * d0, segment.beta, segment.tc )
+                   && xUseStrongFiltering( piTmpSrc + iSrcStep * 3, iOffset, 2 * d3, segment.beta, segment.tc );
+
+      for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+      {
+        xPelFilterLuma( piTmpSrc + iSrcStep * i, iOffset, segment.tc, sw, segment.partPNoFilter, segment.partQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
       }
     }
   }
@@ -736,8 +815,13 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   const PreCalcValues& pcv = *cu.cs->pcv;
   unsigned  rasterIdx      = getRasterIdx( lumaPos, pcv );
 
+#if W0038_DB_OPT
+  PelBuf     picYuvRecCb   = xGetRecoBuf( cu, cu.block(COMPONENT_Cb) );
+  PelBuf     picYuvRecCr   = xGetRecoBuf( cu, cu.block(COMPONENT_Cr) );
+#else
   PelBuf     picYuvRecCb   = cu.cs->getRecoBuf( cu.block(COMPONENT_Cb) );
   PelBuf     picYuvRecCr   = cu.cs->getRecoBuf( cu.block(COMPONENT_Cr) );
+#endif
   Pel       *piSrcCb       = picYuvRecCb.buf;
   Pel       *piSrcCr       = picYuvRecCr.buf;
   const int  iStride       = picYuvRecCb.stride;
@@ -748,13 +832,16 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   const unsigned uiPelsInPartChromaH = pcv.minCUWidth  >> ::getComponentScaleX(COMPONENT_Cb, nChromaFormat);
   const unsigned uiPelsInPartChromaV = pcv.minCUHeight >> ::getComponentScaleY(COMPONENT_Cb, nChromaFormat);
 
-  int       iOffset, iSrcStep;
   unsigned  uiLoopLength;
 
   bool      bPCMFilter      = (sps.getUsePCM() && sps.getPCMFilterDisableFlag()) ? true : false;
   bool      bPartPNoFilter  = false;
   bool      bPartQNoFilter  = false;
+#if W0038_DB_OPT
+  const int tcOffsetDiv2    = m_trialReco.bufs.empty() ? slice.getDeblockingFilterTcOffsetDiv2() : m_trialTcOffsetDiv2;
+#else
   const int tcOffsetDiv2    = slice.getDeblockingFilterTcOffsetDiv2();
+#endif
 
   // Vertical Position
   unsigned uiEdgeNumInCtuVert = rasterIdx % pcv.partsInCtuWidth + iEdge;
@@ -784,8 +871,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = 0;
     yoffset      = uiNumPelsLuma;
-    iOffset      = 1;
-    iSrcStep     = iStride;
     piTmpSrcCb  += iEdge*uiPelsInPartChromaH;
     piTmpSrcCr  += iEdge*uiPelsInPartChromaH;
     uiLoopLength = uiPelsInPartChromaV;
@@ -795,8 +880,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = uiNumPelsLuma;
     yoffset      = 0;
-    iOffset      = iStride;
-    iSrcStep     = 1;
     piTmpSrcCb  += iEdge*iStride*uiPelsInPartChromaV;
     piTmpSrcCr  += iEdge*iStride*uiPelsInPartChromaV;
     uiLoopLength = uiPelsInPartChromaH;
@@ -805,6 +888,8 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
   const int iBitdepthScale = 1 << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 8);
 
+  DeblockSegment segments[2][MAX_CU_SIZE / 2];
+
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     pos.x += xoffset;
@@ -813,6 +898,8 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     ucBs       = m_aapucBS[edgeDir][uiBsAbsIdx];
 
+    segments[0][iIdx] = segments[1][iIdx] = { 0, 0, false, false };
+
     if (ucBs > 1)
     {
       const CodingUnit& cuQ =  cu;
@@ -851,9 +938,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
       for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
       {
-        const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
         const int chromaQPOffset = pps.getQpOffset( ComponentID( chromaIdx + 1 ) );
-        Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
         int iQP = ( ( cuP.qp + cuQ.qp + 1 ) >> 1 ) + chromaQPOffset;
         if (iQP >= chromaQPMappingTableSize)
@@ -875,13 +960,51 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
         const int iIndexTC = Clip3<int>( 0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*( ucBs - 1 ) + ( tcOffsetDiv2 << 1 ) );
         const int iTc      = sm_tcTable[iIndexTC] * iBitdepthScale;
 
-        for( unsigned uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*( uiStep + iIdx*uiLoopLength ), iOffset, iTc, bPartPNoFilter, bPartQNoFilter, clpRng );
-        }
+        segments[chromaIdx][iIdx] = { iTc, 0, bPartPNoFilter, bPartQNoFilter };
       }
     }
   }
+
+  for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+  {
+    const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
+    Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
+
+    m_filterChromaEdge( piTmpSrcChroma, iStride, edgeDir, uiNumParts, uiLoopLength, segments[chromaIdx], clpRng );
+  }
+}
+
+/**
+ - Deblocking of the chroma samples across an edge, the edge is split into segments of segmentLength lines with their own parameters
+ .
+ \param piSrc           pointer to the first sample of the Q side of the edge
+ \param iStride         stride of the picture data
+ \param edgeDir         direction of the edge
+ \param numSegments     number of consecutive segments along the edge
+ \param segmentLength   number of lines of a segment
+ \param segments        filter parameters of the segments
+ \param clpRng          clipping range of the samples
+*/
+void LoopFilter::xFilterChromaEdgeCore( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const int segmentLength, const DeblockSegment* segments, const ClpRng& clpRng )
+{
+  const int iOffset  = edgeDir == EDGE_VER ? 1 : iStride;
+  const int iSrcStep = edgeDir == EDGE_VER ? iStride : 1;
+
+  for( int iSeg = 0; iSeg < numSegments; iSeg++ )
+  {
+    const DeblockSegment& segment = segments[iSeg];
+
+    // a zero tc leaves all samples unchanged
+    if( segment.tc == 0 )
+    {
+      continue;
+    }
+
+    for( int uiStep = 0; uiStep < segmentLength; uiStep++ )
+    {
+      xPelFilterChroma( piSrc + iSrcStep*( uiStep + iSeg*segmentLength ), iOffset, segment.tc, segment.partPNoFilter, segment.partQNoFilter, clpRng );
+    }
+  }
 }
 
 
@@ -900,7 +1023,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng )
 {
   int delta;
 
@@ -972,7 +1095,7 @@ inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
 {
   int delta;
 
@@ -1004,7 +1127,7 @@ inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const i
  \param tc              tc value
  \param piSrc           pointer to picture data
  */
-inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const
+inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc )
 {
   const Pel m4 = piSrc[ 0          ];
   const Pel m3 = piSrc[-iOffset    ];
@@ -1016,12 +1139,12 @@ inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, cons
   return ( ( d_strong < ( beta >> 3 ) ) && ( d < ( beta >> 2 ) ) && ( abs( m3 - m4 ) < ( ( tc * 5 + 1 ) >> 1 ) ) );
 }
 
-inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[-iOffset * 3] - 2 * piSrc[-iOffset * 2] + piSrc[-iOffset] );
 }
 
-inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[0] - 2 * piSrc[iOffset] + piSrc[iOffset * 2] );
 }
@@ -47,6 +47,15 @@
 
 #define DEBLOCK_SMALLEST_BLOCK  8
 
+/// filter parameters of a segment of consecutive lines across an edge, a zero tc leaves the segment unfiltered
+struct DeblockSegment
+{
+  int  tc;
+  int  beta;
+  bool partPNoFilter;
+  bool partQNoFilter;
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -58,6 +67,15 @@ private:
   static_vector<char, MAX_NUM_PARTS_IN_CTU> m_aapucBS       [NUM_EDGE_DIR];         ///< Bs for [Ver/Hor][Y/U/V][Blk_Idx]
   static_vector<bool, MAX_NUM_PARTS_IN_CTU> m_aapbEdgeFilter[NUM_EDGE_DIR];
   LFCUParam m_stLFCUParam;                   ///< status structure
+#if W0038_DB_OPT
+  PelUnitBuf m_trialReco;                    ///< target of a trial deblocking, the reconstruction of the picture if empty
+  int        m_trialBetaOffsetDiv2;
+  int        m_trialTcOffsetDiv2;
+#endif
+
+  // edge filtering kernels, set to the C++ versions in the constructor and replaced by the SIMD versions
+  void ( *m_filterLumaEdge   )( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments,                          const DeblockSegment* segments, const ClpRng& clpRng );
+  void ( *m_filterChromaEdge )( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const int segmentLength, const DeblockSegment* segments, const ClpRng& clpRng );
 
 private:
   /// CU-level deblocking function
@@ -83,15 +101,18 @@ private:
                                           bool           bValue );
 #endif
 
+#if W0038_DB_OPT
+  PelBuf xGetRecoBuf              ( const CodingUnit& cu, const CompArea& blk ) { return m_trialReco.bufs.empty() ? cu.cs->getRecoBuf( blk ) : m_trialReco.get( blk.compID ).subBuf( blk.pos(), blk.size() ); }
+#endif
   void xEdgeFilterLuma            ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma          ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
 
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng ) const;
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng );
+  static inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng );
 
-  inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const;
-  inline int xCalcDP              ( Pel* piSrc, const int iOffset ) const;
-  inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
+  static inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc );
+  static inline int xCalcDP              ( Pel* piSrc, const int iOffset );
+  static inline int xCalcDQ              ( Pel* piSrc, const int iOffset );
 #if JVET_K0251_QP_EXT
   static const uint8_t sm_tcTable[MAX_QP + 3];
   static const uint8_t sm_betaTable[MAX_QP + 1];
@@ -111,12 +132,26 @@ public:
   /// picture-level deblocking filter
   void loopFilterPic              ( CodingStructure& cs
                                     );
+#if W0038_DB_OPT
+  /// deblocking of a copy of the picture reconstruction with the given offsets in all slices (encoder parameter selection)
+  void loopFilterPicTrial         ( CodingStructure& cs, PelUnitBuf& recoBuf, const int betaOffsetDiv2, const int tcOffsetDiv2 );
+#endif
 
   static int getBeta              ( const int qp )
   {
     const int indexB = Clip3( 0, MAX_QP, qp );
     return sm_betaTable[ indexB ];
   }
+
+  // C++ versions of the edge filtering kernels, the SIMD versions use them for the bit depths they do not cover
+  static void xFilterLumaEdgeCore   ( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments,                          const DeblockSegment* segments, const ClpRng& clpRng );
+  static void xFilterChromaEdgeCore ( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const int segmentLength, const DeblockSegment* segments, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
 };
 
 //! \}
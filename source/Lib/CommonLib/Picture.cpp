@@ -133,8 +133,9 @@ int g_wppThreadId( 0 );
 int g_splitThreadId( 0 );
 #pragma omp threadprivate(g_splitThreadId)
 
-int g_splitJobId( 0 );
-#pragma omp threadprivate(g_splitJobId)
+// path of the current job in the tree of nested split jobs, 0 is the master and the children of path p are p * PARL_SPLIT_MAX_NUM_JOBS + jobId
+unsigned g_splitJobPath( 0 );
+#pragma omp threadprivate(g_splitJobPath)
 #endif
 
 Scheduler::Scheduler() :
@@ -146,7 +147,8 @@ Scheduler::Scheduler() :
   ,
 #endif
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads( 1 )
+  m_numSplitThreads( 1 ),
+  m_numSplitJobSlots( 1 )
 #endif
 {
 }
@@ -167,9 +169,7 @@ unsigned Scheduler::getSplitDataId( int jobId ) const
 {
   if( m_numSplitThreads > 1 && m_hasParallelBuffer )
   {
-    int splitJobId = jobId == CURR_THREAD_ID ? g_splitJobId : jobId;
-
-    return ( g_wppThreadId * NUM_RESERVERD_SPLIT_JOBS ) + splitJobId;
+    return ( g_wppThreadId * m_numSplitJobSlots ) + getSplitJobPath( jobId );
   }
   else
   {
@@ -193,9 +193,9 @@ unsigned Scheduler::getSplitPicId( int tId /*= CURR_THREAD_ID */ ) const
 
 unsigned Scheduler::getSplitJobId() const
 {
-  if( m_numSplitThreads > 1 )
+  if( m_numSplitThreads > 1 && g_splitJobPath > 0 )
   {
-    return g_splitJobId;
+    return ( g_splitJobPath - 1 ) % PARL_SPLIT_MAX_NUM_JOBS + 1;
   }
   else
   {
@@ -203,10 +203,49 @@ unsigned Scheduler::getSplitJobId() const
   }
 }
 
-void Scheduler::setSplitJobId( const int jobId )
+unsigned Scheduler::getSplitJobPath( int jobId /*= CURR_THREAD_ID */ ) const
+{
+  if( jobId == CURR_THREAD_ID )
+  {
+    return g_splitJobPath;
+  }
+  else
+  {
+    return g_splitJobPath * PARL_SPLIT_MAX_NUM_JOBS + jobId;
+  }
+}
+
+void Scheduler::setSplitJobPath( const unsigned jobPath )
+{
+  CHECK( jobPath >= m_numSplitJobSlots, "The split job path " << jobPath << " exceeds the allocated job data!" );
+  g_splitJobPath = jobPath;
+}
+
+unsigned Scheduler::getSplitLevel() const
+{
+  unsigned level = 0;
+
+  for( unsigned jobPath = g_splitJobPath; jobPath > 0; jobPath = ( jobPath - 1 ) / PARL_SPLIT_MAX_NUM_JOBS )
+  {
+    level++;
+  }
+
+  return level;
+}
+
+int Scheduler::getNumSplitJobSlots( const int numSplitLevels )
 {
-  CHECK( g_splitJobId != 0 && jobId != 0, "Need to reset the jobId after usage!" );
-  g_splitJobId = jobId;
+  // the master and all jobs of every nesting level
+  int numSlots   = 1;
+  int numLvlJobs = 1;
+
+  for( int level = 0; level < numSplitLevels; level++ )
+  {
+    numLvlJobs *= PARL_SPLIT_MAX_NUM_JOBS;
+    numSlots   += numLvlJobs;
+  }
+
+  return numSlots;
 }
 
 void Scheduler::startParallel()
@@ -235,7 +274,7 @@ unsigned Scheduler::getWppDataId( int lID ) const
 #if ENABLE_SPLIT_PARALLELISM
   if( m_numSplitThreads > 1 )
   {
-    return tId * NUM_RESERVERD_SPLIT_JOBS;
+    return tId * m_numSplitJobSlots;
   }
   else
   {
@@ -276,10 +315,11 @@ unsigned Scheduler::getDataId() const
   return 0;
 }
 
-bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads )
+bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads, const int numSplitLevels )
 {
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads = numSplitThreads;
+  m_numSplitThreads  = numSplitThreads;
+  m_numSplitJobSlots = numSplitThreads > 1 ? getNumSplitJobSlots( numSplitLevels ) : 1;
 #endif
 #if ENABLE_WPP_PARALLELISM
   m_firstNonFinishedLine    = 0;
@@ -897,7 +937,11 @@ void Picture::finalInit( const SPS& sps, const PPS& pps )
   }
   else
   {
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+    cs = new CodingStructure( unitCache.cuCache, unitCache.puCache, unitCache.tuCache );
+#else
     cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+#endif
     cs->sps = &sps;
     cs->create( chromaFormatIDC, Area( 0, 0, iWidth, iHeight ), true );
   }
@@ -976,6 +1020,30 @@ void Picture::finishParallelPart( const UnitArea& area )
   }
 }
 
+void Picture::initParallelPart( const UnitArea& area, const int srcPicId )
+{
+  const PreCalcValues& pcv     = *cs->pcv;
+  const int            destID  = scheduler.getSplitPicId();
+  const Position       lumaPos = area.Y().valid() ? area.lumaPos() : area.Cb().lumaPos();
+  const Position       ctuPos( lumaPos.x & ~pcv.maxCUWidthMask, lumaPos.y & ~pcv.maxCUHeightMask );
+
+  // a nested job sees the parts of the CTU coded so far by its parent job: the rows above the area and the columns left of it
+  const Area codedAreas[2] =
+  {
+    Area( ctuPos.x, ctuPos.y,  pcv.maxCUWidth,         lumaPos.y - ctuPos.y ),
+    Area( ctuPos.x, lumaPos.y, lumaPos.x - ctuPos.x, ctuPos.y + pcv.maxCUHeight - lumaPos.y ),
+  };
+
+  for( const Area& codedArea : codedAreas )
+  {
+    if( codedArea.width == 0 || codedArea.height == 0 ) continue;
+
+    const UnitArea clipdArea = clipArea( UnitArea( chromaFormat, codedArea ), *this );
+
+    M_BUFS( destID, PIC_RECONSTRUCTION ).subBuf( clipdArea ).copyFrom( M_BUFS( srcPicId, PIC_RECONSTRUCTION ).subBuf( clipdArea ) );
+  }
+}
+
 #if ENABLE_WPP_PARALLELISM
 void Picture::finishCtuPart( const UnitArea& ctuArea )
 {
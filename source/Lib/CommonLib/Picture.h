@@ -67,11 +67,14 @@ public:
   unsigned getSplitDataId( int jobId = CURR_THREAD_ID ) const;
   unsigned getSplitPicId ( int tId   = CURR_THREAD_ID ) const;
   unsigned getSplitJobId () const;
-  void     setSplitJobId ( const int jobId );
+  unsigned getSplitJobPath( int jobId = CURR_THREAD_ID ) const;
+  void     setSplitJobPath( const unsigned jobPath );
+  unsigned getSplitLevel () const;
   void     startParallel ();
   void     finishParallel();
   void     setSplitThreadId( const int tId = CURR_THREAD_ID );
   unsigned getNumSplitThreads() const { return m_numSplitThreads; };
+  static int getNumSplitJobSlots( const int numSplitLevels );
 #endif
 #if ENABLE_WPP_PARALLELISM
   unsigned getWppDataId  ( int lId = CURR_THREAD_ID ) const;
@@ -79,7 +82,7 @@ public:
   void     setWppThreadId( const int tId = CURR_THREAD_ID );
 #endif
   unsigned getDataId     () const;
-  bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads );
+  bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads, const int numSplitLevels = 1 );
   int  getNumPicInstances() const;
 #if ENABLE_WPP_PARALLELISM
   void setReady          ( const int ctuPosX, const int ctuPosY );
@@ -104,6 +107,7 @@ private:
 #if ENABLE_SPLIT_PARALLELISM
 
   int   m_numSplitThreads;
+  int   m_numSplitJobSlots;
   bool  m_hasParallelBuffer;
 #endif
 };
@@ -263,6 +267,9 @@ public:
   PelStorage m_bufs[NUM_PIC_TYPES];
 #endif
 
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  XUCache            unitCache;   // the units of cs are not taken from the global cache, as pictures are compressed concurrently
+#endif
   CodingStructure*   cs;
   std::deque<Slice*> slices;
   SEIMessages        SEIs;
@@ -284,6 +291,7 @@ private:
 #if ENABLE_SPLIT_PARALLELISM
 public:
   void finishParallelPart   ( const UnitArea& ctuArea );
+  void initParallelPart     ( const UnitArea& area, const int srcPicId );
 #if ENABLE_WPP_PARALLELISM
   void finishCtuPart        ( const UnitArea& ctuArea );
 #endif
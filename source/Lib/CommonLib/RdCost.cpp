@@ -49,6 +49,10 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+uint64_t ( *RdCost::m_fpSSEPlane )( const CPelBuf&, const CPelBuf& ) = RdCost::xGetSSEPlane;
+#if DMVR_JVET_K0217
+void ( *RdCost::m_fpDMVRCosts )( const Pel* const*, const Pel* const*, int, int, int, const int*, int, Distortion* ) = RdCost::xGetDMVRCosts;
+#endif
 
 RdCost::RdCost()
 {
@@ -172,6 +176,11 @@ void RdCost::init()
   m_afpDistortFunc[DF_SSE16N_WTD] = RdCost::xGetSSE16N_WTD;
 #endif
 
+  m_fpSSEPlane = RdCost::xGetSSEPlane;
+#if DMVR_JVET_K0217
+  m_fpDMVRCosts = RdCost::xGetDMVRCosts;
+#endif
+
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
@@ -1824,6 +1833,29 @@ Distortion RdCost::xGetMRSAD48( const DistParam &rcDtParam )
 #endif
 }
 
+#if DMVR_JVET_K0217
+void RdCost::xGetDMVRCosts( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs )
+{
+  for( int c = 0; c < numCand; c++ )
+  {
+    const Pel* pSrc0 = srcL0[c];
+    const Pel* pSrc1 = srcL1[c];
+    const int  delta = deltas[c];
+    Distortion uiSum = 0;
+    for( int iY = 0; iY < height; iY++ )
+    {
+      for( int iX = 0; iX < width; iX++ )
+      {
+        uiSum += abs( pSrc0[iX] - pSrc1[iX] - delta );
+      }
+      pSrc0 += stride;
+      pSrc1 += stride;
+    }
+    costs[c] = uiSum;
+  }
+}
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // SSE
 // --------------------------------------------------------------------------------------------------------------------
@@ -1865,6 +1897,26 @@ Distortion RdCost::xGetSSE( const DistParam &rcDtParam )
   return ( uiSum );
 }
 
+uint64_t RdCost::xGetSSEPlane( const CPelBuf& org, const CPelBuf& cur )
+{
+  const Pel* piOrg = org.buf;
+  const Pel* piCur = cur.buf;
+  uint64_t   uiSum = 0;
+
+  for( int y = 0; y < org.height; y++ )
+  {
+    for( int x = 0; x < org.width; x++ )
+    {
+      const Intermediate_Int iTemp = piOrg[x] - piCur[x];
+      uiSum += uint64_t( iTemp * iTemp );
+    }
+    piOrg += org.stride;
+    piCur += cur.stride;
+  }
+
+  return uiSum;
+}
+
 Distortion RdCost::xGetSSE4( const DistParam &rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -118,6 +118,10 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static uint64_t       ( *m_fpSSEPlane )( const CPelBuf& org, const CPelBuf& cur );
+#if DMVR_JVET_K0217
+  static void           ( *m_fpDMVRCosts )( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs );
+#endif
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -327,6 +331,12 @@ public:
 #else
   Distortion     getCostOfVectorWithPredictor( const int x, const int y )  { return Distortion( m_motionLambda * getBitsOfVectorWithPredictor(x, y )); }
   uint32_t           getBitsOfVectorWithPredictor( const int x, const int y )  { return xGetExpGolombNumberOfBits(((x << m_iCostScale) - m_mvPredictor.getHor())) + xGetExpGolombNumberOfBits(((y << m_iCostScale) - m_mvPredictor.getVer())); }
+#endif
+  // SSE of two whole planes without any precision adjustment, accumulated in 64 bit (PSNR computation)
+  static uint64_t getSSEPlane               ( const CPelBuf& org, const CPelBuf& cur ) { return m_fpSSEPlane( org, cur ); }
+#if DMVR_JVET_K0217
+  // mean-removed SADs of numCand block pairs of the bilateral matching, costs[c] = sum |srcL0[c] - srcL1[c] - deltas[c]|
+  static void     getDMVRCosts              ( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs ) { m_fpDMVRCosts( srcL0, srcL1, stride, width, height, deltas, numCand, costs ); }
 #endif
 #if WCG_EXT
          void    saveUnadjustedLambda       ();
@@ -334,7 +344,7 @@ public:
   inline double  getWPSNRLumaLevelWeight    (int val) { return m_lumaLevelToWeightPLUT[val]; }
 #endif
 
-private:
+protected:
 
   static Distortion xGetSSE           ( const DistParam& pcDtParam );
   static Distortion xGetSSE4          ( const DistParam& pcDtParam );
@@ -344,6 +354,8 @@ private:
   static Distortion xGetSSE64         ( const DistParam& pcDtParam );
   static Distortion xGetSSE16N        ( const DistParam& pcDtParam );
 
+  static uint64_t   xGetSSEPlane      ( const CPelBuf& org, const CPelBuf& cur );
+
 #if WCG_EXT
   static Distortion getWeightedMSE    (int compIdx, const Pel org, const Pel cur, const uint32_t uiShift, const Pel orgLuma);
   static Distortion xGetSSE_WTD       ( const DistParam& pcDtParam );
@@ -381,6 +393,9 @@ private:
   static Distortion xGetMRSAD24       ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD48       ( const DistParam& pcDtParam );
   static Distortion xGetMRHADs        ( const DistParam& pcDtParam );
+#if DMVR_JVET_K0217
+  static void       xGetDMVRCosts     ( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs );
+#endif
 
   static Distortion xGetHADs          ( const DistParam& pcDtParam );
   static Distortion xCalcHADs2x2      ( const Pel *piOrg, const Pel *piCurr, int iStrideOrg, int iStrideCur, int iStep );
@@ -397,6 +412,8 @@ private:
   static Distortion xGetSSE_SIMD    ( const DistParam& pcDtParam );
   template< typename Torg, typename Tcur, int iWidth, X86_VEXT vext >
   static Distortion xGetSSE_NxN_SIMD( const DistParam& pcDtParam );
+  template< X86_VEXT vext >
+  static uint64_t   xGetSSEPlane_SIMD( const CPelBuf& org, const CPelBuf& cur );
 
   template< X86_VEXT vext >
   static Distortion xGetSAD_SIMD    ( const DistParam& pcDtParam );
@@ -405,6 +422,13 @@ private:
 
   template< typename Torg, typename Tcur, X86_VEXT vext >
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
+
+  template< X86_VEXT vext >
+  static Distortion xGetMRSAD_SIMD  ( const DistParam& pcDtParam );
+#if DMVR_JVET_K0217
+  template< X86_VEXT vext >
+  static void       xGetDMVRCosts_SIMD( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs );
+#endif
 #endif
 
 public:
@@ -112,15 +112,21 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
+  m_calcEOStats = calcEOStats;
+  m_offsetEO    = offsetEO;
+  m_offsetBO    = offsetBO;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
-
-  m_signLineBuf1.clear();
-  m_signLineBuf2.clear();
 }
 
 void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift )
@@ -144,6 +150,22 @@ void SampleAdaptiveOffset::destroy()
   m_tempBuf.destroy();
 }
 
+void SampleAdaptiveOffset::calcEOStats( const Pel* srcLine, const int srcStride, const Pel* orgLine, const int orgStride, const int width, const int height, const int offsetA, const int offsetB, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+
+      diff [edgeType] += ( orgLine[x] - srcLine[x] );
+      count[edgeType] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets)
 {
   int codedOffset[MAX_NUM_SAO_CLASSES];
@@ -289,215 +311,110 @@ void SampleAdaptiveOffset::xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkP
 }
 
 
+void SampleAdaptiveOffset::offsetEO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int offsetA, const int offsetB, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::offsetBO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
                                           , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
                                           , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail)
 {
-  int x,y, startX, startY, endX, endY, edgeType;
+  int startX, startY, endX, endY;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  int8_t signLeft, signRight, signDown;
 
   const Pel* srcLine = srcBlk;
         Pel* resLine = resBlk;
 
+  // the edge offsets are indexed by the edge class -2..2, the rows and columns next to an unavailable neighbour are skipped
   switch(typeIdx)
   {
   case SAO_TYPE_EO_0:
     {
-      offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
-      for (y=0; y< height; y++)
-      {
-        signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
 
+      m_offsetEO( srcLine + startX, srcStride, resLine + startX, resStride, endX - startX, height, -1, 1, offset + 2, clpRng );
     }
     break;
   case SAO_TYPE_EO_90:
     {
-      offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[0];
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      const Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      const Pel* srcLineBelow;
-      for (y=startY; y<endY; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
 
+      m_offsetEO( srcLine + startY * srcStride, srcStride, resLine + startY * resStride, resStride, width, endY - startY, -srcStride, srcStride, offset + 2, clpRng );
     }
     break;
   case SAO_TYPE_EO_135:
     {
-      offset += 2;
-      int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
-
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
       //1st line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
+      m_offsetEO( srcLine + firstLineStartX, srcStride, resLine + firstLineStartX, resStride, firstLineEndX - firstLineStartX, 1, -srcStride - 1, srcStride + 1, offset + 2, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      m_offsetEO( srcLine + srcStride + startX, srcStride, resLine + resStride + startX, resStride, endX - startX, height - 2, -srcStride - 1, srcStride + 1, offset + 2, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
+      srcLine += ( height - 1 ) * srcStride;
+      resLine += ( height - 1 ) * resStride;
       lastLineStartX = isBelowAvail ? startX : (width -1);
       lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      m_offsetEO( srcLine + lastLineStartX, srcStride, resLine + lastLineStartX, resStride, lastLineEndX - lastLineStartX, 1, -srcStride - 1, srcStride + 1, offset + 2, clpRng );
     }
     break;
   case SAO_TYPE_EO_45:
     {
-      offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[1];
-
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
       //first line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
+      m_offsetEO( srcLine + firstLineStartX, srcStride, resLine + firstLineStartX, resStride, firstLineEndX - firstLineStartX, 1, -srcStride + 1, srcStride - 1, offset + 2, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
+      m_offsetEO( srcLine + srcStride + startX, srcStride, resLine + resStride + startX, resStride, endX - startX, height - 2, -srcStride + 1, srcStride - 1, offset + 2, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
+      srcLine += ( height - 1 ) * srcStride;
+      resLine += ( height - 1 ) * resStride;
       lastLineStartX = isBelowLeftAvail ? 0 : 1;
       lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      m_offsetEO( srcLine + lastLineStartX, srcStride, resLine + lastLineStartX, resStride, lastLineEndX - lastLineStartX, 1, -srcStride + 1, srcStride - 1, offset + 2, clpRng );
     }
     break;
   case SAO_TYPE_BO:
     {
       const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+
+      m_offsetBO( srcLine, srcStride, resLine, resStride, width, height, shiftBits, offset, clpRng );
     }
     break;
   default:
@@ -528,13 +445,6 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     const ComponentID compID = ComponentID(compIdx);
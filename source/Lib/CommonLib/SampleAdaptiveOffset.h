@@ -71,6 +71,24 @@ public:
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
 
+  // accumulates the edge offset statistics of a block, the edge class of a sample is given by its neighbours at offsetA and offsetB
+  static void calcEOStats( const Pel* srcLine, const int srcStride, const Pel* orgLine, const int orgStride, const int width, const int height, const int offsetA, const int offsetB, int64_t* diff, int64_t* count );
+  void ( *m_calcEOStats )( const Pel* srcLine, const int srcStride, const Pel* orgLine, const int orgStride, const int width, const int height, const int offsetA, const int offsetB, int64_t* diff, int64_t* count );
+
+  // applies the edge offsets to a block, the offsets are indexed by the edge class -2..2 given by the neighbours at offsetA and offsetB
+  static void offsetEO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int offsetA, const int offsetB, const int* offset, const ClpRng& clpRng );
+  void ( *m_offsetEO )( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int offsetA, const int offsetB, const int* offset, const ClpRng& clpRng );
+
+  // applies the band offsets to a block, the band of a sample is its value shifted right by shiftBits
+  static void offsetBO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  void ( *m_offsetBO )( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
+
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -99,8 +117,6 @@ protected:
   PelStorage m_tempBuf;
   uint32_t m_numberOfComponents;
 
-  std::vector<int8_t> m_signLineBuf1;
-  std::vector<int8_t> m_signLineBuf2;
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -1948,6 +1948,7 @@ public:
 
   void                        setNumRefIdx( RefPicList e, int i )                    { m_aiNumRefIdx[e]    = i;                                      }
   void                        setPic( Picture* p )                                   { m_pcPic             = p;                                      }
+  void                        setRefPic( Picture* p, RefPicList e, int iRefIdx )     { m_apcRefPicList[e][iRefIdx] = p;                              }
   void                        setDepth( int iDepth )                                 { m_iDepth            = iDepth;                                 }
 
   void                        setRefPicList( PicList& rcListPic, bool checkNumPocTotalCurr = false, bool bCopyL0toL1ErrorCase = false );
@@ -58,6 +58,11 @@ typedef void FwdTrans(const TCoeff*, TCoeff*, int, int, int, int, int);
 typedef void InvTrans(const TCoeff*, TCoeff*, int, int, int, int, int, const TCoeff, const TCoeff);
 #endif
 
+#if JEM_TOOLS || JVET_K1000_SIMPLIFIED_EMT
+extern FwdTrans *fastFwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+extern InvTrans *fastInvTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
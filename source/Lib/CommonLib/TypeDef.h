@@ -173,6 +173,36 @@
 #define NUM_RESERVERD_SPLIT_JOBS                        ( PARL_SPLIT_MAX_NUM_JOBS + 1 )  // number of all data structures including the merge thread (0)
 #define PARL_SPLIT_MAX_NUM_THREADS                        PARL_SPLIT_MAX_NUM_JOBS
 #define NUM_SPLIT_THREADS_IF_MSVC                         4
+#define PARL_SPLIT_MAX_NUM_LEVELS                         2                             // number of nested CU levels that can be split-parallelized, each level multiplies the job data structures
+
+#endif
+#ifndef ENABLE_FRAME_PARALLELISM
+#define ENABLE_FRAME_PARALLELISM                          0
+#endif
+#if ENABLE_FRAME_PARALLELISM
+#define PARL_FRAME_MAX_NUM_THREADS                        8                             // maximum number of pictures compressed concurrently
+
+#endif
+#ifndef ENABLE_DQP_RD_PARALLELISM
+#define ENABLE_DQP_RD_PARALLELISM                         0
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+#define PARL_DQP_RD_MAX_NUM_THREADS                       8                             // maximum number of slice QP candidates of DeltaQpRD compressed concurrently
+
+#endif
+#ifndef ENABLE_ME_PARALLELISM
+#define ENABLE_ME_PARALLELISM                             0
+#endif
+#if ENABLE_ME_PARALLELISM
+#define PARL_ME_MAX_NUM_THREADS                           8                             // maximum number of threads running the uni-directional searches of one PU
+#define PARL_ME_MIN_PU_SIZE                             256                             // minimum number of luma samples of a PU to run its reference searches in parallel
+
+#endif
+#ifndef ENABLE_LOOP_FILTER_PARALLELISM
+#define ENABLE_LOOP_FILTER_PARALLELISM                    0
+#endif
+#if ENABLE_LOOP_FILTER_PARALLELISM
+#define PARL_LOOP_FILTER_MAX_NUM_THREADS                 16                             // maximum number of threads sharing the CTUs of a picture in the in-loop filter encoder passes
 
 #endif
 
@@ -318,6 +348,14 @@
 #if JVET_K0371_ALF
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
 #endif
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT && JVET_K1000_SIMPLIFIED_EMT ) ///< SIMD optimization for the DCT-II, DST-VII and DCT-VIII transforms, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_BIO                             ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS && JVET_K0485_BIO ) ///< SIMD optimization for the BIO gradients and correlation sums, no impact on RD performance
+#define ENABLE_SIMD_OPT_LIC                             ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS )               ///< SIMD optimization for the LIC template sums, no impact on RD performance
+#define ENABLE_SIMD_OPT_OBMC                            ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS )               ///< SIMD optimization for the OBMC blending, no impact on RD performance
+#define ENABLE_SIMD_OPT_BIF                             ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS )               ///< SIMD optimization for the bilateral filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the SAO statistics, no impact on RD performance
 #if JVET_K0076_CPR
 #define ENABLE_SIMD_OPT_CPR                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for CPR
 #endif
@@ -692,6 +730,14 @@ enum MESearchMethod
   MESEARCH_NUMBER_OF_METHODS = 4
 };
 
+/// use of the per-CU analysis shared between the encodes of a multi-rate ladder
+enum EncAnalysisMode
+{
+  ANALYSIS_OFF               = 0,
+  ANALYSIS_RECORD            = 1,   ///< record the decisions of the reference encode
+  ANALYSIS_REUSE             = 2    ///< restrict the mode search of a dependent encode by the recorded decisions
+};
+
 /// coefficient scanning type used in ACS
 enum CoeffScanType
 {
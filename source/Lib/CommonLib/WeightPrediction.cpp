@@ -191,6 +191,24 @@ void WeightPrediction::addWeightBi(const CPelUnitBuf          &pcYuvSrc0,
     const uint32_t iSrc1Stride = pcYuvSrc1.bufs[compID].stride;
     const uint32_t iDstStride =  rpcYuvDst.bufs[compID].stride;
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if ((iWidth & 3) == 0)
+    {
+      // the internal offset of the samples, the rounding and the weighted offset are folded into one constant
+      const int add = w0 * IF_INTERNAL_OFFS + w1 * IF_INTERNAL_OFFS + round + (offset << (shift - 1));
+
+      if ((iWidth & 7) == 0)
+      {
+        g_pelBufOP.wghtAvg8(pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, shift, add, clpRng);
+      }
+      else
+      {
+        g_pelBufOP.wghtAvg4(pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, shift, add, clpRng);
+      }
+      continue;
+    }
+#endif
+
     for (int y = iHeight - 1; y >= 0; y--)
     {
       // do it in batches of 4 (partial unroll)
@@ -242,6 +260,28 @@ void  WeightPrediction::addWeightUni(const CPelUnitBuf          &pcYuvSrc0,
     const int  iHeight      = rpcYuvDst.bufs[compID].height;
     const int  iWidth       = rpcYuvDst.bufs[compID].width;
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if ((iWidth & 3) == 0)
+    {
+      // an identity weight is applied as a scaling by one with the reduced shift
+      const bool weighted = w0 != 1 << wp0[compID].shift;
+      const int  scale    = weighted ? w0 : 1;
+      const int  rshift   = weighted ? shift : shiftNum;
+      const int  round    = (rshift > 0) ? (1 << (rshift - 1)) : 0;
+      const int  add      = scale * IF_INTERNAL_OFFS + round;
+
+      if ((iWidth & 7) == 0)
+      {
+        g_pelBufOP.wghtUni8(pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, scale, add, rshift, offset, clpRng);
+      }
+      else
+      {
+        g_pelBufOP.wghtUni4(pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, scale, add, rshift, offset, clpRng);
+      }
+      continue;
+    }
+#endif
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const int  round = (shift > 0) ? (1 << (shift - 1)) : 0;
@@ -0,0 +1,161 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     BilateralFilterX86.h
+    \brief    SIMD functions of the bilateral filter class
+*/
+#include "CommonDefX86.h"
+#include "../BilateralFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if JEM_TOOLS
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#ifdef USE_AVX2
+// each sample is filtered with its four direct neighbours, the weights of the right and bottom neighbours of a row are
+// derived with gathers from the lookup table and reused as the weights of the left neighbour in the row and of the top
+// neighbour in the next row, the division by the sum of the weights uses gathers from the division lookup tables
+template<X86_VEXT vext>
+static void simdSmoothBlockBilateralFilter( const unsigned uiWidth, const unsigned uiHeight, short block[], const int centerWeight, const uint16_t* lookupTable, const int maxPos, const unsigned* divToMulOneOverN, const unsigned* divToMulShift )
+{
+  if( uiWidth & 7 )
+  {
+    BilateralFilter::smoothBlockBilateralFilterCore( uiWidth, uiHeight, block, centerWeight, lookupTable, maxPos, divToMulOneOverN, divToMulShift );
+    return;
+  }
+
+  const int width  = uiWidth;
+  const int height = uiHeight;
+
+  // entry x + 1 of the right neighbour arrays belongs to sample x, so that entry x is the left neighbour of sample x
+  int32_t rightWeight[MAX_CU_SIZE + 1];
+  int32_t rightDelta [MAX_CU_SIZE + 1];
+  int32_t bottomWeight[2][MAX_CU_SIZE];
+  int32_t bottomDelta [2][MAX_CU_SIZE];
+
+  rightWeight[0] = rightDelta[0] = 0;
+  std::memset( bottomWeight[1], 0, width * sizeof( int32_t ) );
+  std::memset( bottomDelta [1], 0, width * sizeof( int32_t ) );
+
+  const __m256i vmaxPos   = _mm256_set1_epi32( maxPos );
+  const __m256i vmask16   = _mm256_set1_epi32( 0xffff );
+  const __m256i vcenter   = _mm256_set1_epi32( centerWeight );
+  const __m256i vone      = _mm256_set1_epi32( 1 );
+  const __m256i vshift    = _mm256_set1_epi32( BITS_PER_DIV_LUT_ENTRY );
+  const __m256i vlastLane = _mm256_setr_epi32( 0, 0, 0, 0, 0, 0, 0, -1 );
+
+  int cur = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    short*         line    = block + y * width;
+    const short*   below   = line + width;
+    int32_t*       curW    = bottomWeight[cur];
+    int32_t*       curD    = bottomDelta [cur];
+    const int32_t* aboveW  = bottomWeight[1 - cur];
+    const int32_t* aboveD  = bottomDelta [1 - cur];
+    const bool     hasBelow = y + 1 < height;
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool    lastCol = x + 8 == width;
+      const __m128i vc16    = _mm_loadu_si128( ( const __m128i* ) &line[x] );
+      const __m128i vr16    = lastCol ? _mm_srli_si128( vc16, 2 ) : _mm_loadu_si128( ( const __m128i* ) &line[x + 1] );
+      const __m256i vc      = _mm256_cvtepi16_epi32( vc16 );
+
+      // right neighbour, the last sample of a row has none
+      const __m256i vdR = _mm256_sub_epi32( _mm256_cvtepi16_epi32( vr16 ), vc );
+      __m256i       vwR = _mm256_and_si256( _mm256_i32gather_epi32( ( const int* ) lookupTable, _mm256_min_epi32( vmaxPos, _mm256_abs_epi32( vdR ) ), 2 ), vmask16 );
+      if( lastCol )
+      {
+        vwR = _mm256_andnot_si256( vlastLane, vwR );
+      }
+      _mm256_storeu_si256( ( __m256i* ) &rightWeight[x + 1], vwR );
+      _mm256_storeu_si256( ( __m256i* ) &rightDelta [x + 1], _mm256_mullo_epi32( vwR, vdR ) );
+
+      // bottom neighbour, the last row has none
+      __m256i vwB = _mm256_setzero_si256();
+      __m256i vdB = _mm256_setzero_si256();
+      if( hasBelow )
+      {
+        const __m256i vdiff = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &below[x] ) ), vc );
+        vwB = _mm256_and_si256( _mm256_i32gather_epi32( ( const int* ) lookupTable, _mm256_min_epi32( vmaxPos, _mm256_abs_epi32( vdiff ) ), 2 ), vmask16 );
+        vdB = _mm256_mullo_epi32( vwB, vdiff );
+      }
+      _mm256_storeu_si256( ( __m256i* ) &curW[x], vwB );
+      _mm256_storeu_si256( ( __m256i* ) &curD[x], vdB );
+
+      // the left neighbour contributions are the right neighbour contributions of the previous sample with inverted difference
+      const __m256i vsumW  = _mm256_add_epi32( _mm256_add_epi32( _mm256_add_epi32( vcenter, vwR ), _mm256_loadu_si256( ( const __m256i* ) &rightWeight[x] ) ),
+                                               _mm256_add_epi32( vwB, _mm256_loadu_si256( ( const __m256i* ) &aboveW[x] ) ) );
+      const __m256i vdelta = _mm256_sub_epi32( _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &rightDelta[x + 1] ), vdB ),
+                                               _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &rightDelta[x] ), _mm256_loadu_si256( ( const __m256i* ) &aboveD[x] ) ) );
+
+      // c + sign * ( ( ( |delta| + ( ( sumW + signIfNeg ) >> 1 ) ) * divToMulOneOverN[sumW] ) >> ( BITS_PER_DIV_LUT_ENTRY + divToMulShift[sumW] ) )
+      const __m256i vsignIfNeg = _mm256_srai_epi32( vdelta, 31 );
+      const __m256i vnum       = _mm256_add_epi32( _mm256_abs_epi32( vdelta ), _mm256_srai_epi32( _mm256_add_epi32( vsumW, vsignIfNeg ), 1 ) );
+      const __m256i vmul       = _mm256_i32gather_epi32( ( const int* ) divToMulOneOverN, vsumW, 4 );
+      const __m256i vdivShift  = _mm256_add_epi32( _mm256_i32gather_epi32( ( const int* ) divToMulShift, vsumW, 4 ), vshift );
+      const __m256i vquot      = _mm256_srlv_epi32( _mm256_mullo_epi32( vnum, vmul ), vdivShift );
+      const __m256i vres       = _mm256_and_si256( _mm256_add_epi32( vc, _mm256_sign_epi32( vquot, _mm256_or_si256( vsignIfNeg, vone ) ) ), vmask16 );
+
+      _mm_storeu_si128( ( __m128i* ) &line[x], _mm256_castsi256_si128( _mm256_permute4x64_epi64( _mm256_packus_epi32( vres, vres ), 0x08 ) ) );
+    }
+
+    cur = 1 - cur;
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void BilateralFilter::_initBilateralFilterX86()
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    m_smoothBlock = simdSmoothBlockBilateralFilter<vext>;
+  }
+#endif
+}
+
+template void BilateralFilter::_initBilateralFilterX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+//! \}
@@ -211,6 +211,341 @@ void reco_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src
   }
 }
 
+template< X86_VEXT vext, int W >
+void wghtAvg_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng )
+{
+  // the samples of both sources are interleaved, so that one multiply-add applies both weights exactly in 32 bit
+  if( W == 8 && vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+#if USE_AVX2
+    __m256i vw       = _mm256_unpacklo_epi16( _mm256_set1_epi16( w0 ), _mm256_set1_epi16( w1 ) );
+    __m256i voffset  = _mm256_set1_epi32( offset );
+    __m256i vibdimin = _mm256_set1_epi16( clpRng.min );
+    __m256i vibdimax = _mm256_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 16 )
+      {
+        __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i * )&src0[col] );
+        __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i * )&src1[col] );
+
+        __m256i vsumlo = _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc0, vsrc1 ), vw );
+        __m256i vsumhi = _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc0, vsrc1 ), vw );
+        vsumlo = _mm256_srai_epi32( _mm256_add_epi32( vsumlo, voffset ), shift );
+        vsumhi = _mm256_srai_epi32( _mm256_add_epi32( vsumhi, voffset ), shift );
+
+        __m256i vdst = _mm256_packs_epi32( vsumlo, vsumhi );
+        vdst = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vdst ) );
+        _mm256_storeu_si256( ( __m256i * )&dst[col], vdst );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+#endif
+  }
+  else if( W == 8 )
+  {
+    __m128i vw       = _mm_unpacklo_epi16( _mm_set1_epi16( w0 ), _mm_set1_epi16( w1 ) );
+    __m128i voffset  = _mm_set1_epi32( offset );
+    __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+    __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m128i vsrc0 = _mm_loadu_si128( ( const __m128i * )&src0[col] );
+        __m128i vsrc1 = _mm_loadu_si128( ( const __m128i * )&src1[col] );
+
+        __m128i vsumlo = _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vw );
+        __m128i vsumhi = _mm_madd_epi16( _mm_unpackhi_epi16( vsrc0, vsrc1 ), vw );
+        vsumlo = _mm_srai_epi32( _mm_add_epi32( vsumlo, voffset ), shift );
+        vsumhi = _mm_srai_epi32( _mm_add_epi32( vsumhi, voffset ), shift );
+
+        __m128i vdst = _mm_packs_epi32( vsumlo, vsumhi );
+        vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+        _mm_storeu_si128( ( __m128i * )&dst[col], vdst );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+  }
+  else if( W == 4 )
+  {
+    __m128i vw       = _mm_unpacklo_epi16( _mm_set1_epi16( w0 ), _mm_set1_epi16( w1 ) );
+    __m128i voffset  = _mm_set1_epi32( offset );
+    __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+    __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vsrc0 = _mm_loadl_epi64( ( const __m128i * )&src0[col] );
+        __m128i vsrc1 = _mm_loadl_epi64( ( const __m128i * )&src1[col] );
+
+        __m128i vsum  = _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vw );
+        vsum = _mm_srai_epi32( _mm_add_epi32( vsum, voffset ), shift );
+
+        __m128i vdst = _mm_packs_epi32( vsum, vsum );
+        vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+        _mm_storel_epi64( ( __m128i * )&dst[col], vdst );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+  }
+  else
+  {
+    THROW( "Unsupported size" );
+  }
+}
+
+template< X86_VEXT vext, int W >
+void wghtUni_SSE( const int16_t* src, int srcStride, int16_t *dst, int dstStride, int width, int height, int scale, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  // the 32 bit products are assembled from the low and high halves of the 16 bit multiplications
+  if( W == 8 && vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+#if USE_AVX2
+    __m256i vscale   = _mm256_set1_epi16( scale );
+    __m256i vround   = _mm256_set1_epi32( round );
+    __m256i voffset  = _mm256_set1_epi32( offset );
+    __m256i vibdimin = _mm256_set1_epi16( clpRng.min );
+    __m256i vibdimax = _mm256_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 16 )
+      {
+        __m256i vsrc   = _mm256_loadu_si256( ( const __m256i * )&src[col] );
+        __m256i vprdlo = _mm256_mullo_epi16( vsrc, vscale );
+        __m256i vprdhi = _mm256_mulhi_epi16( vsrc, vscale );
+
+        __m256i vsumlo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_unpacklo_epi16( vprdlo, vprdhi ), vround ), shift );
+        __m256i vsumhi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_unpackhi_epi16( vprdlo, vprdhi ), vround ), shift );
+
+        __m256i vdst = _mm256_packs_epi32( _mm256_add_epi32( vsumlo, voffset ), _mm256_add_epi32( vsumhi, voffset ) );
+        vdst = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vdst ) );
+        _mm256_storeu_si256( ( __m256i * )&dst[col], vdst );
+      }
+
+      src += srcStride;
+      dst += dstStride;
+    }
+#endif
+  }
+  else if( W == 8 || W == 4 )
+  {
+    __m128i vscale   = _mm_set1_epi16( scale );
+    __m128i vround   = _mm_set1_epi32( round );
+    __m128i voffset  = _mm_set1_epi32( offset );
+    __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+    __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += W )
+      {
+        __m128i vsrc   = W == 8 ? _mm_loadu_si128( ( const __m128i * )&src[col] ) : _mm_loadl_epi64( ( const __m128i * )&src[col] );
+        __m128i vprdlo = _mm_mullo_epi16( vsrc, vscale );
+        __m128i vprdhi = _mm_mulhi_epi16( vsrc, vscale );
+
+        __m128i vsumlo = _mm_srai_epi32( _mm_add_epi32( _mm_unpacklo_epi16( vprdlo, vprdhi ), vround ), shift );
+        __m128i vsumhi = _mm_srai_epi32( _mm_add_epi32( _mm_unpackhi_epi16( vprdlo, vprdhi ), vround ), shift );
+
+        __m128i vdst = _mm_packs_epi32( _mm_add_epi32( vsumlo, voffset ), _mm_add_epi32( vsumhi, voffset ) );
+        vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+
+        if( W == 8 )
+        {
+          _mm_storeu_si128( ( __m128i * )&dst[col], vdst );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i * )&dst[col], vdst );
+        }
+      }
+
+      src += srcStride;
+      dst += dstStride;
+    }
+  }
+  else
+  {
+    THROW( "Unsupported size" );
+  }
+}
+
+#if JVET_K0248_GBI
+template< X86_VEXT vext >
+void addAvg4GBI_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, uint8_t gbiIdx )
+{
+  wghtAvg_SSE<vext, 4>( src0, src0Stride, src1, src1Stride, dst, dstStride, width, height, getGbiWeight( gbiIdx, REF_PIC_LIST_0 ), getGbiWeight( gbiIdx, REF_PIC_LIST_1 ), shift, offset, clpRng );
+}
+#endif
+
+#if JVET_K0485_BIO
+template< X86_VEXT vext, bool gbi >
+static inline __m128i addBIOAvg4Row_SSE( const int16_t* src0, const int16_t* src1, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel *pGradY1,
+                                         __m128i vtmpx, __m128i vtmpy, __m128i vw0, __m128i vw1, __m128i voffset, int shift )
+{
+  __m128i vgradx = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) pGradX0 ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) pGradX1 ) ) );
+  __m128i vgrady = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) pGradY0 ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) pGradY1 ) ) );
+  __m128i vsrc0  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) src0 ) );
+  __m128i vsrc1  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * ) src1 ) );
+
+  __m128i vb     = _mm_add_epi32( _mm_mullo_epi32( vtmpx, vgradx ), _mm_mullo_epi32( vtmpy, vgrady ) );
+
+  if( gbi )
+  {
+    vb    = _mm_srai_epi32( _mm_add_epi32( _mm_slli_epi32( vb, g_GbiLog2WeightBase ), _mm_set1_epi32( 64 ) ), 7 );
+    vsrc0 = _mm_mullo_epi32( vsrc0, vw0 );
+    vsrc1 = _mm_mullo_epi32( vsrc1, vw1 );
+  }
+  else
+  {
+    vb    = _mm_srai_epi32( _mm_add_epi32( vb, _mm_set1_epi32( 32 ) ), 6 );
+  }
+
+  __m128i vsum   = _mm_add_epi32( _mm_add_epi32( vsrc0, vsrc1 ), _mm_add_epi32( vb, voffset ) );
+
+  return _mm_srai_epi32( vsum, shift );
+}
+
+#if USE_AVX2
+static inline __m256i load2x4_AVX2( const int16_t* row0, const int16_t* row1 )
+{
+  return _mm256_cvtepi16_epi32( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i * ) row0 ), _mm_loadl_epi64( ( const __m128i * ) row1 ) ) );
+}
+
+template< bool gbi >
+static inline __m128i addBIOAvg4x2_AVX2( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel *pGradY1, int gradStride,
+                                         __m256i vtmpx, __m256i vtmpy, __m256i vw0, __m256i vw1, __m256i voffset, int shift )
+{
+  __m256i vgradx = _mm256_sub_epi32( load2x4_AVX2( pGradX0, pGradX0 + gradStride ), load2x4_AVX2( pGradX1, pGradX1 + gradStride ) );
+  __m256i vgrady = _mm256_sub_epi32( load2x4_AVX2( pGradY0, pGradY0 + gradStride ), load2x4_AVX2( pGradY1, pGradY1 + gradStride ) );
+  __m256i vsrc0  = load2x4_AVX2( src0, src0 + src0Stride );
+  __m256i vsrc1  = load2x4_AVX2( src1, src1 + src1Stride );
+
+  __m256i vb     = _mm256_add_epi32( _mm256_mullo_epi32( vtmpx, vgradx ), _mm256_mullo_epi32( vtmpy, vgrady ) );
+
+  if( gbi )
+  {
+    vb    = _mm256_srai_epi32( _mm256_add_epi32( _mm256_slli_epi32( vb, g_GbiLog2WeightBase ), _mm256_set1_epi32( 64 ) ), 7 );
+    vsrc0 = _mm256_mullo_epi32( vsrc0, vw0 );
+    vsrc1 = _mm256_mullo_epi32( vsrc1, vw1 );
+  }
+  else
+  {
+    vb    = _mm256_srai_epi32( _mm256_add_epi32( vb, _mm256_set1_epi32( 32 ) ), 6 );
+  }
+
+  __m256i vsum   = _mm256_add_epi32( _mm256_add_epi32( vsrc0, vsrc1 ), _mm256_add_epi32( vb, voffset ) );
+  vsum           = _mm256_srai_epi32( vsum, shift );
+
+  // row 0 in the low and row 1 in the high half
+  return _mm_packs_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+}
+#endif
+
+template< X86_VEXT vext, bool gbi >
+void addBIOAvg4_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel *pGradY1, int gradStride,
+                     int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng, int w0, int w1 )
+{
+  const __m128i vtmpx    = _mm_set1_epi32( tmpx );
+  const __m128i vtmpy    = _mm_set1_epi32( tmpy );
+  const __m128i vw0      = _mm_set1_epi32( w0 );
+  const __m128i vw1      = _mm_set1_epi32( w1 );
+  const __m128i voffset  = _mm_set1_epi32( offset );
+  const __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+  const __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+  int row = 0;
+
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vtmpx256   = _mm256_set1_epi32( tmpx );
+    const __m256i vtmpy256   = _mm256_set1_epi32( tmpy );
+    const __m256i vw0256     = _mm256_set1_epi32( w0 );
+    const __m256i vw1256     = _mm256_set1_epi32( w1 );
+    const __m256i voffset256 = _mm256_set1_epi32( offset );
+
+    for( ; row + 1 < height; row += 2 )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vdst = addBIOAvg4x2_AVX2<gbi>( &src0[col], src0Stride, &src1[col], src1Stride, &pGradX0[col], &pGradX1[col], &pGradY0[col], &pGradY1[col], gradStride,
+                                               vtmpx256, vtmpy256, vw0256, vw1256, voffset256, shift );
+
+        vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+        _mm_storel_epi64( ( __m128i * )&dst[col],             vdst );
+        _mm_storel_epi64( ( __m128i * )&dst[col + dstStride], _mm_unpackhi_epi64( vdst, vdst ) );
+      }
+
+      src0    += 2 * src0Stride; src1    += 2 * src1Stride; dst     += 2 * dstStride;
+      pGradX0 += 2 * gradStride; pGradX1 += 2 * gradStride; pGradY0 += 2 * gradStride; pGradY1 += 2 * gradStride;
+    }
+  }
+#endif
+
+  // two rows of four samples share one pack and clip
+  for( ; row + 1 < height; row += 2 )
+  {
+    for( int col = 0; col < width; col += 4 )
+    {
+      __m128i vsum0 = addBIOAvg4Row_SSE<vext, gbi>( &src0[col],              &src1[col],              &pGradX0[col],              &pGradX1[col],              &pGradY0[col],              &pGradY1[col],              vtmpx, vtmpy, vw0, vw1, voffset, shift );
+      __m128i vsum1 = addBIOAvg4Row_SSE<vext, gbi>( &src0[col + src0Stride], &src1[col + src1Stride], &pGradX0[col + gradStride], &pGradX1[col + gradStride], &pGradY0[col + gradStride], &pGradY1[col + gradStride], vtmpx, vtmpy, vw0, vw1, voffset, shift );
+      __m128i vdst  = _mm_packs_epi32( vsum0, vsum1 );
+
+      vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+      _mm_storel_epi64( ( __m128i * )&dst[col],             vdst );
+      _mm_storel_epi64( ( __m128i * )&dst[col + dstStride], _mm_unpackhi_epi64( vdst, vdst ) );
+    }
+
+    src0    += 2 * src0Stride; src1    += 2 * src1Stride; dst     += 2 * dstStride;
+    pGradX0 += 2 * gradStride; pGradX1 += 2 * gradStride; pGradY0 += 2 * gradStride; pGradY1 += 2 * gradStride;
+  }
+
+  if( row < height )
+  {
+    for( int col = 0; col < width; col += 4 )
+    {
+      __m128i vdst = addBIOAvg4Row_SSE<vext, gbi>( &src0[col], &src1[col], &pGradX0[col], &pGradX1[col], &pGradY0[col], &pGradY1[col], vtmpx, vtmpy, vw0, vw1, voffset, shift );
+
+      vdst = _mm_packs_epi32( vdst, vdst );
+      vdst = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vdst ) );
+      _mm_storel_epi64( ( __m128i * )&dst[col], vdst );
+    }
+  }
+}
+
+template< X86_VEXT vext >
+void addBIOAvg4_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel *pGradY1, int gradStride,
+                     int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng )
+{
+  addBIOAvg4_SSE<vext, false>( src0, src0Stride, src1, src1Stride, dst, dstStride, pGradX0, pGradX1, pGradY0, pGradY1, gradStride, width, height, tmpx, tmpy, shift, offset, clpRng, 1, 1 );
+}
+
+#if JVET_K0248_GBI
+template< X86_VEXT vext >
+void addBIOAvg4GBI_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, const Pel *pGradX0, const Pel *pGradX1, const Pel *pGradY0, const Pel *pGradY1, int gradStride,
+                        int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng, uint8_t gbiIdx )
+{
+  addBIOAvg4_SSE<vext, true>( src0, src0Stride, src1, src1Stride, dst, dstStride, pGradX0, pGradX1, pGradY0, pGradY1, gradStride, width, height, tmpx, tmpy, shift, offset, clpRng,
+                              getGbiWeight( gbiIdx, REF_PIC_LIST_0 ), getGbiWeight( gbiIdx, REF_PIC_LIST_1 ) );
+}
+#endif
+#endif
+
 template<bool doShift, bool shiftR, typename T> static inline void do_shift( T &vreg, int num );
 #if USE_AVX2
 template<> inline void do_shift<true,  true , __m256i>( __m256i &vreg, int num ) { vreg = _mm256_srai_epi32( vreg, num ); }
@@ -367,12 +702,25 @@ void PelBufferOps::_initPelBufOpsX86()
 {
   addAvg8 = addAvg_SSE<vext, 8>;
   addAvg4 = addAvg_SSE<vext, 4>;
+#if JVET_K0485_BIO
+  addBIOAvg4    = addBIOAvg4_SSE<vext>;
+#if JVET_K0248_GBI
+  addBIOAvg4GBI = addBIOAvg4GBI_SSE<vext>;
+  addAvg4GBI    = addAvg4GBI_SSE<vext>;
+#endif
+#endif
 
   reco8 = reco_SSE<vext, 8>;
   reco4 = reco_SSE<vext, 4>;
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  wghtAvg8 = wghtAvg_SSE<vext, 8>;
+  wghtAvg4 = wghtAvg_SSE<vext, 4>;
+
+  wghtUni8 = wghtUni_SSE<vext, 8>;
+  wghtUni4 = wghtUni_SSE<vext, 4>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -0,0 +1,576 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InterPredictionX86.h
+    \brief    SIMD functions of the BIO gradient and correlation computation
+*/
+#include "CommonDefX86.h"
+#include "../InterPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#if JVET_K0485_BIO
+template<X86_VEXT vext>
+static void simdGradFilter( Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* pGradX, Pel* pGradY )
+{
+  if( width < 8 )
+  {
+    InterPrediction::gradFilter( pSrc, srcStride, width, height, gradStride, pGradX, pGradY );
+    return;
+  }
+
+  // the differences of the intermediate samples may exceed 16 bit, they are built in 32 bit. A width that is
+  // not a multiple of the vector width is covered by a last, overlapping vector
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 16 )
+      {
+        if( x > width - 16 )
+        {
+          x = width - 16;
+        }
+
+        const Pel* src = pSrc + x;
+
+        __m256i vGradX0 = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[1] ) ),         _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[-1] ) ) );
+        __m256i vGradX1 = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[9] ) ),         _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[7] ) ) );
+        __m256i vGradY0 = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[srcStride] ) ),     _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[-srcStride] ) ) );
+        __m256i vGradY1 = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[srcStride + 8] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src[-srcStride + 8] ) ) );
+
+        __m256i vGradX  = _mm256_packs_epi32( _mm256_srai_epi32( vGradX0, 4 ), _mm256_srai_epi32( vGradX1, 4 ) );
+        __m256i vGradY  = _mm256_packs_epi32( _mm256_srai_epi32( vGradY0, 4 ), _mm256_srai_epi32( vGradY1, 4 ) );
+
+        _mm256_storeu_si256( ( __m256i* ) &pGradX[x], _mm256_permute4x64_epi64( vGradX, 0xd8 ) );
+        _mm256_storeu_si256( ( __m256i* ) &pGradY[x], _mm256_permute4x64_epi64( vGradY, 0xd8 ) );
+      }
+
+      pGradX += gradStride;
+      pGradY += gradStride;
+      pSrc   += srcStride;
+    }
+  }
+  else
+#endif
+  {
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        if( x > width - 8 )
+        {
+          x = width - 8;
+        }
+
+        const Pel* src = pSrc + x;
+
+        __m128i vRight  = _mm_loadu_si128( ( const __m128i* ) &src[1] );
+        __m128i vLeft   = _mm_loadu_si128( ( const __m128i* ) &src[-1] );
+        __m128i vBelow  = _mm_loadu_si128( ( const __m128i* ) &src[srcStride] );
+        __m128i vAbove  = _mm_loadu_si128( ( const __m128i* ) &src[-srcStride] );
+
+        __m128i vGradX0 = _mm_sub_epi32( _mm_cvtepi16_epi32( vRight ),                     _mm_cvtepi16_epi32( vLeft ) );
+        __m128i vGradX1 = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_srli_si128( vRight, 8 ) ), _mm_cvtepi16_epi32( _mm_srli_si128( vLeft, 8 ) ) );
+        __m128i vGradY0 = _mm_sub_epi32( _mm_cvtepi16_epi32( vBelow ),                     _mm_cvtepi16_epi32( vAbove ) );
+        __m128i vGradY1 = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_srli_si128( vBelow, 8 ) ), _mm_cvtepi16_epi32( _mm_srli_si128( vAbove, 8 ) ) );
+
+        _mm_storeu_si128( ( __m128i* ) &pGradX[x], _mm_packs_epi32( _mm_srai_epi32( vGradX0, 4 ), _mm_srai_epi32( vGradX1, 4 ) ) );
+        _mm_storeu_si128( ( __m128i* ) &pGradY[x], _mm_packs_epi32( _mm_srai_epi32( vGradY0, 4 ), _mm_srai_epi32( vGradY1, 4 ) ) );
+      }
+
+      pGradX += gradStride;
+      pGradY += gradStride;
+      pSrc   += srcStride;
+    }
+  }
+}
+
+static inline void simdMul64( const __m128i a, const __m128i b, __m128i& lo, __m128i& hi )
+{
+  // exact 64 bit products of the signed 32 bit lanes, lanes 0..1 in lo and lanes 2..3 in hi
+  const __m128i even = _mm_mul_epi32( a, b );
+  const __m128i odd  = _mm_mul_epi32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+
+  lo = _mm_unpacklo_epi64( even, odd );
+  hi = _mm_unpackhi_epi64( even, odd );
+}
+
+#ifdef USE_AVX2
+static inline void simdMul64( const __m256i a, const __m256i b, __m256i& lo, __m256i& hi )
+{
+  const __m256i even = _mm256_mul_epi32( a, b );
+  const __m256i odd  = _mm256_mul_epi32( _mm256_srli_epi64( a, 32 ), _mm256_srli_epi64( b, 32 ) );
+  const __m256i l    = _mm256_unpacklo_epi64( even, odd );
+  const __m256i h    = _mm256_unpackhi_epi64( even, odd );
+
+  lo = _mm256_permute2x128_si256( l, h, 0x20 );
+  hi = _mm256_permute2x128_si256( l, h, 0x31 );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdDotProducts( const Pel* pSrc0, int src0Stride, const Pel* pSrc1, int src1Stride, const Pel* pGradX0, const Pel* pGradX1, const Pel* pGradY0, const Pel* pGradY1, int gradStride,
+                             int width, int height, int64_t* pDotProduct1, int64_t* pDotProduct2, int64_t* pDotProduct3, int64_t* pDotProduct5, int64_t* pDotProduct6 )
+{
+  if( width < 4 )
+  {
+    InterPrediction::dotProducts( pSrc0, src0Stride, pSrc1, src1Stride, pGradX0, pGradX1, pGradY0, pGradY1, gradStride, width, height, pDotProduct1, pDotProduct2, pDotProduct3, pDotProduct5, pDotProduct6 );
+    return;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 8 )
+  {
+    const __m256i vzero = _mm256_setzero_si256();
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        if( x > width - 8 )
+        {
+          x = width - 8;
+        }
+
+        __m256i vTemp    = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pSrc0[x] ) ),   _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pSrc1[x] ) ) );
+        __m256i vTempX   = _mm256_add_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pGradX0[x] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pGradX1[x] ) ) );
+        __m256i vTempY   = _mm256_add_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pGradY0[x] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pGradY1[x] ) ) );
+        __m256i vNegTemp = _mm256_sub_epi32( vzero, vTemp );
+        __m256i lo, hi;
+
+        simdMul64( vTempX, vTempX, lo, hi );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct1[x],     lo );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct1[x + 4], hi );
+
+        simdMul64( vTempX, vTempY, lo, hi );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct2[x],     lo );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct2[x + 4], hi );
+
+        simdMul64( vTempX, vNegTemp, lo, hi );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct3[x],     _mm256_slli_epi64( lo, 5 ) );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct3[x + 4], _mm256_slli_epi64( hi, 5 ) );
+
+        simdMul64( vTempY, vTempY, lo, hi );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct5[x],     _mm256_slli_epi64( lo, 1 ) );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct5[x + 4], _mm256_slli_epi64( hi, 1 ) );
+
+        simdMul64( vTempY, vNegTemp, lo, hi );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct6[x],     _mm256_slli_epi64( lo, 6 ) );
+        _mm256_storeu_si256( ( __m256i* ) &pDotProduct6[x + 4], _mm256_slli_epi64( hi, 6 ) );
+      }
+
+      pSrc0        += src0Stride;
+      pSrc1        += src1Stride;
+      pGradX0      += gradStride;
+      pGradX1      += gradStride;
+      pGradY0      += gradStride;
+      pGradY1      += gradStride;
+      pDotProduct1 += gradStride;
+      pDotProduct2 += gradStride;
+      pDotProduct3 += gradStride;
+      pDotProduct5 += gradStride;
+      pDotProduct6 += gradStride;
+    }
+  }
+  else
+#endif
+  {
+    const __m128i vzero = _mm_setzero_si128();
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 4 )
+      {
+        if( x > width - 4 )
+        {
+          x = width - 4;
+        }
+
+        __m128i vTemp    = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pSrc0[x] ) ),   _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pSrc1[x] ) ) );
+        __m128i vTempX   = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pGradX0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pGradX1[x] ) ) );
+        __m128i vTempY   = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pGradY0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pGradY1[x] ) ) );
+        __m128i vNegTemp = _mm_sub_epi32( vzero, vTemp );
+        __m128i lo, hi;
+
+        simdMul64( vTempX, vTempX, lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct1[x],     lo );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct1[x + 2], hi );
+
+        simdMul64( vTempX, vTempY, lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct2[x],     lo );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct2[x + 2], hi );
+
+        simdMul64( vTempX, vNegTemp, lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct3[x],     _mm_slli_epi64( lo, 5 ) );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct3[x + 2], _mm_slli_epi64( hi, 5 ) );
+
+        simdMul64( vTempY, vTempY, lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct5[x],     _mm_slli_epi64( lo, 1 ) );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct5[x + 2], _mm_slli_epi64( hi, 1 ) );
+
+        simdMul64( vTempY, vNegTemp, lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct6[x],     _mm_slli_epi64( lo, 6 ) );
+        _mm_storeu_si128( ( __m128i* ) &pDotProduct6[x + 2], _mm_slli_epi64( hi, 6 ) );
+      }
+
+      pSrc0        += src0Stride;
+      pSrc1        += src1Stride;
+      pGradX0      += gradStride;
+      pGradX1      += gradStride;
+      pGradY0      += gradStride;
+      pGradY1      += gradStride;
+      pDotProduct1 += gradStride;
+      pDotProduct2 += gradStride;
+      pDotProduct3 += gradStride;
+      pDotProduct5 += gradStride;
+      pDotProduct6 += gradStride;
+    }
+  }
+}
+
+static inline int64_t simdHorSum64( const __m128i v )
+{
+  const __m128i sum = _mm_add_epi64( v, _mm_unpackhi_epi64( v, v ) );
+#if defined( __x86_64__ ) || defined( _M_X64 )
+  return _mm_cvtsi128_si64( sum );
+#else
+  int64_t res;
+  _mm_storel_epi64( ( __m128i* ) &res, sum );
+  return res;
+#endif
+}
+
+template<X86_VEXT vext>
+static void simdCalcBlkGradient( int sx, int sy, int64_t *arraysGx2, int64_t *arraysGxGy, int64_t *arraysGxdI, int64_t *arraysGy2, int64_t *arraysGydI,
+                                 int64_t &sGx2, int64_t &sGy2, int64_t &sGxGy, int64_t &sGxdI, int64_t &sGydI, int width, int height, int unitSize )
+{
+  const int winSize = unitSize + 2 * JVET_K0485_BIO_EXTEND_SIZE;
+
+  if( winSize != 6 )
+  {
+    InterPrediction::calcBlkGradient( sx, sy, arraysGx2, arraysGxGy, arraysGxdI, arraysGy2, arraysGydI, sGx2, sGy2, sGxGy, sGxdI, sGydI, width, height, unitSize );
+    return;
+  }
+
+  // the 6x6 window around the sub-block, as two plus one pair of 64 bit sums per row
+  const int offset = -JVET_K0485_BIO_EXTEND_SIZE * width - JVET_K0485_BIO_EXTEND_SIZE;
+
+  const int64_t* pGx2  = arraysGx2  + offset;
+  const int64_t* pGy2  = arraysGy2  + offset;
+  const int64_t* pGxGy = arraysGxGy + offset;
+  const int64_t* pGxdI = arraysGxdI + offset;
+  const int64_t* pGydI = arraysGydI + offset;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i vGx2  = _mm256_setzero_si256();
+    __m256i vGy2  = _mm256_setzero_si256();
+    __m256i vGxGy = _mm256_setzero_si256();
+    __m256i vGxdI = _mm256_setzero_si256();
+    __m256i vGydI = _mm256_setzero_si256();
+
+    for( int y = 0; y < winSize; y++ )
+    {
+      // lanes 0..3 and 4..5 of the row are added into the two halves of the 4 lane accumulators, the upper half of
+      // lanes 4..5 has to be zero
+      vGx2  = _mm256_add_epi64( vGx2,  _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) pGx2  ), _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* ) &pGx2 [4] ), 0 ) ) );
+      vGy2  = _mm256_add_epi64( vGy2,  _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) pGy2  ), _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* ) &pGy2 [4] ), 0 ) ) );
+      vGxGy = _mm256_add_epi64( vGxGy, _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) pGxGy ), _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* ) &pGxGy[4] ), 0 ) ) );
+      vGxdI = _mm256_add_epi64( vGxdI, _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) pGxdI ), _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* ) &pGxdI[4] ), 0 ) ) );
+      vGydI = _mm256_add_epi64( vGydI, _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) pGydI ), _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* ) &pGydI[4] ), 0 ) ) );
+
+      pGx2  += width;
+      pGy2  += width;
+      pGxGy += width;
+      pGxdI += width;
+      pGydI += width;
+    }
+
+    sGx2  += simdHorSum64( _mm_add_epi64( _mm256_castsi256_si128( vGx2  ), _mm256_extracti128_si256( vGx2,  1 ) ) );
+    sGy2  += simdHorSum64( _mm_add_epi64( _mm256_castsi256_si128( vGy2  ), _mm256_extracti128_si256( vGy2,  1 ) ) );
+    sGxGy += simdHorSum64( _mm_add_epi64( _mm256_castsi256_si128( vGxGy ), _mm256_extracti128_si256( vGxGy, 1 ) ) );
+    sGxdI += simdHorSum64( _mm_add_epi64( _mm256_castsi256_si128( vGxdI ), _mm256_extracti128_si256( vGxdI, 1 ) ) );
+    sGydI += simdHorSum64( _mm_add_epi64( _mm256_castsi256_si128( vGydI ), _mm256_extracti128_si256( vGydI, 1 ) ) );
+  }
+  else
+#endif
+  {
+    __m128i vGx2  = _mm_setzero_si128();
+    __m128i vGy2  = _mm_setzero_si128();
+    __m128i vGxGy = _mm_setzero_si128();
+    __m128i vGxdI = _mm_setzero_si128();
+    __m128i vGydI = _mm_setzero_si128();
+
+    for( int y = 0; y < winSize; y++ )
+    {
+      for( int x = 0; x < winSize; x += 2 )
+      {
+        vGx2  = _mm_add_epi64( vGx2,  _mm_loadu_si128( ( const __m128i* ) &pGx2 [x] ) );
+        vGy2  = _mm_add_epi64( vGy2,  _mm_loadu_si128( ( const __m128i* ) &pGy2 [x] ) );
+        vGxGy = _mm_add_epi64( vGxGy, _mm_loadu_si128( ( const __m128i* ) &pGxGy[x] ) );
+        vGxdI = _mm_add_epi64( vGxdI, _mm_loadu_si128( ( const __m128i* ) &pGxdI[x] ) );
+        vGydI = _mm_add_epi64( vGydI, _mm_loadu_si128( ( const __m128i* ) &pGydI[x] ) );
+      }
+
+      pGx2  += width;
+      pGy2  += width;
+      pGxGy += width;
+      pGxdI += width;
+      pGydI += width;
+    }
+
+    sGx2  += simdHorSum64( vGx2  );
+    sGy2  += simdHorSum64( vGy2  );
+    sGxGy += simdHorSum64( vGxGy );
+    sGxdI += simdHorSum64( vGxdI );
+    sGydI += simdHorSum64( vGydI );
+  }
+}
+#endif
+
+#if JEM_TOOLS
+template<X86_VEXT vext>
+static void simdCalcLICSums( const Pel* ref, int refStride, const Pel* rec, int recStride, int length, int dimShift, int precShift, int& x, int& y, int& xx, int& xy )
+{
+  const int numSteps = 1 << dimShift;
+
+  if( ( numSteps & 3 ) || ( length & ( numSteps - 1 ) ) )
+  {
+    InterPrediction::calcLICSums( ref, refStride, rec, recStride, length, dimShift, precShift, x, y, xx, xy );
+    return;
+  }
+
+  // the subsampled template samples are gathered into contiguous rows unless they already are, the squares and
+  // products of the 16 bit samples are summed pairwise into 32 bit lanes by madd
+  const int refStep = refStride * ( length >> dimShift );
+  const int recStep = recStride * ( length >> dimShift );
+  Pel refRow[MAX_CU_SIZE];
+  Pel recRow[MAX_CU_SIZE];
+
+  if( refStep != 1 )
+  {
+    for( int k = 0; k < numSteps; k++ )
+    {
+      refRow[k] = ref[k * refStep];
+    }
+    ref = refRow;
+  }
+  if( recStep != 1 )
+  {
+    for( int k = 0; k < numSteps; k++ )
+    {
+      recRow[k] = rec[k * recStep];
+    }
+    rec = recRow;
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128( precShift );
+  __m128i vx  = _mm_setzero_si128();
+  __m128i vy  = _mm_setzero_si128();
+  __m128i vxx = _mm_setzero_si128();
+  __m128i vxy = _mm_setzero_si128();
+  int k = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && numSteps >= 16 )
+  {
+    const __m256i vone = _mm256_set1_epi16( 1 );
+    __m256i vx256  = _mm256_setzero_si256();
+    __m256i vy256  = _mm256_setzero_si256();
+    __m256i vxx256 = _mm256_setzero_si256();
+    __m256i vxy256 = _mm256_setzero_si256();
+
+    for( ; k < numSteps; k += 16 )
+    {
+      __m256i vref = _mm256_sra_epi16( _mm256_loadu_si256( ( const __m256i* ) &ref[k] ), vshift );
+      __m256i vrec = _mm256_sra_epi16( _mm256_loadu_si256( ( const __m256i* ) &rec[k] ), vshift );
+      vx256  = _mm256_add_epi32( vx256,  _mm256_madd_epi16( vref, vone ) );
+      vy256  = _mm256_add_epi32( vy256,  _mm256_madd_epi16( vrec, vone ) );
+      vxx256 = _mm256_add_epi32( vxx256, _mm256_madd_epi16( vref, vref ) );
+      vxy256 = _mm256_add_epi32( vxy256, _mm256_madd_epi16( vref, vrec ) );
+    }
+
+    vx  = _mm_add_epi32( _mm256_castsi256_si128( vx256  ), _mm256_extracti128_si256( vx256,  1 ) );
+    vy  = _mm_add_epi32( _mm256_castsi256_si128( vy256  ), _mm256_extracti128_si256( vy256,  1 ) );
+    vxx = _mm_add_epi32( _mm256_castsi256_si128( vxx256 ), _mm256_extracti128_si256( vxx256, 1 ) );
+    vxy = _mm_add_epi32( _mm256_castsi256_si128( vxy256 ), _mm256_extracti128_si256( vxy256, 1 ) );
+  }
+#endif
+  {
+    const __m128i vone = _mm_set1_epi16( 1 );
+
+    for( ; k + 8 <= numSteps; k += 8 )
+    {
+      __m128i vref = _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &ref[k] ), vshift );
+      __m128i vrec = _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &rec[k] ), vshift );
+      vx  = _mm_add_epi32( vx,  _mm_madd_epi16( vref, vone ) );
+      vy  = _mm_add_epi32( vy,  _mm_madd_epi16( vrec, vone ) );
+      vxx = _mm_add_epi32( vxx, _mm_madd_epi16( vref, vref ) );
+      vxy = _mm_add_epi32( vxy, _mm_madd_epi16( vref, vrec ) );
+    }
+    if( k < numSteps )
+    {
+      __m128i vref = _mm_sra_epi16( _mm_loadl_epi64( ( const __m128i* ) &ref[k] ), vshift );
+      __m128i vrec = _mm_sra_epi16( _mm_loadl_epi64( ( const __m128i* ) &rec[k] ), vshift );
+      vx  = _mm_add_epi32( vx,  _mm_madd_epi16( vref, vone ) );
+      vy  = _mm_add_epi32( vy,  _mm_madd_epi16( vrec, vone ) );
+      vxx = _mm_add_epi32( vxx, _mm_madd_epi16( vref, vref ) );
+      vxy = _mm_add_epi32( vxy, _mm_madd_epi16( vref, vrec ) );
+    }
+  }
+
+  // reduce the four accumulators at once, lane i of the result holds the sum of x, y, xx and xy respectively
+  __m128i vsum = _mm_hadd_epi32( _mm_hadd_epi32( vx, vy ), _mm_hadd_epi32( vxx, vxy ) );
+  x  += _mm_extract_epi32( vsum, 0 );
+  y  += _mm_extract_epi32( vsum, 1 );
+  xx += _mm_extract_epi32( vsum, 2 );
+  xy += _mm_extract_epi32( vsum, 3 );
+}
+
+template<X86_VEXT vext>
+static void simdBlendOBMC( Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, int dir, int numLines, bool subtract )
+{
+  if( width & 3 )
+  {
+    InterPrediction::blendOBMC( dst, dstStride, src, srcStride, width, height, dir, numLines, subtract );
+    return;
+  }
+
+  // both operations are written as ( A_k * dst + B_k * src + 16 ) >> 5 for line k, with A_k = 32 -/+ 8 >> k and B_k = +/- 8 >> k,
+  // and evaluated by madd on interleaved dst and src samples, lines outside the blended range use A = 32 and B = 0
+  const __m128i voffset = _mm_set1_epi32( 16 );
+
+  if( dir == 0 || dir == 2 )
+  {
+    for( int k = 0; k < numLines; k++ )
+    {
+      const int     line = dir == 0 ? k : height - 1 - k;
+      const int16_t w    = 8 >> k;
+      Pel*          d    = dst + line * dstStride;
+      const Pel*    s    = src + line * srcStride;
+      const __m128i vcoeff = _mm_unpacklo_epi16( _mm_set1_epi16( subtract ? 32 + w : 32 - w ), _mm_set1_epi16( subtract ? -w : w ) );
+      int x = 0;
+
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256i vcoeff256  = _mm256_broadcastsi128_si256( vcoeff );
+        const __m256i voffset256 = _mm256_set1_epi32( 16 );
+
+        for( ; x + 16 <= width; x += 16 )
+        {
+          __m256i vd = _mm256_loadu_si256( ( const __m256i* ) &d[x] );
+          __m256i vs = _mm256_loadu_si256( ( const __m256i* ) &s[x] );
+          __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vd, vs ), vcoeff256 ), voffset256 ), 5 );
+          __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vd, vs ), vcoeff256 ), voffset256 ), 5 );
+          _mm256_storeu_si256( ( __m256i* ) &d[x], _mm256_packs_epi32( lo, hi ) );
+        }
+      }
+#endif
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m128i vd = _mm_loadu_si128( ( const __m128i* ) &d[x] );
+        __m128i vs = _mm_loadu_si128( ( const __m128i* ) &s[x] );
+        __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vd, vs ), vcoeff ), voffset ), 5 );
+        __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vd, vs ), vcoeff ), voffset ), 5 );
+        _mm_storeu_si128( ( __m128i* ) &d[x], _mm_packs_epi32( lo, hi ) );
+      }
+      if( x < width )
+      {
+        __m128i vd = _mm_loadl_epi64( ( const __m128i* ) &d[x] );
+        __m128i vs = _mm_loadl_epi64( ( const __m128i* ) &s[x] );
+        __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vd, vs ), vcoeff ), voffset ), 5 );
+        _mm_storel_epi64( ( __m128i* ) &d[x], _mm_packs_epi32( lo, lo ) );
+      }
+    }
+  }
+  else
+  {
+    // the four samples next to the left or right boundary of a row are blended at once, each lane with the weights of its line
+    int16_t coeff[8];
+
+    for( int j = 0; j < 4; j++ )
+    {
+      const int     k = dir == 1 ? j : 3 - j;
+      const int16_t w = k < numLines ? 8 >> k : 0;
+      coeff[2 * j    ] = subtract ? 32 + w : 32 - w;
+      coeff[2 * j + 1] = subtract ? -w : w;
+    }
+
+    const __m128i vcoeff = _mm_loadu_si128( ( const __m128i* ) coeff );
+    const int     x0     = dir == 1 ? 0 : width - 4;
+
+    for( int y = 0; y < height; y++ )
+    {
+      __m128i vd = _mm_loadl_epi64( ( const __m128i* ) &dst[x0] );
+      __m128i vs = _mm_loadl_epi64( ( const __m128i* ) &src[x0] );
+      __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vd, vs ), vcoeff ), voffset ), 5 );
+      _mm_storel_epi64( ( __m128i* ) &dst[x0], _mm_packs_epi32( lo, lo ) );
+
+      dst += dstStride;
+      src += srcStride;
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void InterPrediction::_initInterPredictionX86()
+{
+#if ENABLE_SIMD_OPT_BIO
+  bioGradFilter      = simdGradFilter<vext>;
+  bioDotProducts     = simdDotProducts<vext>;
+  bioCalcBlkGradient = simdCalcBlkGradient<vext>;
+#endif
+#if ENABLE_SIMD_OPT_LIC
+  licCalcSums        = simdCalcLICSums<vext>;
+#endif
+#if ENABLE_SIMD_OPT_OBMC
+  obmcBlend          = simdBlendOBMC<vext>;
+#endif
+}
+
+template void InterPrediction::_initInterPredictionX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,526 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD functions of the intra prediction class
+*/
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+#include "../Rom.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static void simdPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  if( width < 4 )
+  {
+    IntraPrediction::xPredIntraPlanarCore( pSrc, pDst );
+    return;
+  }
+
+  const int log2W      = g_aucLog2[width];
+  const int log2H      = g_aucLog2[height];
+  const int topRight   = pSrc.at( width + 1, 0 );
+  const int bottomLeft = pSrc.at( 0, height + 1 );
+
+  // the vertical predictions and their increments per row
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int vertPred [MAX_CU_SIZE] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int bottomRow[MAX_CU_SIZE] );
+
+  const Pel*    top    = pSrc.buf + 1;
+  const __m128i vLog2W = _mm_cvtsi32_si128( log2W );
+  const __m128i vLog2H = _mm_cvtsi32_si128( log2H );
+  const __m128i vShift = _mm_cvtsi32_si128( 1 + log2W + log2H );
+
+  for( int x = 0; x < width; x += 4 )
+  {
+    __m128i vtop = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &top[x] ) );
+    _mm_storeu_si128( ( __m128i* ) &vertPred [x], _mm_sll_epi32( vtop, vLog2H ) );
+    _mm_storeu_si128( ( __m128i* ) &bottomRow[x], _mm_sub_epi32( _mm_set1_epi32( bottomLeft ), vtop ) );
+  }
+
+  Pel* pred = pDst.buf;
+
+  for( int y = 0; y < height; y++, pred += pDst.stride )
+  {
+    // the horizontal prediction is ( width - 1 - x ) * left + ( x + 1 ) * topRight
+    const int left = pSrc.at( 0, y + 1 );
+    int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vLeft   = _mm256_set1_epi32( left << log2W );
+      const __m256i vRight  = _mm256_set1_epi32( topRight - left );
+      const __m256i vOffset = _mm256_set1_epi32( width * height );
+
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m256i vx   = _mm256_setr_epi32( x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7, x + 8 );
+        __m256i vhor = _mm256_add_epi32( vLeft, _mm256_mullo_epi32( vx, vRight ) );
+        __m256i vver = _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &vertPred[x] ), _mm256_loadu_si256( ( const __m256i* ) &bottomRow[x] ) );
+        _mm256_storeu_si256( ( __m256i* ) &vertPred[x], vver );
+
+        __m256i vres = _mm256_add_epi32( _mm256_sll_epi32( vhor, vLog2H ), _mm256_sll_epi32( vver, vLog2W ) );
+        vres = _mm256_sra_epi32( _mm256_add_epi32( vres, vOffset ), vShift );
+        vres = _mm256_permute4x64_epi64( _mm256_packs_epi32( vres, vres ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) &pred[x], _mm256_castsi256_si128( vres ) );
+      }
+    }
+#endif
+    const __m128i vLeft   = _mm_set1_epi32( left << log2W );
+    const __m128i vRight  = _mm_set1_epi32( topRight - left );
+    const __m128i vOffset = _mm_set1_epi32( width * height );
+
+    for( ; x < width; x += 4 )
+    {
+      __m128i vx   = _mm_setr_epi32( x + 1, x + 2, x + 3, x + 4 );
+      __m128i vhor = _mm_add_epi32( vLeft, _mm_mullo_epi32( vx, vRight ) );
+      __m128i vver = _mm_add_epi32( _mm_loadu_si128( ( const __m128i* ) &vertPred[x] ), _mm_loadu_si128( ( const __m128i* ) &bottomRow[x] ) );
+      _mm_storeu_si128( ( __m128i* ) &vertPred[x], vver );
+
+      __m128i vres = _mm_add_epi32( _mm_sll_epi32( vhor, vLog2H ), _mm_sll_epi32( vver, vLog2W ) );
+      vres = _mm_sra_epi32( _mm_add_epi32( vres, vOffset ), vShift );
+      _mm_storel_epi64( ( __m128i* ) &pred[x], _mm_packs_epi32( vres, vres ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  if( width < 4 )
+  {
+    IntraPrediction::xPredIntraDcCore( pSrc, pDst );
+    return;
+  }
+
+#if JVET_K0122
+  const bool useTop  = width >= height;
+  const bool useLeft = width <= height;
+#else
+  const bool useTop  = true;
+  const bool useLeft = true;
+#endif
+  int sum = 0;
+
+  if( useTop )
+  {
+    const Pel*    top  = pSrc.buf + 1;
+    const __m128i vone = _mm_set1_epi16( 1 );
+    __m128i       vsum = _mm_setzero_si128();
+
+    if( width == 4 )
+    {
+      vsum = _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* ) top ), vone );
+    }
+    else
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &top[x] ), vone ) );
+      }
+    }
+
+    vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0x4e ) );
+    vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0xb1 ) );
+    sum += _mm_cvtsi128_si32( vsum );
+  }
+
+  if( useLeft )
+  {
+    for( int y = 0; y < height; y++ )
+    {
+      sum += pSrc.at( 0, 1 + y );
+    }
+  }
+
+#if JVET_K0122
+  const int denom = ( width == height ) ? ( width << 1 ) : std::max( width, height );
+  const Pel dcVal = ( sum + ( denom >> 1 ) ) >> g_aucLog2[denom];
+#else
+  const Pel dcVal = ( sum + ( ( width + height ) >> 1 ) ) / ( width + height );
+#endif
+  const __m128i vdc = _mm_set1_epi16( dcVal );
+  Pel*          dst = pDst.buf;
+
+  for( int y = 0; y < height; y++, dst += pDst.stride )
+  {
+    if( width == 4 )
+    {
+      _mm_storel_epi64( ( __m128i* ) dst, vdc );
+      continue;
+    }
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[x], vdc );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngLinear( Pel* pDst, const Pel* pRef, const int width, const int deltaFract )
+{
+  if( width < 4 )
+  {
+    IntraPrediction::xPredIntraAngLinearCore( pDst, pRef, width, deltaFract );
+    return;
+  }
+
+  const int16_t w0 = 32 - deltaFract;
+  const int16_t w1 = deltaFract;
+  int x = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vw      = _mm256_setr_epi16( w0, w1, w0, w1, w0, w1, w0, w1, w0, w1, w0, w1, w0, w1, w0, w1 );
+    const __m256i voffset = _mm256_set1_epi32( 16 );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      __m256i va = _mm256_loadu_si256( ( const __m256i* ) &pRef[x] );
+      __m256i vb = _mm256_loadu_si256( ( const __m256i* ) &pRef[x + 1] );
+      __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( va, vb ), vw ), voffset ), 5 );
+      __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( va, vb ), vw ), voffset ), 5 );
+      _mm256_storeu_si256( ( __m256i* ) &pDst[x], _mm256_packs_epi32( lo, hi ) );
+    }
+  }
+#endif
+  const __m128i vw      = _mm_setr_epi16( w0, w1, w0, w1, w0, w1, w0, w1 );
+  const __m128i voffset = _mm_set1_epi32( 16 );
+
+  for( ; x + 8 <= width; x += 8 )
+  {
+    __m128i va = _mm_loadu_si128( ( const __m128i* ) &pRef[x] );
+    __m128i vb = _mm_loadu_si128( ( const __m128i* ) &pRef[x + 1] );
+    __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vw ), voffset ), 5 );
+    __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), vw ), voffset ), 5 );
+    _mm_storeu_si128( ( __m128i* ) &pDst[x], _mm_packs_epi32( lo, hi ) );
+  }
+
+  if( x < width )
+  {
+    __m128i va = _mm_loadl_epi64( ( const __m128i* ) &pRef[x] );
+    __m128i vb = _mm_loadl_epi64( ( const __m128i* ) &pRef[x + 1] );
+    __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), vw ), voffset ), 5 );
+    _mm_storel_epi64( ( __m128i* ) &pDst[x], _mm_packs_epi32( lo, lo ) );
+  }
+}
+
+#if JEM_TOOLS
+template<X86_VEXT vext>
+static void simdPredIntraAng4Tap( Pel* pDst, const Pel* pRef, const int width, const int* filter, const bool useClip, const ClpRng& clpRng )
+{
+  if( width < 4 )
+  {
+    IntraPrediction::xPredIntraAng4TapCore( pDst, pRef, width, filter, useClip, clpRng );
+    return;
+  }
+
+  const int16_t f0 = filter[0], f1 = filter[1], f2 = filter[2], f3 = filter[3];
+  const __m128i vf01    = _mm_setr_epi16( f0, f1, f0, f1, f0, f1, f0, f1 );
+  const __m128i vf23    = _mm_setr_epi16( f2, f3, f2, f3, f2, f3, f2, f3 );
+  const __m128i voffset = _mm_set1_epi32( 128 );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  if( width == 4 )
+  {
+    // the outer taps repeat the first and the last sample
+    __m128i p1 = _mm_loadl_epi64( ( const __m128i* ) &pRef[0] );
+    __m128i p2 = _mm_loadl_epi64( ( const __m128i* ) &pRef[1] );
+    __m128i p0 = _mm_insert_epi16( _mm_slli_si128( p1, 2 ), pRef[0], 0 );
+    __m128i p3 = _mm_insert_epi16( _mm_srli_si128( p2, 2 ), pRef[4], 3 );
+
+    __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), vf01 ), _mm_madd_epi16( _mm_unpacklo_epi16( p2, p3 ), vf23 ) );
+    lo = _mm_srai_epi32( _mm_add_epi32( lo, voffset ), 8 );
+
+    __m128i res = _mm_packs_epi32( lo, lo );
+    if( useClip )
+    {
+      res = _mm_min_epi16( vmax, _mm_max_epi16( vmin, res ) );
+    }
+    _mm_storel_epi64( ( __m128i* ) pDst, res );
+    return;
+  }
+
+  for( int x = 0; x < width; x += 8 )
+  {
+    // the outer taps repeat the first and the last sample
+    __m128i p1 = _mm_loadu_si128( ( const __m128i* ) &pRef[x] );
+    __m128i p2 = _mm_loadu_si128( ( const __m128i* ) &pRef[x + 1] );
+    __m128i p0 = x == 0           ? _mm_insert_epi16( _mm_slli_si128( p1, 2 ), pRef[0], 0 )     : _mm_loadu_si128( ( const __m128i* ) &pRef[x - 1] );
+    __m128i p3 = x + 8 == width   ? _mm_insert_epi16( _mm_srli_si128( p2, 2 ), pRef[width], 7 ) : _mm_loadu_si128( ( const __m128i* ) &pRef[x + 2] );
+
+    __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), vf01 ), _mm_madd_epi16( _mm_unpacklo_epi16( p2, p3 ), vf23 ) );
+    __m128i hi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( p0, p1 ), vf01 ), _mm_madd_epi16( _mm_unpackhi_epi16( p2, p3 ), vf23 ) );
+    lo = _mm_srai_epi32( _mm_add_epi32( lo, voffset ), 8 );
+    hi = _mm_srai_epi32( _mm_add_epi32( hi, voffset ), 8 );
+
+    __m128i res = _mm_packs_epi32( lo, hi );
+    if( useClip )
+    {
+      res = _mm_min_epi16( vmax, _mm_max_epi16( vmin, res ) );
+    }
+    _mm_storeu_si128( ( __m128i* ) &pDst[x], res );
+  }
+}
+#endif
+
+#if JVET_K0063_PDPC_SIMP
+template<X86_VEXT vext>
+static void simdFilterPDPC( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const ClpRng& clpRng )
+{
+  const int width  = dstBuf.width;
+  const int height = dstBuf.height;
+
+  if( width < 4 )
+  {
+    IntraPrediction::xFilterPDPCCore( srcBuf, dstBuf, uiDirMode, clpRng );
+    return;
+  }
+
+  // all modes are written as
+  //   ( wL * left + wT * top - wTL * topLeft + ( 64 - wL - wT + wTL ) * cur + 32 ) >> 6
+  // with wL = 0 for HOR_IDX, wT = 0 for VER_IDX and wTL = 0 for PLANAR_IDX, the top-left weight being the sum of a
+  // part depending on the column and one depending on the row
+  const int scale = ( ( g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2 ) >> 2 );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int16_t wLCol [MAX_CU_SIZE] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int16_t wTLCol[MAX_CU_SIZE] );
+
+  for( int x = 0; x < width; x++ )
+  {
+    const int w = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+    wLCol [x] = uiDirMode == HOR_IDX ? 0 : w;
+    wTLCol[x] = uiDirMode == DC_IDX ? w >> 4 : uiDirMode == VER_IDX ? w : 0;
+  }
+
+  const Pel*    top     = srcBuf.buf + 1;
+  const Pel     topLeft = srcBuf.at( 0, 0 );
+  const __m128i v64     = _mm_set1_epi16( 64 );
+  const __m128i voffset = _mm_set1_epi32( 32 );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++ )
+  {
+    const int w      = 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    const int wT     = uiDirMode == VER_IDX ? 0 : w;
+    const int wTLRow = uiDirMode == DC_IDX ? w >> 4 : uiDirMode == HOR_IDX ? w : 0;
+
+    const __m128i vLeftTL = _mm_unpacklo_epi16( _mm_set1_epi16( srcBuf.at( 0, y + 1 ) ), _mm_set1_epi16( topLeft ) );
+    const __m128i vwT     = _mm_set1_epi16( wT );
+    const __m128i vwTLRow = _mm_set1_epi16( wTLRow );
+    Pel*          dst     = dstBuf.buf + y * dstBuf.stride;
+
+    for( int x = 0; x < width; x += 8 )
+    {
+      __m128i vwL   = _mm_loadu_si128( ( const __m128i* ) &wLCol [x] );
+      __m128i vwTL  = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &wTLCol[x] ), vwTLRow );
+      __m128i vwCur = _mm_sub_epi16( _mm_add_epi16( _mm_sub_epi16( v64, vwL ), vwTL ), vwT );
+      __m128i vwLTL = _mm_sub_epi16( _mm_setzero_si128(), vwTL );
+      __m128i vtop  = width == 4 ? _mm_loadl_epi64( ( const __m128i* ) &top[x] ) : _mm_loadu_si128( ( const __m128i* ) &top[x] );
+      __m128i vcur  = width == 4 ? _mm_loadl_epi64( ( const __m128i* ) &dst[x] ) : _mm_loadu_si128( ( const __m128i* ) &dst[x] );
+
+      __m128i lo = _mm_add_epi32( _mm_madd_epi16( vLeftTL, _mm_unpacklo_epi16( vwL, vwLTL ) ), _mm_madd_epi16( _mm_unpacklo_epi16( vtop, vcur ), _mm_unpacklo_epi16( vwT, vwCur ) ) );
+      __m128i hi = _mm_add_epi32( _mm_madd_epi16( vLeftTL, _mm_unpackhi_epi16( vwL, vwLTL ) ), _mm_madd_epi16( _mm_unpackhi_epi16( vtop, vcur ), _mm_unpackhi_epi16( vwT, vwCur ) ) );
+      lo = _mm_srai_epi32( _mm_add_epi32( lo, voffset ), 6 );
+      hi = _mm_srai_epi32( _mm_add_epi32( hi, voffset ), 6 );
+
+      __m128i res = _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( lo, hi ) ) );
+
+      if( width == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) &dst[x], res );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], res );
+      }
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdFilterReferenceRow( const Pel* pSrc, Pel* pDst, const int length )
+{
+  // ( a + 2 * b + c + 2 ) >> 2 is computed as the rounded average of b and the truncated average of a and c
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vone = _mm256_set1_epi16( 1 );
+
+    for( ; i + 16 <= length; i += 16 )
+    {
+      __m256i va = _mm256_loadu_si256( ( const __m256i* ) &pSrc[i - 1] );
+      __m256i vb = _mm256_loadu_si256( ( const __m256i* ) &pSrc[i] );
+      __m256i vc = _mm256_loadu_si256( ( const __m256i* ) &pSrc[i + 1] );
+      __m256i vt = _mm256_sub_epi16( _mm256_avg_epu16( va, vc ), _mm256_and_si256( _mm256_xor_si256( va, vc ), vone ) );
+      _mm256_storeu_si256( ( __m256i* ) &pDst[i], _mm256_avg_epu16( vt, vb ) );
+    }
+  }
+#endif
+  const __m128i vone = _mm_set1_epi16( 1 );
+
+  for( ; i + 8 <= length; i += 8 )
+  {
+    __m128i va = _mm_loadu_si128( ( const __m128i* ) &pSrc[i - 1] );
+    __m128i vb = _mm_loadu_si128( ( const __m128i* ) &pSrc[i] );
+    __m128i vc = _mm_loadu_si128( ( const __m128i* ) &pSrc[i + 1] );
+    __m128i vt = _mm_sub_epi16( _mm_avg_epu16( va, vc ), _mm_and_si128( _mm_xor_si128( va, vc ), vone ) );
+    _mm_storeu_si128( ( __m128i* ) &pDst[i], _mm_avg_epu16( vt, vb ) );
+  }
+
+  for( ; i < length; i++ )
+  {
+    pDst[i] = ( pSrc[i + 1] + 2 * pSrc[i] + pSrc[i - 1] + 2 ) >> 2;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdTransposeBlock( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  if( ( width & 7 ) == 0 && ( height & 7 ) == 0 )
+  {
+    for( int y = 0; y < height; y += 8 )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        const Pel* src = pSrc + y * srcStride + x;
+        Pel*       dst = pDst + x * dstStride + y;
+
+        __m128i r0 = _mm_loadu_si128( ( const __m128i* ) &src[0 * srcStride] );
+        __m128i r1 = _mm_loadu_si128( ( const __m128i* ) &src[1 * srcStride] );
+        __m128i r2 = _mm_loadu_si128( ( const __m128i* ) &src[2 * srcStride] );
+        __m128i r3 = _mm_loadu_si128( ( const __m128i* ) &src[3 * srcStride] );
+        __m128i r4 = _mm_loadu_si128( ( const __m128i* ) &src[4 * srcStride] );
+        __m128i r5 = _mm_loadu_si128( ( const __m128i* ) &src[5 * srcStride] );
+        __m128i r6 = _mm_loadu_si128( ( const __m128i* ) &src[6 * srcStride] );
+        __m128i r7 = _mm_loadu_si128( ( const __m128i* ) &src[7 * srcStride] );
+
+        __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+        __m128i t1 = _mm_unpackhi_epi16( r0, r1 );
+        __m128i t2 = _mm_unpacklo_epi16( r2, r3 );
+        __m128i t3 = _mm_unpackhi_epi16( r2, r3 );
+        __m128i t4 = _mm_unpacklo_epi16( r4, r5 );
+        __m128i t5 = _mm_unpackhi_epi16( r4, r5 );
+        __m128i t6 = _mm_unpacklo_epi16( r6, r7 );
+        __m128i t7 = _mm_unpackhi_epi16( r6, r7 );
+
+        __m128i u0 = _mm_unpacklo_epi32( t0, t2 );
+        __m128i u1 = _mm_unpackhi_epi32( t0, t2 );
+        __m128i u2 = _mm_unpacklo_epi32( t1, t3 );
+        __m128i u3 = _mm_unpackhi_epi32( t1, t3 );
+        __m128i u4 = _mm_unpacklo_epi32( t4, t6 );
+        __m128i u5 = _mm_unpackhi_epi32( t4, t6 );
+        __m128i u6 = _mm_unpacklo_epi32( t5, t7 );
+        __m128i u7 = _mm_unpackhi_epi32( t5, t7 );
+
+        _mm_storeu_si128( ( __m128i* ) &dst[0 * dstStride], _mm_unpacklo_epi64( u0, u4 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[1 * dstStride], _mm_unpackhi_epi64( u0, u4 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[2 * dstStride], _mm_unpacklo_epi64( u1, u5 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[3 * dstStride], _mm_unpackhi_epi64( u1, u5 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[4 * dstStride], _mm_unpacklo_epi64( u2, u6 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[5 * dstStride], _mm_unpackhi_epi64( u2, u6 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[6 * dstStride], _mm_unpacklo_epi64( u3, u7 ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[7 * dstStride], _mm_unpackhi_epi64( u3, u7 ) );
+      }
+    }
+  }
+  else if( ( width & 3 ) == 0 && ( height & 3 ) == 0 )
+  {
+    for( int y = 0; y < height; y += 4 )
+    {
+      for( int x = 0; x < width; x += 4 )
+      {
+        const Pel* src = pSrc + y * srcStride + x;
+        Pel*       dst = pDst + x * dstStride + y;
+
+        __m128i t0 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[0 * srcStride] ), _mm_loadl_epi64( ( const __m128i* ) &src[1 * srcStride] ) );
+        __m128i t1 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[2 * srcStride] ), _mm_loadl_epi64( ( const __m128i* ) &src[3 * srcStride] ) );
+        __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+        __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+
+        _mm_storel_epi64( ( __m128i* ) &dst[0 * dstStride], u0 );
+        _mm_storel_epi64( ( __m128i* ) &dst[1 * dstStride], _mm_srli_si128( u0, 8 ) );
+        _mm_storel_epi64( ( __m128i* ) &dst[2 * dstStride], u1 );
+        _mm_storel_epi64( ( __m128i* ) &dst[3 * dstStride], _mm_srli_si128( u1, 8 ) );
+      }
+    }
+  }
+  else
+  {
+    IntraPrediction::xTransposeBlockCore( pSrc, srcStride, pDst, dstStride, width, height );
+  }
+}
+
+template<X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraPlanar    = simdPredIntraPlanar<vext>;
+  m_predIntraDc        = simdPredIntraDc<vext>;
+  m_predIntraAngLinear = simdPredIntraAngLinear<vext>;
+#if JEM_TOOLS
+  m_predIntraAng4Tap   = simdPredIntraAng4Tap<vext>;
+#endif
+#if JVET_K0063_PDPC_SIMP
+  m_filterPDPC         = simdFilterPDPC<vext>;
+#endif
+  m_filterReferenceRow = simdFilterReferenceRow<vext>;
+  m_transposeBlock     = simdTransposeBlock<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
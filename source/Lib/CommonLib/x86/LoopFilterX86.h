@@ -0,0 +1,418 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    SIMD functions of the deblocking filter class
+*/
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// the 16-bit intermediate sums of the kernels are exact up to this sample bit depth
+#define DBLF_SIMD_MAX_BIT_DEPTH 12
+
+static inline void simdTranspose8x8( __m128i* r )
+{
+  const __m128i a0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i a1 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i a2 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i a3 = _mm_unpackhi_epi16( r[2], r[3] );
+  const __m128i a4 = _mm_unpacklo_epi16( r[4], r[5] );
+  const __m128i a5 = _mm_unpackhi_epi16( r[4], r[5] );
+  const __m128i a6 = _mm_unpacklo_epi16( r[6], r[7] );
+  const __m128i a7 = _mm_unpackhi_epi16( r[6], r[7] );
+
+  const __m128i b0 = _mm_unpacklo_epi32( a0, a2 );
+  const __m128i b1 = _mm_unpackhi_epi32( a0, a2 );
+  const __m128i b2 = _mm_unpacklo_epi32( a1, a3 );
+  const __m128i b3 = _mm_unpackhi_epi32( a1, a3 );
+  const __m128i b4 = _mm_unpacklo_epi32( a4, a6 );
+  const __m128i b5 = _mm_unpackhi_epi32( a4, a6 );
+  const __m128i b6 = _mm_unpacklo_epi32( a5, a7 );
+  const __m128i b7 = _mm_unpackhi_epi32( a5, a7 );
+
+  r[0] = _mm_unpacklo_epi64( b0, b4 );
+  r[1] = _mm_unpackhi_epi64( b0, b4 );
+  r[2] = _mm_unpacklo_epi64( b1, b5 );
+  r[3] = _mm_unpackhi_epi64( b1, b5 );
+  r[4] = _mm_unpacklo_epi64( b2, b6 );
+  r[5] = _mm_unpackhi_epi64( b2, b6 );
+  r[6] = _mm_unpacklo_epi64( b3, b7 );
+  r[7] = _mm_unpackhi_epi64( b3, b7 );
+}
+
+static inline __m128i simdClip3( const __m128i minVal, const __m128i maxVal, const __m128i val )
+{
+  return _mm_min_epi16( _mm_max_epi16( val, minVal ), maxVal );
+}
+
+// filters up to two segments of four lines, one line per 16-bit lane, v[0..7] hold the samples p3..q3 of the lines,
+// returns false if no sample is changed
+template<X86_VEXT vext>
+static bool simdFilterLumaLines( __m128i* v, const DeblockSegment* segments, const int numSegments, const ClpRng& clpRng )
+{
+  const __m128i p3 = v[0], p2 = v[1], p1 = v[2], p0 = v[3];
+  const __m128i q0 = v[4], q1 = v[5], q2 = v[6], q3 = v[7];
+
+  // per line decision measures, only the first and last line of each segment are used
+  int16_t dp[8], dq[8], dStrong[8], dEdge[8];
+  _mm_storeu_si128( ( __m128i* ) dp,      _mm_abs_epi16( _mm_sub_epi16( _mm_add_epi16( p2, p0 ), _mm_add_epi16( p1, p1 ) ) ) );
+  _mm_storeu_si128( ( __m128i* ) dq,      _mm_abs_epi16( _mm_sub_epi16( _mm_add_epi16( q2, q0 ), _mm_add_epi16( q1, q1 ) ) ) );
+  _mm_storeu_si128( ( __m128i* ) dStrong, _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( p3, p0 ) ), _mm_abs_epi16( _mm_sub_epi16( q3, q0 ) ) ) );
+  _mm_storeu_si128( ( __m128i* ) dEdge,   _mm_abs_epi16( _mm_sub_epi16( p0, q0 ) ) );
+
+  int16_t tc[8] = { 0 }, thrCut[8] = { 0 };
+  int16_t maskStrong[8] = { 0 }, maskFilterP[8] = { 0 }, maskFilterQ[8] = { 0 }, maskNoP[8] = { 0 }, maskNoQ[8] = { 0 };
+  bool    filtered = false;
+
+  for( int s = 0; s < numSegments; s++ )
+  {
+    const DeblockSegment& segment = segments[s];
+    const int l0 = 4 * s, l3 = 4 * s + 3;
+
+    const int d0 = dp[l0] + dq[l0];
+    const int d3 = dp[l3] + dq[l3];
+
+    if( segment.tc == 0 || d0 + d3 >= segment.beta )
+    {
+      continue;
+    }
+
+    const int  sideThreshold = ( segment.beta + ( segment.beta >> 1 ) ) >> 3;
+    const int  edgeThreshold = ( segment.tc * 5 + 1 ) >> 1;
+    const bool sw = dStrong[l0] < ( segment.beta >> 3 ) && 2 * d0 < ( segment.beta >> 2 ) && dEdge[l0] < edgeThreshold
+                 && dStrong[l3] < ( segment.beta >> 3 ) && 2 * d3 < ( segment.beta >> 2 ) && dEdge[l3] < edgeThreshold;
+
+    for( int l = l0; l <= l3; l++ )
+    {
+      tc         [l] = segment.tc;
+      thrCut     [l] = segment.tc * 10;
+      maskStrong [l] = sw ? -1 : 0;
+      maskFilterP[l] = dp[l0] + dp[l3] < sideThreshold ? -1 : 0;
+      maskFilterQ[l] = dq[l0] + dq[l3] < sideThreshold ? -1 : 0;
+      maskNoP    [l] = segment.partPNoFilter ? -1 : 0;
+      maskNoQ    [l] = segment.partQNoFilter ? -1 : 0;
+    }
+    filtered = true;
+  }
+
+  if( !filtered )
+  {
+    return false;
+  }
+
+  const __m128i vtc     = _mm_loadu_si128( ( const __m128i* ) tc );
+  const __m128i vthrCut = _mm_loadu_si128( ( const __m128i* ) thrCut );
+  const __m128i mStrong = _mm_loadu_si128( ( const __m128i* ) maskStrong );
+  const __m128i mFiltP  = _mm_loadu_si128( ( const __m128i* ) maskFilterP );
+  const __m128i mFiltQ  = _mm_loadu_si128( ( const __m128i* ) maskFilterQ );
+  const __m128i mNoP    = _mm_loadu_si128( ( const __m128i* ) maskNoP );
+  const __m128i mNoQ    = _mm_loadu_si128( ( const __m128i* ) maskNoQ );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+  const __m128i vzero   = _mm_setzero_si128();
+
+  // strong filter, the sums of up to eight samples are evaluated unsigned
+  const __m128i tc2     = _mm_add_epi16( vtc, vtc );
+  const __m128i two     = _mm_set1_epi16( 2 );
+  const __m128i four    = _mm_set1_epi16( 4 );
+  const __m128i sumP    = _mm_add_epi16( _mm_add_epi16( p2, p1 ), _mm_add_epi16( p0, q0 ) );
+  const __m128i sumQ    = _mm_add_epi16( _mm_add_epi16( p0, q0 ), _mm_add_epi16( q1, q2 ) );
+  const __m128i sumP0   = _mm_add_epi16( _mm_add_epi16( p1, p0 ), q0 );
+  const __m128i sumQ0   = _mm_add_epi16( _mm_add_epi16( p0, q0 ), q1 );
+
+  __m128i p0s = _mm_srli_epi16( _mm_add_epi16( _mm_add_epi16( p2, q1 ), _mm_add_epi16( _mm_add_epi16( sumP0, sumP0 ), four ) ), 3 );
+  __m128i q0s = _mm_srli_epi16( _mm_add_epi16( _mm_add_epi16( p1, q2 ), _mm_add_epi16( _mm_add_epi16( sumQ0, sumQ0 ), four ) ), 3 );
+  __m128i p1s = _mm_srli_epi16( _mm_add_epi16( sumP, two ), 2 );
+  __m128i q1s = _mm_srli_epi16( _mm_add_epi16( sumQ, two ), 2 );
+  __m128i p2s = _mm_srli_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( p3, p3 ), _mm_add_epi16( p2, p2 ) ), _mm_add_epi16( sumP, four ) ), 3 );
+  __m128i q2s = _mm_srli_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( q3, q3 ), _mm_add_epi16( q2, q2 ) ), _mm_add_epi16( sumQ, four ) ), 3 );
+
+  p0s = simdClip3( _mm_sub_epi16( p0, tc2 ), _mm_add_epi16( p0, tc2 ), p0s );
+  q0s = simdClip3( _mm_sub_epi16( q0, tc2 ), _mm_add_epi16( q0, tc2 ), q0s );
+  p1s = simdClip3( _mm_sub_epi16( p1, tc2 ), _mm_add_epi16( p1, tc2 ), p1s );
+  q1s = simdClip3( _mm_sub_epi16( q1, tc2 ), _mm_add_epi16( q1, tc2 ), q1s );
+  p2s = simdClip3( _mm_sub_epi16( p2, tc2 ), _mm_add_epi16( p2, tc2 ), p2s );
+  q2s = simdClip3( _mm_sub_epi16( q2, tc2 ), _mm_add_epi16( q2, tc2 ), q2s );
+
+  // weak filter, delta = ( 9 * ( q0 - p0 ) - 3 * ( q1 - p1 ) + 8 ) >> 4 is evaluated in 32 bits
+  const __m128i coeff   = _mm_setr_epi16( 9, -3, 9, -3, 9, -3, 9, -3 );
+  const __m128i diff0   = _mm_sub_epi16( q0, p0 );
+  const __m128i diff1   = _mm_sub_epi16( q1, p1 );
+  const __m128i eight   = _mm_set1_epi32( 8 );
+  const __m128i deltaLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( diff0, diff1 ), coeff ), eight ), 4 );
+  const __m128i deltaHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( diff0, diff1 ), coeff ), eight ), 4 );
+  __m128i       delta   = _mm_packs_epi32( deltaLo, deltaHi );
+  const __m128i mWeakOn = _mm_cmpgt_epi16( vthrCut, _mm_abs_epi16( delta ) );
+
+  delta = simdClip3( _mm_sub_epi16( vzero, vtc ), vtc, delta );
+
+  const __m128i p0w     = simdClip3( vmin, vmax, _mm_add_epi16( p0, delta ) );
+  const __m128i q0w     = simdClip3( vmin, vmax, _mm_sub_epi16( q0, delta ) );
+  const __m128i tcHalf  = _mm_srai_epi16( vtc, 1 );
+  const __m128i tcHalfN = _mm_sub_epi16( vzero, tcHalf );
+  const __m128i delta1  = simdClip3( tcHalfN, tcHalf, _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( _mm_avg_epu16( p2, p0 ), p1 ), delta ), 1 ) );
+  const __m128i delta2  = simdClip3( tcHalfN, tcHalf, _mm_srai_epi16( _mm_sub_epi16( _mm_sub_epi16( _mm_avg_epu16( q2, q0 ), q1 ), delta ), 1 ) );
+  const __m128i p1w     = simdClip3( vmin, vmax, _mm_add_epi16( p1, delta1 ) );
+  const __m128i q1w     = simdClip3( vmin, vmax, _mm_add_epi16( q1, delta2 ) );
+
+  // lanes of unfiltered segments have a zero tc and thus a zero weak filter threshold
+  const __m128i mWeak    = _mm_andnot_si128( mStrong, mWeakOn );
+  const __m128i mStrongP = _mm_andnot_si128( mNoP, mStrong );
+  const __m128i mStrongQ = _mm_andnot_si128( mNoQ, mStrong );
+  const __m128i mWeakP   = _mm_andnot_si128( mNoP, mWeak );
+  const __m128i mWeakQ   = _mm_andnot_si128( mNoQ, mWeak );
+
+  v[1] = _mm_blendv_epi8( p2, p2s, mStrongP );
+  v[2] = _mm_blendv_epi8( _mm_blendv_epi8( p1, p1w, _mm_and_si128( mWeakP, mFiltP ) ), p1s, mStrongP );
+  v[3] = _mm_blendv_epi8( _mm_blendv_epi8( p0, p0w, mWeakP ), p0s, mStrongP );
+  v[4] = _mm_blendv_epi8( _mm_blendv_epi8( q0, q0w, mWeakQ ), q0s, mStrongQ );
+  v[5] = _mm_blendv_epi8( _mm_blendv_epi8( q1, q1w, _mm_and_si128( mWeakQ, mFiltQ ) ), q1s, mStrongQ );
+  v[6] = _mm_blendv_epi8( q2, q2s, mStrongQ );
+
+  return true;
+}
+
+template<X86_VEXT vext>
+static void simdFilterLumaEdge( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const DeblockSegment* segments, const ClpRng& clpRng )
+{
+  if( clpRng.bd > DBLF_SIMD_MAX_BIT_DEPTH )
+  {
+    LoopFilter::xFilterLumaEdgeCore( piSrc, iStride, edgeDir, numSegments, segments, clpRng );
+    return;
+  }
+
+  // two segments of four lines are filtered at once
+  for( int iSeg = 0; iSeg < numSegments; iSeg += 2 )
+  {
+    const int numSegs  = std::min( 2, numSegments - iSeg );
+    const int numLines = numSegs * 4;
+
+    if( segments[iSeg].tc == 0 && ( numSegs == 1 || segments[iSeg + 1].tc == 0 ) )
+    {
+      continue;
+    }
+
+    __m128i v[8];
+
+    if( edgeDir == EDGE_VER )
+    {
+      // the lines are rows, load the samples p3..q3 of each row and transpose them into one vector per sample position
+      Pel* src = piSrc + iSeg * 4 * iStride - 4;
+
+      for( int l = 0; l < 8; l++ )
+      {
+        v[l] = l < numLines ? _mm_loadu_si128( ( const __m128i* ) &src[l * iStride] ) : _mm_setzero_si128();
+      }
+      simdTranspose8x8( v );
+
+      if( simdFilterLumaLines<vext>( v, segments + iSeg, numSegs, clpRng ) )
+      {
+        simdTranspose8x8( v );
+
+        for( int l = 0; l < numLines; l++ )
+        {
+          _mm_storeu_si128( ( __m128i* ) &src[l * iStride], v[l] );
+        }
+      }
+    }
+    else
+    {
+      // the lines are columns, each row across the edge holds one sample position of all lines
+      Pel* src = piSrc + iSeg * 4 - 4 * iStride;
+
+      for( int k = 0; k < 8; k++ )
+      {
+        v[k] = numSegs == 2 ? _mm_loadu_si128( ( const __m128i* ) &src[k * iStride] ) : _mm_loadl_epi64( ( const __m128i* ) &src[k * iStride] );
+      }
+
+      if( simdFilterLumaLines<vext>( v, segments + iSeg, numSegs, clpRng ) )
+      {
+        for( int k = 1; k < 7; k++ )
+        {
+          if( numSegs == 2 )
+          {
+            _mm_storeu_si128( ( __m128i* ) &src[k * iStride], v[k] );
+          }
+          else
+          {
+            _mm_storel_epi64( ( __m128i* ) &src[k * iStride], v[k] );
+          }
+        }
+      }
+    }
+  }
+}
+
+// filters up to eight lines, one line per 16-bit lane, p1..q1 hold the samples of the lines
+template<X86_VEXT vext>
+static inline void simdFilterChromaLines( const __m128i p1, __m128i& p0, __m128i& q0, const __m128i q1, const __m128i vtc, const __m128i mNoP, const __m128i mNoQ, const ClpRng& clpRng )
+{
+  const __m128i vmin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax  = _mm_set1_epi16( clpRng.max );
+
+  __m128i delta = _mm_add_epi16( _mm_slli_epi16( _mm_sub_epi16( q0, p0 ), 2 ), _mm_sub_epi16( p1, q1 ) );
+  delta = _mm_srai_epi16( _mm_add_epi16( delta, _mm_set1_epi16( 4 ) ), 3 );
+  delta = simdClip3( _mm_sub_epi16( _mm_setzero_si128(), vtc ), vtc, delta );
+
+  p0 = _mm_blendv_epi8( simdClip3( vmin, vmax, _mm_add_epi16( p0, delta ) ), p0, mNoP );
+  q0 = _mm_blendv_epi8( simdClip3( vmin, vmax, _mm_sub_epi16( q0, delta ) ), q0, mNoQ );
+}
+
+template<X86_VEXT vext>
+static void simdFilterChromaEdge( Pel* piSrc, const int iStride, const DeblockEdgeDir edgeDir, const int numSegments, const int segmentLength, const DeblockSegment* segments, const ClpRng& clpRng )
+{
+  const int numLines = numSegments * segmentLength;
+
+  if( clpRng.bd > DBLF_SIMD_MAX_BIT_DEPTH || numLines < 4 )
+  {
+    LoopFilter::xFilterChromaEdgeCore( piSrc, iStride, edgeDir, numSegments, segmentLength, segments, clpRng );
+    return;
+  }
+
+  int line = 0;
+
+  for( ; line + 4 <= numLines; )
+  {
+    const int numLanes = line + 8 <= numLines ? 8 : 4;
+
+    int16_t tc[8] = { 0 }, maskNoP[8] = { 0 }, maskNoQ[8] = { 0 };
+    bool    filtered = false;
+
+    for( int l = 0; l < numLanes; l++ )
+    {
+      const DeblockSegment& segment = segments[( line + l ) / segmentLength];
+      tc     [l] = segment.tc;
+      maskNoP[l] = segment.partPNoFilter ? -1 : 0;
+      maskNoQ[l] = segment.partQNoFilter ? -1 : 0;
+      filtered  |= segment.tc != 0;
+    }
+
+    if( filtered )
+    {
+      const __m128i vtc  = _mm_loadu_si128( ( const __m128i* ) tc );
+      const __m128i mNoP = _mm_loadu_si128( ( const __m128i* ) maskNoP );
+      const __m128i mNoQ = _mm_loadu_si128( ( const __m128i* ) maskNoQ );
+
+      if( edgeDir == EDGE_VER )
+      {
+        // the lines are rows, transpose the samples p1..q1 of the rows into one vector per sample position
+        Pel* src = piSrc + line * iStride - 2;
+        __m128i r[8];
+
+        for( int l = 0; l < 8; l++ )
+        {
+          r[l] = l < numLanes ? _mm_loadl_epi64( ( const __m128i* ) &src[l * iStride] ) : _mm_setzero_si128();
+        }
+
+        const __m128i a0 = _mm_unpacklo_epi16( r[0], r[1] );
+        const __m128i a1 = _mm_unpacklo_epi16( r[2], r[3] );
+        const __m128i a2 = _mm_unpacklo_epi16( r[4], r[5] );
+        const __m128i a3 = _mm_unpacklo_epi16( r[6], r[7] );
+        const __m128i b0 = _mm_unpacklo_epi32( a0, a1 );
+        const __m128i b1 = _mm_unpackhi_epi32( a0, a1 );
+        const __m128i b2 = _mm_unpacklo_epi32( a2, a3 );
+        const __m128i b3 = _mm_unpackhi_epi32( a2, a3 );
+
+        __m128i p0 = _mm_unpackhi_epi64( b0, b2 );
+        __m128i q0 = _mm_unpacklo_epi64( b1, b3 );
+
+        simdFilterChromaLines<vext>( _mm_unpacklo_epi64( b0, b2 ), p0, q0, _mm_unpackhi_epi64( b1, b3 ), vtc, mNoP, mNoQ, clpRng );
+
+        // write back the pairs p0, q0 of the rows
+        int32_t pairs[8];
+        _mm_storeu_si128( ( __m128i* ) &pairs[0], _mm_unpacklo_epi16( p0, q0 ) );
+        _mm_storeu_si128( ( __m128i* ) &pairs[4], _mm_unpackhi_epi16( p0, q0 ) );
+
+        for( int l = 0; l < numLanes; l++ )
+        {
+          *( int32_t* ) &src[l * iStride + 1] = pairs[l];
+        }
+      }
+      else
+      {
+        // the lines are columns, each row across the edge holds one sample position of all lines
+        Pel* src = piSrc + line;
+
+        if( numLanes == 8 )
+        {
+          __m128i p0 = _mm_loadu_si128( ( const __m128i* ) &src[-iStride] );
+          __m128i q0 = _mm_loadu_si128( ( const __m128i* ) &src[0] );
+
+          simdFilterChromaLines<vext>( _mm_loadu_si128( ( const __m128i* ) &src[-2 * iStride] ), p0, q0, _mm_loadu_si128( ( const __m128i* ) &src[iStride] ), vtc, mNoP, mNoQ, clpRng );
+
+          _mm_storeu_si128( ( __m128i* ) &src[-iStride], p0 );
+          _mm_storeu_si128( ( __m128i* ) &src[0],        q0 );
+        }
+        else
+        {
+          __m128i p0 = _mm_loadl_epi64( ( const __m128i* ) &src[-iStride] );
+          __m128i q0 = _mm_loadl_epi64( ( const __m128i* ) &src[0] );
+
+          simdFilterChromaLines<vext>( _mm_loadl_epi64( ( const __m128i* ) &src[-2 * iStride] ), p0, q0, _mm_loadl_epi64( ( const __m128i* ) &src[iStride] ), vtc, mNoP, mNoQ, clpRng );
+
+          _mm_storel_epi64( ( __m128i* ) &src[-iStride], p0 );
+          _mm_storel_epi64( ( __m128i* ) &src[0],        q0 );
+        }
+      }
+    }
+
+    line += numLanes;
+  }
+
+  if( line < numLines )
+  {
+    // the remaining lines are whole segments
+    LoopFilter::xFilterChromaEdgeCore( piSrc + line * ( edgeDir == EDGE_VER ? iStride : 1 ), iStride, edgeDir, ( numLines - line ) / segmentLength, segmentLength, segments + line / segmentLength, clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaEdge   = simdFilterLumaEdge<vext>;
+  m_filterChromaEdge = simdFilterChromaEdge<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -2435,6 +2435,287 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 #endif
 }
 
+template< X86_VEXT vext >
+uint64_t RdCost::xGetSSEPlane_SIMD( const CPelBuf& org, const CPelBuf& cur )
+{
+  // the samples are non-negative, so their differences fit into 16 bit and the sum of two squares fits into
+  // unsigned 32 bit, which is zero extended to 64 bit before accumulation
+  const Pel* pSrc1  = org.buf;
+  const Pel* pSrc2  = cur.buf;
+  const int  iRows  = org.height;
+  const int  iCols  = org.width;
+  uint64_t   uiRet  = 0;
+  int        iColsV = 0;
+
+  if( vext >= AVX2 && iCols >= 16 )
+  {
+#ifdef USE_AVX2
+    const __m256i vzero = _mm256_setzero_si256();
+    __m256i Sum = vzero;
+    iColsV = iCols & ~15;
+    for( int iY = 0; iY < iRows; iY++ )
+    {
+      for( int iX = 0; iX < iColsV; iX += 16 )
+      {
+        __m256i Src1 = _mm256_loadu_si256( ( const __m256i* )( &pSrc1[iX] ) );
+        __m256i Src2 = _mm256_loadu_si256( ( const __m256i* )( &pSrc2[iX] ) );
+        __m256i Diff = _mm256_sub_epi16( Src1, Src2 );
+        __m256i Res  = _mm256_madd_epi16( Diff, Diff );
+        Sum = _mm256_add_epi64( Sum, _mm256_unpacklo_epi32( Res, vzero ) );
+        Sum = _mm256_add_epi64( Sum, _mm256_unpackhi_epi32( Res, vzero ) );
+      }
+      for( int iX = iColsV; iX < iCols; iX++ )
+      {
+        const int iTemp = pSrc1[iX] - pSrc2[iX];
+        uiRet += uint64_t( iTemp * iTemp );
+      }
+      pSrc1 += org.stride;
+      pSrc2 += cur.stride;
+    }
+    __m128i Sum128 = _mm_add_epi64( _mm256_castsi256_si128( Sum ), _mm256_extracti128_si256( Sum, 1 ) );
+    Sum128 = _mm_add_epi64( Sum128, _mm_unpackhi_epi64( Sum128, Sum128 ) );
+    uint64_t uiSum;
+    _mm_storel_epi64( ( __m128i* ) &uiSum, Sum128 );
+    uiRet += uiSum;
+#endif
+  }
+  else if( iCols >= 8 )
+  {
+    const __m128i vzero = _mm_setzero_si128();
+    __m128i Sum = vzero;
+    iColsV = iCols & ~7;
+    for( int iY = 0; iY < iRows; iY++ )
+    {
+      for( int iX = 0; iX < iColsV; iX += 8 )
+      {
+        __m128i Src1 = _mm_loadu_si128( ( const __m128i* )( &pSrc1[iX] ) );
+        __m128i Src2 = _mm_loadu_si128( ( const __m128i* )( &pSrc2[iX] ) );
+        __m128i Diff = _mm_sub_epi16( Src1, Src2 );
+        __m128i Res  = _mm_madd_epi16( Diff, Diff );
+        Sum = _mm_add_epi64( Sum, _mm_unpacklo_epi32( Res, vzero ) );
+        Sum = _mm_add_epi64( Sum, _mm_unpackhi_epi32( Res, vzero ) );
+      }
+      for( int iX = iColsV; iX < iCols; iX++ )
+      {
+        const int iTemp = pSrc1[iX] - pSrc2[iX];
+        uiRet += uint64_t( iTemp * iTemp );
+      }
+      pSrc1 += org.stride;
+      pSrc2 += cur.stride;
+    }
+    Sum = _mm_add_epi64( Sum, _mm_unpackhi_epi64( Sum, Sum ) );
+    uint64_t uiSum;
+    _mm_storel_epi64( ( __m128i* ) &uiSum, Sum );
+    uiRet += uiSum;
+  }
+  else
+  {
+    return RdCost::xGetSSEPlane( org, cur );
+  }
+
+  return uiRet;
+}
+
+static inline uint64_t xHorSumU32_SSE( const __m128i& vsum )
+{
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i Sum = _mm_add_epi64( _mm_unpacklo_epi32( vsum, vzero ), _mm_unpackhi_epi32( vsum, vzero ) );
+  Sum = _mm_add_epi64( Sum, _mm_unpackhi_epi64( Sum, Sum ) );
+  uint64_t uiSum;
+  _mm_storel_epi64( ( __m128i* ) &uiSum, Sum );
+  return uiSum;
+}
+
+#ifdef USE_AVX2
+static inline uint64_t xHorSumU32_AVX2( const __m256i& vsum )
+{
+  const __m256i vzero = _mm256_setzero_si256();
+  __m256i Sum = _mm256_add_epi64( _mm256_unpacklo_epi32( vsum, vzero ), _mm256_unpackhi_epi32( vsum, vzero ) );
+  __m128i Sum128 = _mm_add_epi64( _mm256_castsi256_si128( Sum ), _mm256_extracti128_si256( Sum, 1 ) );
+  Sum128 = _mm_add_epi64( Sum128, _mm_unpackhi_epi64( Sum128, Sum128 ) );
+  uint64_t uiSum;
+  _mm_storel_epi64( ( __m128i* ) &uiSum, Sum128 );
+  return uiSum;
+}
+#endif
+
+template< X86_VEXT vext >
+Distortion RdCost::xGetMRSAD_SIMD( const DistParam &rcDtParam )
+{
+  // the inputs may be predictions at the internal precision, so the differences are formed in 32 bit, the lane
+  // sums of a block of at most MAX_CU_SIZE x MAX_CU_SIZE samples cannot overflow
+  const Pel* piOrg      = rcDtParam.org.buf;
+  const Pel* piCur      = rcDtParam.cur.buf;
+  const int  iCols      = rcDtParam.org.width;
+  const int  iRows      = rcDtParam.org.height;
+  const int  iSubShift  = rcDtParam.subShift;
+  const int  iSubStep   = ( 1 << iSubShift );
+  const int  iStrideCur = rcDtParam.cur.stride * iSubStep;
+  const int  iStrideOrg = rcDtParam.org.stride * iSubStep;
+
+  if( iCols & 3 )
+  {
+    return RdCost::xGetMRSAD( rcDtParam );
+  }
+
+  Distortion uiSum = 0;
+
+  if( vext >= AVX2 && ( iCols & 7 ) == 0 )
+  {
+#ifdef USE_AVX2
+    __m256i vdelta = _mm256_setzero_si256();
+    const Pel* pOrg = piOrg;
+    const Pel* pCur = piCur;
+    for( int iY = 0; iY < iRows; iY += iSubStep, pOrg += iStrideOrg, pCur += iStrideCur )
+    {
+      for( int iX = 0; iX < iCols; iX += 8 )
+      {
+        __m256i vorg = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pOrg[iX] ) ) );
+        __m256i vcur = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pCur[iX] ) ) );
+        vdelta = _mm256_add_epi32( vdelta, _mm256_sub_epi32( vorg, vcur ) );
+      }
+    }
+    __m128i vdelta128 = _mm_add_epi32( _mm256_castsi256_si128( vdelta ), _mm256_extracti128_si256( vdelta, 1 ) );
+    vdelta128 = _mm_hadd_epi32( vdelta128, vdelta128 );
+    vdelta128 = _mm_hadd_epi32( vdelta128, vdelta128 );
+    const int32_t deltaSum = _mm_cvtsi128_si32( vdelta128 );
+
+    const __m256i voffset = _mm256_set1_epi32( Pel( deltaSum / ( iCols * ( iRows >> iSubShift ) ) ) );
+    __m256i vsum = _mm256_setzero_si256();
+    pOrg = piOrg;
+    pCur = piCur;
+    for( int iY = 0; iY < iRows; iY += iSubStep, pOrg += iStrideOrg, pCur += iStrideCur )
+    {
+      for( int iX = 0; iX < iCols; iX += 8 )
+      {
+        __m256i vorg = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pOrg[iX] ) ) );
+        __m256i vcur = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pCur[iX] ) ) );
+        vsum = _mm256_add_epi32( vsum, _mm256_abs_epi32( _mm256_sub_epi32( _mm256_sub_epi32( vorg, vcur ), voffset ) ) );
+      }
+    }
+    uiSum = xHorSumU32_AVX2( vsum );
+#endif
+  }
+  else
+  {
+    __m128i vdelta = _mm_setzero_si128();
+    const Pel* pOrg = piOrg;
+    const Pel* pCur = piCur;
+    for( int iY = 0; iY < iRows; iY += iSubStep, pOrg += iStrideOrg, pCur += iStrideCur )
+    {
+      for( int iX = 0; iX < iCols; iX += 4 )
+      {
+        __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pOrg[iX] ) ) );
+        __m128i vcur = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pCur[iX] ) ) );
+        vdelta = _mm_add_epi32( vdelta, _mm_sub_epi32( vorg, vcur ) );
+      }
+    }
+    vdelta = _mm_hadd_epi32( vdelta, vdelta );
+    vdelta = _mm_hadd_epi32( vdelta, vdelta );
+    const int32_t deltaSum = _mm_cvtsi128_si32( vdelta );
+
+    const __m128i voffset = _mm_set1_epi32( Pel( deltaSum / ( iCols * ( iRows >> iSubShift ) ) ) );
+    __m128i vsum = _mm_setzero_si128();
+    pOrg = piOrg;
+    pCur = piCur;
+    for( int iY = 0; iY < iRows; iY += iSubStep, pOrg += iStrideOrg, pCur += iStrideCur )
+    {
+      for( int iX = 0; iX < iCols; iX += 4 )
+      {
+        __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pOrg[iX] ) ) );
+        __m128i vcur = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pCur[iX] ) ) );
+        vsum = _mm_add_epi32( vsum, _mm_abs_epi32( _mm_sub_epi32( _mm_sub_epi32( vorg, vcur ), voffset ) ) );
+      }
+    }
+    uiSum = xHorSumU32_SSE( vsum );
+  }
+
+  uiSum <<= iSubShift;
+#if DISTORTION_LAMBDA_BUGFIX
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+#else
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+#endif
+}
+
+#if DMVR_JVET_K0217
+template< X86_VEXT vext >
+void RdCost::xGetDMVRCosts_SIMD( const Pel* const* srcL0, const Pel* const* srcL1, int stride, int width, int height, const int* deltas, int numCand, Distortion* costs )
+{
+  // the search positions are shifted by at most one sample against each other, so the candidates of a group are
+  // scored row by row in one pass and the rows of all of them are read while they are in the cache
+  static const int iGroupSize = 4;
+
+  if( width & 3 )
+  {
+    RdCost::xGetDMVRCosts( srcL0, srcL1, stride, width, height, deltas, numCand, costs );
+    return;
+  }
+
+  for( int iCand0 = 0; iCand0 < numCand; iCand0 += iGroupSize )
+  {
+    const int iNumGroup = std::min( iGroupSize, numCand - iCand0 );
+
+    if( vext >= AVX2 && ( width & 7 ) == 0 )
+    {
+#ifdef USE_AVX2
+      __m256i vsum[iGroupSize], voffset[iGroupSize];
+      for( int c = 0; c < iNumGroup; c++ )
+      {
+        vsum   [c] = _mm256_setzero_si256();
+        voffset[c] = _mm256_set1_epi32( deltas[iCand0 + c] );
+      }
+      for( int iY = 0; iY < height; iY++ )
+      {
+        for( int c = 0; c < iNumGroup; c++ )
+        {
+          const Pel* pSrc0 = srcL0[iCand0 + c] + iY * stride;
+          const Pel* pSrc1 = srcL1[iCand0 + c] + iY * stride;
+          for( int iX = 0; iX < width; iX += 8 )
+          {
+            __m256i vsrc0 = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pSrc0[iX] ) ) );
+            __m256i vsrc1 = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( &pSrc1[iX] ) ) );
+            vsum[c] = _mm256_add_epi32( vsum[c], _mm256_abs_epi32( _mm256_sub_epi32( _mm256_sub_epi32( vsrc0, vsrc1 ), voffset[c] ) ) );
+          }
+        }
+      }
+      for( int c = 0; c < iNumGroup; c++ )
+      {
+        costs[iCand0 + c] = xHorSumU32_AVX2( vsum[c] );
+      }
+#endif
+    }
+    else
+    {
+      __m128i vsum[iGroupSize], voffset[iGroupSize];
+      for( int c = 0; c < iNumGroup; c++ )
+      {
+        vsum   [c] = _mm_setzero_si128();
+        voffset[c] = _mm_set1_epi32( deltas[iCand0 + c] );
+      }
+      for( int iY = 0; iY < height; iY++ )
+      {
+        for( int c = 0; c < iNumGroup; c++ )
+        {
+          const Pel* pSrc0 = srcL0[iCand0 + c] + iY * stride;
+          const Pel* pSrc1 = srcL1[iCand0 + c] + iY * stride;
+          for( int iX = 0; iX < width; iX += 4 )
+          {
+            __m128i vsrc0 = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pSrc0[iX] ) ) );
+            __m128i vsrc1 = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( &pSrc1[iX] ) ) );
+            vsum[c] = _mm_add_epi32( vsum[c], _mm_abs_epi32( _mm_sub_epi32( _mm_sub_epi32( vsrc0, vsrc1 ), voffset[c] ) ) );
+          }
+        }
+      }
+      for( int c = 0; c < iNumGroup; c++ )
+      {
+        costs[iCand0 + c] = xHorSumU32_SSE( vsum[c] );
+      }
+    }
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
 {
@@ -2470,6 +2751,22 @@ void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_HAD32]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD64]   = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD16N]  = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
+
+  // the generic DF_MRSAD keeps the scalar version with its early termination
+  m_afpDistortFunc[DF_MRSAD4  ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD8  ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD16 ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD32 ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD64 ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD16N] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD12 ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD24 ] = RdCost::xGetMRSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_MRSAD48 ] = RdCost::xGetMRSAD_SIMD<vext>;
+
+  m_fpSSEPlane                 = RdCost::xGetSSEPlane_SIMD<vext>;
+#if DMVR_JVET_K0217
+  m_fpDMVRCosts                = RdCost::xGetDMVRCosts_SIMD<vext>;
+#endif
 }
 
 template void RdCost::_initRdCostX86<SIMDX86>();
@@ -0,0 +1,369 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SIMD functions of the sample adaptive offset class
+*/
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static void simdCalcEOStats( const Pel* srcLine, const int srcStride, const Pel* orgLine, const int orgStride, const int width, const int height, const int offsetA, const int offsetB, int64_t* diff, int64_t* count )
+{
+  // the sums of a class are kept in 32 bit lanes, which holds for blocks up to the maximum CTU size
+  int32_t sumDiff[NUM_SAO_EO_CLASSES][8];
+  int32_t sumCount[NUM_SAO_EO_CLASSES][8];
+  int widthSimd = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    widthSimd = width & ~15;
+    const __m256i vone = _mm256_set1_epi16( 1 );
+    __m256i vdiff [NUM_SAO_EO_CLASSES];
+    __m256i vcount[NUM_SAO_EO_CLASSES];
+
+    for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+    {
+      vdiff [edgeIdx] = _mm256_setzero_si256();
+      vcount[edgeIdx] = _mm256_setzero_si256();
+    }
+
+    const Pel* src = srcLine;
+    const Pel* org = orgLine;
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < widthSimd; x += 16 )
+      {
+        const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+        const __m256i vorg = _mm256_loadu_si256( ( const __m256i* ) &org[x] );
+        const __m256i va   = _mm256_loadu_si256( ( const __m256i* ) &src[x + offsetA] );
+        const __m256i vb   = _mm256_loadu_si256( ( const __m256i* ) &src[x + offsetB] );
+
+        // sgn( src - a ) + sgn( src - b ), the comparisons yield -1 for true
+        const __m256i vsignA = _mm256_sub_epi16( _mm256_cmpgt_epi16( va, vsrc ), _mm256_cmpgt_epi16( vsrc, va ) );
+        const __m256i vsignB = _mm256_sub_epi16( _mm256_cmpgt_epi16( vb, vsrc ), _mm256_cmpgt_epi16( vsrc, vb ) );
+        const __m256i vedge  = _mm256_add_epi16( vsignA, vsignB );
+
+        for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+        {
+          const __m256i vmask = _mm256_cmpeq_epi16( vedge, _mm256_set1_epi16( edgeIdx - 2 ) );
+          const __m256i vsum  = _mm256_sub_epi32( _mm256_madd_epi16( _mm256_and_si256( vmask, vorg ), vone ), _mm256_madd_epi16( _mm256_and_si256( vmask, vsrc ), vone ) );
+
+          vdiff [edgeIdx] = _mm256_add_epi32( vdiff [edgeIdx], vsum );
+          vcount[edgeIdx] = _mm256_sub_epi32( vcount[edgeIdx], _mm256_madd_epi16( vmask, vone ) );
+        }
+      }
+      src += srcStride;
+      org += orgStride;
+    }
+
+    for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+    {
+      _mm256_storeu_si256( ( __m256i* ) sumDiff [edgeIdx], vdiff [edgeIdx] );
+      _mm256_storeu_si256( ( __m256i* ) sumCount[edgeIdx], vcount[edgeIdx] );
+    }
+  }
+  else
+#endif
+  if( width >= 8 )
+  {
+    widthSimd = width & ~7;
+    const __m128i vone = _mm_set1_epi16( 1 );
+    __m128i vdiff [NUM_SAO_EO_CLASSES];
+    __m128i vcount[NUM_SAO_EO_CLASSES];
+
+    for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+    {
+      vdiff [edgeIdx] = _mm_setzero_si128();
+      vcount[edgeIdx] = _mm_setzero_si128();
+    }
+
+    const Pel* src = srcLine;
+    const Pel* org = orgLine;
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < widthSimd; x += 8 )
+      {
+        const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+        const __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &org[x] );
+        const __m128i va   = _mm_loadu_si128( ( const __m128i* ) &src[x + offsetA] );
+        const __m128i vb   = _mm_loadu_si128( ( const __m128i* ) &src[x + offsetB] );
+
+        const __m128i vsignA = _mm_sub_epi16( _mm_cmpgt_epi16( va, vsrc ), _mm_cmpgt_epi16( vsrc, va ) );
+        const __m128i vsignB = _mm_sub_epi16( _mm_cmpgt_epi16( vb, vsrc ), _mm_cmpgt_epi16( vsrc, vb ) );
+        const __m128i vedge  = _mm_add_epi16( vsignA, vsignB );
+
+        for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+        {
+          const __m128i vmask = _mm_cmpeq_epi16( vedge, _mm_set1_epi16( edgeIdx - 2 ) );
+          const __m128i vsum  = _mm_sub_epi32( _mm_madd_epi16( _mm_and_si128( vmask, vorg ), vone ), _mm_madd_epi16( _mm_and_si128( vmask, vsrc ), vone ) );
+
+          vdiff [edgeIdx] = _mm_add_epi32( vdiff [edgeIdx], vsum );
+          vcount[edgeIdx] = _mm_sub_epi32( vcount[edgeIdx], _mm_madd_epi16( vmask, vone ) );
+        }
+      }
+      src += srcStride;
+      org += orgStride;
+    }
+
+    for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+    {
+      _mm_storeu_si128( ( __m128i* ) sumDiff [edgeIdx], vdiff [edgeIdx] );
+      _mm_storeu_si128( ( __m128i* ) sumCount[edgeIdx], vcount[edgeIdx] );
+      std::memset( &sumDiff [edgeIdx][4], 0, 4 * sizeof( int32_t ) );
+      std::memset( &sumCount[edgeIdx][4], 0, 4 * sizeof( int32_t ) );
+    }
+  }
+  else
+  {
+    SampleAdaptiveOffset::calcEOStats( srcLine, srcStride, orgLine, orgStride, width, height, offsetA, offsetB, diff, count );
+    return;
+  }
+
+  for( int edgeIdx = 0; edgeIdx < NUM_SAO_EO_CLASSES; edgeIdx++ )
+  {
+    for( int i = 0; i < 8; i++ )
+    {
+      diff [edgeIdx - 2] += sumDiff [edgeIdx][i];
+      count[edgeIdx - 2] += sumCount[edgeIdx][i];
+    }
+  }
+
+  // remaining columns
+  if( widthSimd < width )
+  {
+    SampleAdaptiveOffset::calcEOStats( srcLine + widthSimd, srcStride, orgLine + widthSimd, orgStride, width - widthSimd, height, offsetA, offsetB, diff, count );
+  }
+}
+
+// the offset of a lane is looked up with a byte shuffle of a table of eight 16-bit offsets, the shuffle control of table
+// entry i is ( 2 * i ) | ( 2 * i + 1 ) << 8
+template<X86_VEXT vext>
+static void simdOffsetEO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int offsetA, const int offsetB, const int* offset, const ClpRng& clpRng )
+{
+  int widthSimd = 0;
+
+  if( width >= 8 && height > 0 )
+  {
+    const __m128i vtable = _mm_setr_epi16( offset[-2], offset[-1], offset[0], offset[1], offset[2], 0, 0, 0 );
+    const __m128i vctrl  = _mm_set1_epi16( 0x0202 );
+    const __m128i vbase  = _mm_set1_epi16( 0x0100 + 2 * 0x0202 );
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      widthSimd = width & ~15;
+      const __m256i vtable256 = _mm256_inserti128_si256( _mm256_castsi128_si256( vtable ), vtable, 1 );
+      const __m256i vctrl256  = _mm256_set1_epi16( 0x0202 );
+      const __m256i vbase256  = _mm256_set1_epi16( 0x0100 + 2 * 0x0202 );
+      const __m256i vmin      = _mm256_set1_epi16( clpRng.min );
+      const __m256i vmax      = _mm256_set1_epi16( clpRng.max );
+
+      const Pel* src = srcLine;
+      Pel*       res = resLine;
+      for( int y = 0; y < height; y++ )
+      {
+        for( int x = 0; x < widthSimd; x += 16 )
+        {
+          const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+          const __m256i va   = _mm256_loadu_si256( ( const __m256i* ) &src[x + offsetA] );
+          const __m256i vb   = _mm256_loadu_si256( ( const __m256i* ) &src[x + offsetB] );
+
+          // sgn( src - a ) + sgn( src - b ), the comparisons yield -1 for true
+          const __m256i vsignA = _mm256_sub_epi16( _mm256_cmpgt_epi16( va, vsrc ), _mm256_cmpgt_epi16( vsrc, va ) );
+          const __m256i vsignB = _mm256_sub_epi16( _mm256_cmpgt_epi16( vb, vsrc ), _mm256_cmpgt_epi16( vsrc, vb ) );
+          const __m256i vedge  = _mm256_add_epi16( vsignA, vsignB );
+          const __m256i voff   = _mm256_shuffle_epi8( vtable256, _mm256_add_epi16( _mm256_mullo_epi16( vedge, vctrl256 ), vbase256 ) );
+
+          _mm256_storeu_si256( ( __m256i* ) &res[x], _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vsrc, voff ), vmin ), vmax ) );
+        }
+        src += srcStride;
+        res += resStride;
+      }
+    }
+    else
+#endif
+    {
+      widthSimd = width & ~7;
+      const __m128i vmin = _mm_set1_epi16( clpRng.min );
+      const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+      const Pel* src = srcLine;
+      Pel*       res = resLine;
+      for( int y = 0; y < height; y++ )
+      {
+        for( int x = 0; x < widthSimd; x += 8 )
+        {
+          const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+          const __m128i va   = _mm_loadu_si128( ( const __m128i* ) &src[x + offsetA] );
+          const __m128i vb   = _mm_loadu_si128( ( const __m128i* ) &src[x + offsetB] );
+
+          const __m128i vsignA = _mm_sub_epi16( _mm_cmpgt_epi16( va, vsrc ), _mm_cmpgt_epi16( vsrc, va ) );
+          const __m128i vsignB = _mm_sub_epi16( _mm_cmpgt_epi16( vb, vsrc ), _mm_cmpgt_epi16( vsrc, vb ) );
+          const __m128i vedge  = _mm_add_epi16( vsignA, vsignB );
+          const __m128i voff   = _mm_shuffle_epi8( vtable, _mm_add_epi16( _mm_mullo_epi16( vedge, vctrl ), vbase ) );
+
+          _mm_storeu_si128( ( __m128i* ) &res[x], _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vsrc, voff ), vmin ), vmax ) );
+        }
+        src += srcStride;
+        res += resStride;
+      }
+    }
+  }
+
+  // remaining columns
+  if( widthSimd < width )
+  {
+    SampleAdaptiveOffset::offsetEO( srcLine + widthSimd, srcStride, resLine + widthSimd, resStride, width - widthSimd, height, offsetA, offsetB, offset, clpRng );
+  }
+}
+
+// the 32 band offsets are split into four tables of eight 16-bit offsets, selected by the two upper bits of the band
+template<X86_VEXT vext>
+static void simdOffsetBO( const Pel* srcLine, const int srcStride, Pel* resLine, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  int widthSimd = 0;
+
+  if( width >= 8 )
+  {
+    __m128i vtable[4];
+    for( int t = 0; t < 4; t++ )
+    {
+      const int* off = offset + 8 * t;
+      vtable[t] = _mm_setr_epi16( off[0], off[1], off[2], off[3], off[4], off[5], off[6], off[7] );
+    }
+    const __m128i vshift = _mm_cvtsi32_si128( shiftBits );
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      widthSimd = width & ~15;
+      __m256i vtable256[4];
+      for( int t = 0; t < 4; t++ )
+      {
+        vtable256[t] = _mm256_inserti128_si256( _mm256_castsi128_si256( vtable[t] ), vtable[t], 1 );
+      }
+      const __m256i vseven = _mm256_set1_epi16( 7 );
+      const __m256i vctrl  = _mm256_set1_epi16( 0x0202 );
+      const __m256i vbase  = _mm256_set1_epi16( 0x0100 );
+      const __m256i vmin   = _mm256_set1_epi16( clpRng.min );
+      const __m256i vmax   = _mm256_set1_epi16( clpRng.max );
+
+      const Pel* src = srcLine;
+      Pel*       res = resLine;
+      for( int y = 0; y < height; y++ )
+      {
+        for( int x = 0; x < widthSimd; x += 16 )
+        {
+          const __m256i vsrc  = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+          const __m256i vband = _mm256_srl_epi16( vsrc, vshift );
+          const __m256i vsel  = _mm256_srli_epi16( vband, 3 );
+          const __m256i vidx  = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_and_si256( vband, vseven ), vctrl ), vbase );
+
+          __m256i voff = _mm256_shuffle_epi8( vtable256[0], vidx );
+          for( int t = 1; t < 4; t++ )
+          {
+            voff = _mm256_blendv_epi8( voff, _mm256_shuffle_epi8( vtable256[t], vidx ), _mm256_cmpeq_epi16( vsel, _mm256_set1_epi16( t ) ) );
+          }
+
+          _mm256_storeu_si256( ( __m256i* ) &res[x], _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vsrc, voff ), vmin ), vmax ) );
+        }
+        src += srcStride;
+        res += resStride;
+      }
+    }
+    else
+#endif
+    {
+      widthSimd = width & ~7;
+      const __m128i vseven = _mm_set1_epi16( 7 );
+      const __m128i vctrl  = _mm_set1_epi16( 0x0202 );
+      const __m128i vbase  = _mm_set1_epi16( 0x0100 );
+      const __m128i vmin   = _mm_set1_epi16( clpRng.min );
+      const __m128i vmax   = _mm_set1_epi16( clpRng.max );
+
+      const Pel* src = srcLine;
+      Pel*       res = resLine;
+      for( int y = 0; y < height; y++ )
+      {
+        for( int x = 0; x < widthSimd; x += 8 )
+        {
+          const __m128i vsrc  = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+          const __m128i vband = _mm_srl_epi16( vsrc, vshift );
+          const __m128i vsel  = _mm_srli_epi16( vband, 3 );
+          const __m128i vidx  = _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( vband, vseven ), vctrl ), vbase );
+
+          __m128i voff = _mm_shuffle_epi8( vtable[0], vidx );
+          for( int t = 1; t < 4; t++ )
+          {
+            voff = _mm_blendv_epi8( voff, _mm_shuffle_epi8( vtable[t], vidx ), _mm_cmpeq_epi16( vsel, _mm_set1_epi16( t ) ) );
+          }
+
+          _mm_storeu_si128( ( __m128i* ) &res[x], _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vsrc, voff ), vmin ), vmax ) );
+        }
+        src += srcStride;
+        res += resStride;
+      }
+    }
+  }
+
+  // remaining columns
+  if( widthSimd < width )
+  {
+    SampleAdaptiveOffset::offsetBO( srcLine + widthSimd, srcStride, resLine + widthSimd, resStride, width - widthSimd, height, shiftBits, offset, clpRng );
+  }
+}
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_calcEOStats = simdCalcEOStats<vext>;
+  m_offsetEO    = simdOffsetEO<vext>;
+  m_offsetBO    = simdOffsetBO<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
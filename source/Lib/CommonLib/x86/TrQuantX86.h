@@ -0,0 +1,296 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    SIMD functions of the 1D transforms (DCT-II, DST-VII, DCT-VIII)
+*/
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+#include "../TrQuant_EMT.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_TRAFO
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The 1D transforms are computed as matrix multiplications with the transform matrices, which gives the same results as
+// the partial butterflies and the fast 4-point DST-VII/DCT-VIII, since no intermediate value of those is rounded.
+
+template<int trSize> static inline const TMatrixCoeff* getTrMatrix( const int trType );
+template<> inline const TMatrixCoeff* getTrMatrix< 4>( const int trType ) { return g_aiTr4 [trType][0]; }
+template<> inline const TMatrixCoeff* getTrMatrix< 8>( const int trType ) { return g_aiTr8 [trType][0]; }
+template<> inline const TMatrixCoeff* getTrMatrix<16>( const int trType ) { return g_aiTr16[trType][0]; }
+template<> inline const TMatrixCoeff* getTrMatrix<32>( const int trType ) { return g_aiTr32[trType][0]; }
+template<> inline const TMatrixCoeff* getTrMatrix<64>( const int trType ) { return g_aiTr64[trType][0]; }
+
+template<X86_VEXT vext, int trSize>
+static void simdForwardMM( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int reducedLine, const int cutoff, const TMatrixCoeff* trMatrix )
+{
+  // transpose the lines, so that the samples at one position of all lines are contiguous
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff tmp[trSize * MAX_TU_SIZE] );
+
+  for( int i = 0; i < reducedLine; i += 4 )
+  {
+    for( int n = 0; n < trSize; n += 4 )
+    {
+      __m128i r0 = _mm_loadu_si128( ( const __m128i* ) &src[( i + 0 ) * trSize + n] );
+      __m128i r1 = _mm_loadu_si128( ( const __m128i* ) &src[( i + 1 ) * trSize + n] );
+      __m128i r2 = _mm_loadu_si128( ( const __m128i* ) &src[( i + 2 ) * trSize + n] );
+      __m128i r3 = _mm_loadu_si128( ( const __m128i* ) &src[( i + 3 ) * trSize + n] );
+
+      __m128i t0 = _mm_unpacklo_epi32( r0, r1 );
+      __m128i t1 = _mm_unpacklo_epi32( r2, r3 );
+      __m128i t2 = _mm_unpackhi_epi32( r0, r1 );
+      __m128i t3 = _mm_unpackhi_epi32( r2, r3 );
+
+      _mm_storeu_si128( ( __m128i* ) &tmp[( n + 0 ) * reducedLine + i], _mm_unpacklo_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* ) &tmp[( n + 1 ) * reducedLine + i], _mm_unpackhi_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* ) &tmp[( n + 2 ) * reducedLine + i], _mm_unpacklo_epi64( t2, t3 ) );
+      _mm_storeu_si128( ( __m128i* ) &tmp[( n + 3 ) * reducedLine + i], _mm_unpackhi_epi64( t2, t3 ) );
+    }
+  }
+
+  const int     rnd    = shift > 0 ? 1 << ( shift - 1 ) : 0;
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int k = 0; k < cutoff; k++ )
+  {
+    const TMatrixCoeff* iT    = trMatrix + k * trSize;
+    TCoeff*             pCoef = dst + k * line;
+    int i = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; i + 8 <= reducedLine; i += 8 )
+      {
+        __m256i vsum = _mm256_set1_epi32( rnd );
+
+        for( int n = 0; n < trSize; n++ )
+        {
+          __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &tmp[n * reducedLine + i] );
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( vsrc, _mm256_set1_epi32( iT[n] ) ) );
+        }
+
+        _mm256_storeu_si256( ( __m256i* ) &pCoef[i], _mm256_sra_epi32( vsum, vshift ) );
+      }
+    }
+#endif
+    for( ; i < reducedLine; i += 4 )
+    {
+      __m128i vsum = _mm_set1_epi32( rnd );
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &tmp[n * reducedLine + i] );
+        vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( vsrc, _mm_set1_epi32( iT[n] ) ) );
+      }
+
+      _mm_storeu_si128( ( __m128i* ) &pCoef[i], _mm_sra_epi32( vsum, vshift ) );
+    }
+
+    if( reducedLine < line )
+    {
+      memset( pCoef + reducedLine, 0, sizeof( TCoeff ) * ( line - reducedLine ) );
+    }
+  }
+
+  if( cutoff < trSize )
+  {
+    memset( dst + cutoff * line, 0, sizeof( TCoeff ) * ( trSize - cutoff ) * line );
+  }
+}
+
+template<X86_VEXT vext, int trSize>
+static void simdInverseMM( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int reducedLine, const int cutoff, const TCoeff outputMinimum, const TCoeff outputMaximum, const TMatrixCoeff* trMatrix )
+{
+  const int     rnd    = 1 << ( shift - 1 );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int i = 0; i < reducedLine; i++ )
+  {
+    TCoeff* pRes = dst + i * trSize;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && trSize >= 8 )
+    {
+      // at most eight accumulators, i.e. 64 outputs, are kept in registers at the same time
+      const int numVec = trSize / 8 < 8 ? trSize / 8 : 8;
+      const __m256i vmin = _mm256_set1_epi32( outputMinimum );
+      const __m256i vmax = _mm256_set1_epi32( outputMaximum );
+
+      for( int j = 0; j < trSize; j += numVec * 8 )
+      {
+        __m256i vsum[numVec];
+
+        for( int v = 0; v < numVec; v++ )
+        {
+          vsum[v] = _mm256_set1_epi32( rnd );
+        }
+
+        for( int k = 0; k < cutoff; k++ )
+        {
+          const __m256i       vsrc = _mm256_set1_epi32( src[k * line + i] );
+          const TMatrixCoeff* iT   = trMatrix + k * trSize + j;
+
+          for( int v = 0; v < numVec; v++ )
+          {
+            __m256i vt = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &iT[v * 8] ) );
+            vsum[v] = _mm256_add_epi32( vsum[v], _mm256_mullo_epi32( vsrc, vt ) );
+          }
+        }
+
+        for( int v = 0; v < numVec; v++ )
+        {
+          __m256i vres = _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_sra_epi32( vsum[v], vshift ) ) );
+          _mm256_storeu_si256( ( __m256i* ) &pRes[j + v * 8], vres );
+        }
+      }
+
+      continue;
+    }
+#endif
+    const int numVec = trSize / 4 < 8 ? trSize / 4 : 8;
+    const __m128i vmin = _mm_set1_epi32( outputMinimum );
+    const __m128i vmax = _mm_set1_epi32( outputMaximum );
+
+    for( int j = 0; j < trSize; j += numVec * 4 )
+    {
+      __m128i vsum[numVec];
+
+      for( int v = 0; v < numVec; v++ )
+      {
+        vsum[v] = _mm_set1_epi32( rnd );
+      }
+
+      for( int k = 0; k < cutoff; k++ )
+      {
+        const __m128i       vsrc = _mm_set1_epi32( src[k * line + i] );
+        const TMatrixCoeff* iT   = trMatrix + k * trSize + j;
+
+        for( int v = 0; v < numVec; v++ )
+        {
+          __m128i vt = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &iT[v * 4] ) );
+          vsum[v] = _mm_add_epi32( vsum[v], _mm_mullo_epi32( vsrc, vt ) );
+        }
+      }
+
+      for( int v = 0; v < numVec; v++ )
+      {
+        __m128i vres = _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_sra_epi32( vsum[v], vshift ) ) );
+        _mm_storeu_si128( ( __m128i* ) &pRes[j + v * 4], vres );
+      }
+    }
+  }
+
+  if( reducedLine < line )
+  {
+    memset( dst + reducedLine * trSize, 0, sizeof( TCoeff ) * ( line - reducedLine ) * trSize );
+  }
+}
+
+// The partial butterflies of the DCT-II up to 32 points and the 4-point DST-VII/DCT-VIII compute all coefficients,
+// the others only the first trSize - iSkipLine2 ones. The 64-point DCT-II zeroes out the upper half for any iSkipLine2,
+// of which the callers only use 32. Line counts, which are not a multiple of four, use the C++ code.
+template<X86_VEXT vext, int trType, int trSize, bool useSkipLine2, FwdTrans* scalarTrans>
+static void simdFastForwardTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  const int reducedLine = line - iSkipLine;
+
+  if( reducedLine & 3 )
+  {
+    scalarTrans( src, dst, shift, line, iSkipLine, iSkipLine2 );
+    return;
+  }
+
+  simdForwardMM<vext, trSize>( src, dst, shift, line, reducedLine, useSkipLine2 ? trSize - iSkipLine2 : trSize, getTrMatrix<trSize>( trType ) );
+}
+
+template<X86_VEXT vext, int trType, int trSize, bool useSkipLine2, InvTrans* scalarTrans>
+static void simdFastInverseTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const int reducedLine = line - iSkipLine;
+
+  if( reducedLine & 3 )
+  {
+    scalarTrans( src, dst, shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum );
+    return;
+  }
+
+  simdInverseMM<vext, trSize>( src, dst, shift, line, reducedLine, useSkipLine2 ? trSize - iSkipLine2 : trSize, outputMinimum, outputMaximum, getTrMatrix<trSize>( trType ) );
+}
+
+template<X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  fastFwdTrans[DCT2][1] = simdFastForwardTrans<vext, DCT2,  4, false, fastForwardDCT2_B4 >;
+  fastFwdTrans[DCT2][2] = simdFastForwardTrans<vext, DCT2,  8, false, fastForwardDCT2_B8 >;
+  fastFwdTrans[DCT2][3] = simdFastForwardTrans<vext, DCT2, 16, false, fastForwardDCT2_B16>;
+  fastFwdTrans[DCT2][4] = simdFastForwardTrans<vext, DCT2, 32, false, fastForwardDCT2_B32>;
+  fastFwdTrans[DCT2][5] = simdFastForwardTrans<vext, DCT2, 64, true,  fastForwardDCT2_B64>;
+  fastFwdTrans[DCT8][1] = simdFastForwardTrans<vext, DCT8,  4, false, fastForwardDCT8_B4 >;
+  fastFwdTrans[DCT8][2] = simdFastForwardTrans<vext, DCT8,  8, true,  fastForwardDCT8_B8 >;
+  fastFwdTrans[DCT8][3] = simdFastForwardTrans<vext, DCT8, 16, true,  fastForwardDCT8_B16>;
+  fastFwdTrans[DCT8][4] = simdFastForwardTrans<vext, DCT8, 32, true,  fastForwardDCT8_B32>;
+  fastFwdTrans[DST7][1] = simdFastForwardTrans<vext, DST7,  4, false, fastForwardDST7_B4 >;
+  fastFwdTrans[DST7][2] = simdFastForwardTrans<vext, DST7,  8, true,  fastForwardDST7_B8 >;
+  fastFwdTrans[DST7][3] = simdFastForwardTrans<vext, DST7, 16, true,  fastForwardDST7_B16>;
+  fastFwdTrans[DST7][4] = simdFastForwardTrans<vext, DST7, 32, true,  fastForwardDST7_B32>;
+
+  fastInvTrans[DCT2][1] = simdFastInverseTrans<vext, DCT2,  4, false, fastInverseDCT2_B4 >;
+  fastInvTrans[DCT2][2] = simdFastInverseTrans<vext, DCT2,  8, false, fastInverseDCT2_B8 >;
+  fastInvTrans[DCT2][3] = simdFastInverseTrans<vext, DCT2, 16, false, fastInverseDCT2_B16>;
+  fastInvTrans[DCT2][4] = simdFastInverseTrans<vext, DCT2, 32, false, fastInverseDCT2_B32>;
+  fastInvTrans[DCT2][5] = simdFastInverseTrans<vext, DCT2, 64, true,  fastInverseDCT2_B64>;
+  fastInvTrans[DCT8][1] = simdFastInverseTrans<vext, DCT8,  4, false, fastInverseDCT8_B4 >;
+  fastInvTrans[DCT8][2] = simdFastInverseTrans<vext, DCT8,  8, true,  fastInverseDCT8_B8 >;
+  fastInvTrans[DCT8][3] = simdFastInverseTrans<vext, DCT8, 16, true,  fastInverseDCT8_B16>;
+  fastInvTrans[DCT8][4] = simdFastInverseTrans<vext, DCT8, 32, true,  fastInverseDCT8_B32>;
+  fastInvTrans[DST7][1] = simdFastInverseTrans<vext, DST7,  4, false, fastInverseDST7_B4 >;
+  fastInvTrans[DST7][2] = simdFastInverseTrans<vext, DST7,  8, true,  fastInverseDST7_B8 >;
+  fastInvTrans[DST7][3] = simdFastInverseTrans<vext, DST7, 16, true,  fastInverseDST7_B16>;
+  fastInvTrans[DST7][4] = simdFastInverseTrans<vext, DST7, 32, true,  fastInverseDST7_B32>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_TRAFO
+#endif // TARGET_SIMD_X86
+//! \}
@@ -0,0 +1 @@
+#include "../BilateralFilterX86.h"
@@ -0,0 +1 @@
+#include "../InterPredictionX86.h"
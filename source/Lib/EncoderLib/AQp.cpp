@@ -68,15 +68,24 @@ AQpLayer::~AQpLayer()
 
 void AQpPreanalyzer::preanalyze( Picture* pcEPic )
 {
-  const CPelBuf lumaPlane = pcEPic->getOrigBuf().Y();
+  preanalyze( pcEPic->getOrigBuf().Y(), pcEPic->aqlayer );
+}
+
+/** Analyze a source luma plane, which is not yet attached to a picture, e.g. in an input lookahead
+ * \param lumaPlane luma plane to be analyzed
+ * \param aqLayers  local image characteristics of the plane for each QP adaptation depth
+ * \return void
+ */
+void AQpPreanalyzer::preanalyze( const CPelBuf& lumaPlane, std::vector<AQpLayer*>& aqLayers )
+{
   const int iWidth  = lumaPlane.width;
   const int iHeight = lumaPlane.height;
   const int iStride = lumaPlane.stride;
 
-  for ( uint32_t d = 0; d < pcEPic->aqlayer.size(); d++ )
+  for ( uint32_t d = 0; d < aqLayers.size(); d++ )
   {
     const Pel* pLineY = lumaPlane.bufAt( 0, 0);
-    AQpLayer* pcAQLayer = pcEPic->aqlayer[d];
+    AQpLayer* pcAQLayer = aqLayers[d];
     const uint32_t uiAQPartWidth = pcAQLayer->getAQPartWidth();
     const uint32_t uiAQPartHeight = pcAQLayer->getAQPartHeight();
     double* pcAQU = &pcAQLayer->getQPAdaptationUnit()[0];
@@ -89,6 +89,7 @@ protected:
   virtual ~AQpPreanalyzer() {}
 public:
   static void preanalyze( Picture* picture );
+  static void preanalyze( const CPelBuf& lumaPlane, std::vector<AQpLayer*>& aqLayers );
 };
 
 //! \}
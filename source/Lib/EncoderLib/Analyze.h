@@ -122,6 +122,7 @@ public:
 #endif
 
   void    setFrmRate  (double dFrameRate) { m_dFrmRate = dFrameRate; } //--CFG_KDY
+  double  getFrmRate  ()                  const { return m_dFrmRate; }
   void    clear()
   {
     m_dAddBits = 0;
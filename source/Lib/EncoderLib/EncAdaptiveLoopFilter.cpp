@@ -44,6 +44,9 @@
 
 EncAdaptiveLoopFilter::EncAdaptiveLoopFilter()
   : m_CABACEstimator( nullptr )
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  , m_numThreads( 1 )
+#endif
 {
   for( int i = 0; i < MAX_NUM_COMPONENT; i++ )
   {
@@ -1361,47 +1364,63 @@ void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnit
     }
   }
 
-  for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+  const int widthInCtus = ( m_picWidth + m_maxCUWidth - 1 ) / m_maxCUWidth;
+
+  // the CTU statistics only depend on the samples of their CTU, the CTUs are shared between the threads
+#if ENABLE_LOOP_FILTER_PARALLELISM
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for( int ctuIdx = 0; ctuIdx < m_numCTUsInPic; ctuIdx++ )
   {
-    for( int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth )
-    {
-      const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
-      const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
-      const UnitArea area( m_chromaFormat, Area( xPos, yPos, width, height ) );
+    const int xPos = ( ctuIdx % widthInCtus ) * m_maxCUWidth;
+    const int yPos = ( ctuIdx / widthInCtus ) * m_maxCUHeight;
+    const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
+    const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
+    const UnitArea area( m_chromaFormat, Area( xPos, yPos, width, height ) );
 
-      for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
-      {
-        const ComponentID compID = ComponentID( compIdx );
-        const CompArea& compArea = area.block( compID );
+    for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+    {
+      const ComponentID compID = ComponentID( compIdx );
+      const CompArea& compArea = area.block( compID );
 
-        int  recStride = recYuv.get( compID ).stride;
-        Pel* rec = recYuv.get( compID ).bufAt( compArea );
+      int  recStride = recYuv.get( compID ).stride;
+      Pel* rec = recYuv.get( compID ).bufAt( compArea );
 
-        int  orgStride = orgYuv.get( compID ).stride;
-        Pel* org = orgYuv.get( compID ).bufAt( compArea );
+      int  orgStride = orgYuv.get( compID ).stride;
+      Pel* org = orgYuv.get( compID ).bufAt( compArea );
 
-        ChannelType chType = toChannelType( compID );
+      ChannelType chType = toChannelType( compID );
 
-        for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
-        {
-          getBlkStats( m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape], compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compArea );
+      for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
+      {
+        getBlkStats( m_alfCovariance[compIdx][shape][ctuIdx], m_filterShapes[chType][shape], compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compArea );
+      }
+    }
+  }
 
-          const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
+  // accumulate the frame statistics in raster order, which keeps the floating point sums independent of the thread count
+  for( ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++ )
+  {
+    for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+    {
+      const ComponentID compID = ComponentID( compIdx );
+      const ChannelType chType = toChannelType( compID );
+      const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
 
-          for( int classIdx = 0; classIdx < numClasses; classIdx++ )
-          {
-            m_alfCovarianceFrame[chType][shape][classIdx] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
-          }
+      for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
+      {
+        for( int classIdx = 0; classIdx < numClasses; classIdx++ )
+        {
+          m_alfCovarianceFrame[chType][shape][classIdx] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
         }
       }
-      ctuRsAddr++;
     }
   }
 }
 
 void EncAdaptiveLoopFilter::getBlkStats( AlfCovariance* alfCovariace, const AlfFilterShape& shape, AlfClassifier** classifier, Pel* org, const int orgStride, Pel* rec, const int recStride, const CompArea& area )
 {
-  static int ELocal[MAX_NUM_ALF_LUMA_COEFF];
+  int ELocal[MAX_NUM_ALF_LUMA_COEFF];
 
   int transposeIdx = 0;
   int classIdx = 0;
@@ -172,6 +172,9 @@ private:
   int                    m_kMinTab[MAX_NUM_ALF_LUMA_COEFF];
   int                    m_bitsCoeffScan[m_MAX_SCAN_VAL][m_MAX_EXP_GOLOMB];
   short                  m_filterIndices[MAX_NUM_ALF_CLASSES][MAX_NUM_ALF_CLASSES];
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  int                    m_numThreads;
+#endif
 
 public:
   EncAdaptiveLoopFilter();
@@ -185,6 +188,9 @@ public:
 #endif
   void create( const int picWidth, const int picHeight, const ChromaFormat chromaFormatIDC, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE], const int internalBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  void setNumThreads( int numThreads ) { m_numThreads = numThreads; }
+#endif
   static int lengthGolomb( int coeffVal, int k );
   static int getGolombKMin( AlfFilterShape& alfShape, const int numFilters, int kMinTab[MAX_NUM_ALF_LUMA_COEFF], int bitsCoeffScan[m_MAX_SCAN_VAL][m_MAX_EXP_GOLOMB] );
 
@@ -0,0 +1,358 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncAnalysis.cpp
+    \brief    per-CU analysis shared between encodes, in memory or through an analysis file
+*/
+
+#include "EncAnalysis.h"
+
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/UnitTools.h"
+
+#include <fstream>
+#include <type_traits>
+
+//! \ingroup EncoderLib
+//! \{
+
+static const char    ANALYSIS_FILE_MAGIC[4] = { 'V', 'A', 'N', 'A' };
+static const uint8_t ANALYSIS_FILE_VERSION  = 1;
+
+enum CUAnalysisFlags
+{
+  CU_ANALYSIS_INTRA       = 1 << 0,
+  CU_ANALYSIS_SKIP        = 1 << 1,
+  CU_ANALYSIS_IBC         = 1 << 2,
+  CU_ANALYSIS_AFFINE      = 1 << 3,
+  CU_ANALYSIS_AFFINE_6PAR = 1 << 4
+};
+
+template<typename T> static void writeValue( std::ostream& stream, T value )
+{
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+
+  const UnsignedT bits = UnsignedT( value );
+  for( int i = 0; i < int( sizeof( T ) ); i++ )
+  {
+    stream.put( char( ( bits >> ( 8 * i ) ) & 0xff ) );
+  }
+}
+
+template<typename T> static T readValue( std::istream& stream )
+{
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+
+  UnsignedT bits = 0;
+  for( int i = 0; i < int( sizeof( T ) ); i++ )
+  {
+    bits |= UnsignedT( uint8_t( stream.get() ) ) << ( 8 * i );
+  }
+  return T( bits );
+}
+
+const CUAnalysis* PicAnalysis::getCoveringCU( const Area& area ) const
+{
+  const unsigned ctuAddr = ( area.y >> ctuSizeLog2 ) * widthInCtus + ( area.x >> ctuSizeLog2 );
+
+  if( ctuAddr >= ctuCUs.size() )
+  {
+    return NULL;
+  }
+
+  for( const CUAnalysis& cu : ctuCUs[ctuAddr] )
+  {
+    if( cu.area.contains( area.pos() ) )
+    {
+      return cu.area.contains( area.bottomRight() ) ? &cu : NULL;
+    }
+  }
+
+  return NULL;
+}
+
+void EncAnalysis::addPicture( const CodingStructure& cs )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int mvShift        = 2 + VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE;
+
+  PicAnalysis picAnalysis;
+  picAnalysis.sliceQp     = cs.slice->getSliceQp();
+  picAnalysis.ctuSizeLog2 = pcv.maxCUWidthLog2;
+  picAnalysis.widthInCtus = pcv.widthInCtus;
+  picAnalysis.ctuCUs.resize( pcv.sizeInCtus );
+
+  for( const CodingUnit* cu : cs.cus )
+  {
+    if( cu->chType != CHANNEL_TYPE_LUMA )
+    {
+      continue;
+    }
+
+    CUAnalysis cuAnalysis;
+    cuAnalysis.area     = cu->Y();
+    cuAnalysis.predMode = cu->predMode;
+    cuAnalysis.skip     = cu->skip;
+#if JVET_K0076_CPR
+    cuAnalysis.ibc      = cu->ibc;
+#else
+    cuAnalysis.ibc      = false;
+#endif
+#if JEM_TOOLS || JVET_K_AFFINE
+    cuAnalysis.affine   = cu->affine;
+#else
+    cuAnalysis.affine   = false;
+#endif
+#if ( JEM_TOOLS || JVET_K_AFFINE ) && JVET_K0337_AFFINE_6PARA
+    cuAnalysis.affineType = uint8_t( cu->affineType );
+#else
+    cuAnalysis.affineType = 0;
+#endif
+    cuAnalysis.intraDir = CU::isIntra( *cu ) && cu->firstPU ? uint8_t( cu->firstPU->intraDir[CHANNEL_TYPE_LUMA] ) : uint8_t( DC_IDX );
+    cuAnalysis.interDir = 0;
+
+    for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      cuAnalysis.refIdx[refList] = NOT_VALID;
+      cuAnalysis.mv    [refList] = Mv();
+    }
+
+    if( CU::isInter( *cu ) && cu->firstPU )
+    {
+      const PredictionUnit& pu = *cu->firstPU;
+      cuAnalysis.interDir      = pu.interDir;
+
+      for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+      {
+        if( pu.interDir & ( 1 << refList ) )
+        {
+          cuAnalysis.refIdx[refList] = int8_t( pu.refIdx[refList] );
+          cuAnalysis.mv    [refList] = Mv( pu.mv[refList].getHor() >> mvShift, pu.mv[refList].getVer() >> mvShift );
+        }
+      }
+    }
+
+    picAnalysis.ctuCUs[getCtuAddr( cu->lumaPos(), pcv )].push_back( cuAnalysis );
+  }
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_pictures[cs.slice->getPOC()] = std::move( picAnalysis );
+}
+
+const PicAnalysis* EncAnalysis::getPicture( int poc ) const
+{
+  auto it = m_pictures.find( poc );
+
+  return it == m_pictures.end() ? NULL : &it->second;
+}
+
+void EncAnalysis::write( const std::string& fileName ) const
+{
+  std::ofstream stream( fileName, std::ios::binary | std::ios::out );
+  if( !stream )
+  {
+    EXIT( "Failed to open analysis file " << fileName << " for writing" );
+  }
+
+  stream.write( ANALYSIS_FILE_MAGIC, sizeof( ANALYSIS_FILE_MAGIC ) );
+  writeValue<uint8_t >( stream, ANALYSIS_FILE_VERSION );
+  writeValue<uint32_t>( stream, uint32_t( m_pictures.size() ) );
+
+  for( const auto& picture : m_pictures )
+  {
+    const PicAnalysis& picAnalysis = picture.second;
+
+    writeValue<int32_t >( stream, picture.first );
+    writeValue<int8_t  >( stream, int8_t( picAnalysis.sliceQp ) );
+    writeValue<uint8_t >( stream, uint8_t( picAnalysis.ctuSizeLog2 ) );
+    writeValue<uint16_t>( stream, uint16_t( picAnalysis.widthInCtus ) );
+    writeValue<uint32_t>( stream, uint32_t( picAnalysis.ctuCUs.size() ) );
+
+    for( unsigned ctuAddr = 0; ctuAddr < picAnalysis.ctuCUs.size(); ctuAddr++ )
+    {
+      const Position ctuPos( ( ctuAddr % picAnalysis.widthInCtus ) << picAnalysis.ctuSizeLog2, ( ctuAddr / picAnalysis.widthInCtus ) << picAnalysis.ctuSizeLog2 );
+
+      writeValue<uint16_t>( stream, uint16_t( picAnalysis.ctuCUs[ctuAddr].size() ) );
+
+      for( const CUAnalysis& cu : picAnalysis.ctuCUs[ctuAddr] )
+      {
+        const uint8_t flags = ( cu.predMode == MODE_INTRA ? CU_ANALYSIS_INTRA       : 0 )
+                            | ( cu.skip                   ? CU_ANALYSIS_SKIP        : 0 )
+                            | ( cu.ibc                    ? CU_ANALYSIS_IBC         : 0 )
+                            | ( cu.affine                 ? CU_ANALYSIS_AFFINE      : 0 )
+                            | ( cu.affineType             ? CU_ANALYSIS_AFFINE_6PAR : 0 );
+
+        // CU sizes up to 256 are stored minus one
+        writeValue<uint8_t>( stream, uint8_t( cu.area.x - ctuPos.x ) );
+        writeValue<uint8_t>( stream, uint8_t( cu.area.y - ctuPos.y ) );
+        writeValue<uint8_t>( stream, uint8_t( cu.area.width  - 1 ) );
+        writeValue<uint8_t>( stream, uint8_t( cu.area.height - 1 ) );
+        writeValue<uint8_t>( stream, flags );
+
+        if( cu.predMode == MODE_INTRA )
+        {
+          writeValue<uint8_t>( stream, cu.intraDir );
+          continue;
+        }
+
+        writeValue<uint8_t>( stream, cu.interDir );
+        for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          if( cu.interDir & ( 1 << refList ) )
+          {
+            writeValue<int8_t >( stream, cu.refIdx[refList] );
+            writeValue<int16_t>( stream, int16_t( cu.mv[refList].getHor() ) );
+            writeValue<int16_t>( stream, int16_t( cu.mv[refList].getVer() ) );
+          }
+        }
+      }
+    }
+  }
+
+  if( !stream )
+  {
+    EXIT( "Failed to write analysis file " << fileName );
+  }
+}
+
+void EncAnalysis::read( const std::string& fileName, const Size& picSize )
+{
+  std::ifstream stream( fileName, std::ios::binary | std::ios::in );
+  if( !stream )
+  {
+    EXIT( "Failed to open analysis file " << fileName << " for reading" );
+  }
+
+  char magic[sizeof( ANALYSIS_FILE_MAGIC )];
+  stream.read( magic, sizeof( magic ) );
+  if( !stream || memcmp( magic, ANALYSIS_FILE_MAGIC, sizeof( magic ) ) || readValue<uint8_t>( stream ) != ANALYSIS_FILE_VERSION )
+  {
+    EXIT( "File " << fileName << " is not an analysis file of this encoder version" );
+  }
+
+  m_pictures.clear();
+
+  const uint32_t numPictures = readValue<uint32_t>( stream );
+
+  for( uint32_t picIdx = 0; picIdx < numPictures && stream; picIdx++ )
+  {
+    const int    poc         = readValue<int32_t>( stream );
+    PicAnalysis& picAnalysis = m_pictures[poc];
+
+    picAnalysis.sliceQp     = readValue<int8_t  >( stream );
+    picAnalysis.ctuSizeLog2 = readValue<uint8_t >( stream );
+    picAnalysis.widthInCtus = readValue<uint16_t>( stream );
+    const uint32_t numCtus  = readValue<uint32_t>( stream );
+
+    if( !stream || picAnalysis.ctuSizeLog2 < MIN_CU_LOG2 || picAnalysis.ctuSizeLog2 > MAX_CU_DEPTH )
+    {
+      EXIT( "Analysis file " << fileName << " is corrupt" );
+    }
+
+    // the picture has to be split into the CTUs of the reference encode, whose CTU size may differ from the current one
+    const unsigned ctuSize      = 1u << picAnalysis.ctuSizeLog2;
+    const unsigned widthInCtus  = ( picSize.width  + ctuSize - 1 ) >> picAnalysis.ctuSizeLog2;
+    const unsigned heightInCtus = ( picSize.height + ctuSize - 1 ) >> picAnalysis.ctuSizeLog2;
+    const unsigned maxCtuCUs    = 1u << ( ( picAnalysis.ctuSizeLog2 - MIN_CU_LOG2 ) << 1 );
+
+    if( picAnalysis.widthInCtus != widthInCtus || numCtus != widthInCtus * heightInCtus )
+    {
+      EXIT( "Analysis file " << fileName << " does not match the picture size " << picSize.width << "x" << picSize.height );
+    }
+
+    picAnalysis.ctuCUs.resize( numCtus );
+
+    for( unsigned ctuAddr = 0; ctuAddr < picAnalysis.ctuCUs.size() && stream; ctuAddr++ )
+    {
+      const Position ctuPos( ( ctuAddr % picAnalysis.widthInCtus ) << picAnalysis.ctuSizeLog2, ( ctuAddr / picAnalysis.widthInCtus ) << picAnalysis.ctuSizeLog2 );
+
+      const unsigned numCUs = readValue<uint16_t>( stream );
+
+      if( numCUs > maxCtuCUs )
+      {
+        EXIT( "Analysis file " << fileName << " is corrupt" );
+      }
+
+      picAnalysis.ctuCUs[ctuAddr].resize( numCUs );
+
+      for( CUAnalysis& cu : picAnalysis.ctuCUs[ctuAddr] )
+      {
+        cu.area.x      = ctuPos.x + readValue<uint8_t>( stream );
+        cu.area.y      = ctuPos.y + readValue<uint8_t>( stream );
+        cu.area.width  = readValue<uint8_t>( stream ) + 1;
+        cu.area.height = readValue<uint8_t>( stream ) + 1;
+
+        const uint8_t flags = readValue<uint8_t>( stream );
+        cu.predMode   = flags & CU_ANALYSIS_INTRA ? MODE_INTRA : MODE_INTER;
+        cu.skip       = flags & CU_ANALYSIS_SKIP;
+        cu.ibc        = flags & CU_ANALYSIS_IBC;
+        cu.affine     = flags & CU_ANALYSIS_AFFINE;
+        cu.affineType = flags & CU_ANALYSIS_AFFINE_6PAR ? 1 : 0;
+        cu.intraDir   = DC_IDX;
+        cu.interDir   = 0;
+
+        for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          cu.refIdx[refList] = NOT_VALID;
+          cu.mv    [refList] = Mv();
+        }
+
+        if( cu.predMode == MODE_INTRA )
+        {
+          cu.intraDir = readValue<uint8_t>( stream );
+          continue;
+        }
+
+        cu.interDir = readValue<uint8_t>( stream );
+        for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          if( cu.interDir & ( 1 << refList ) )
+          {
+            cu.refIdx[refList] = readValue<int8_t>( stream );
+            const int hor      = readValue<int16_t>( stream );
+            const int ver      = readValue<int16_t>( stream );
+            cu.mv    [refList] = Mv( hor, ver );
+          }
+        }
+      }
+    }
+  }
+
+  if( !stream )
+  {
+    EXIT( "Analysis file " << fileName << " is truncated or corrupt" );
+  }
+}
+
+//! \}
@@ -0,0 +1,106 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncAnalysis.h
+    \brief    per-CU analysis shared between encodes, in memory or through an analysis file (header)
+*/
+
+#ifndef __ENCANALYSIS__
+#define __ENCANALYSIS__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// coding decision of a luma CU of the reference encode
+struct CUAnalysis
+{
+  Area     area;
+  PredMode predMode;
+  bool     skip;
+  bool     ibc;
+  bool     affine;
+  uint8_t  affineType;
+  uint8_t  intraDir;                                          ///< luma intra mode
+  uint8_t  interDir;
+  int8_t   refIdx[NUM_REF_PIC_LIST_01];
+  Mv       mv    [NUM_REF_PIC_LIST_01];                       ///< integer-pel motion vectors
+};
+
+/// coding decisions of a picture of the reference encode
+struct PicAnalysis
+{
+  int                                  sliceQp;
+  unsigned                             ctuSizeLog2;
+  unsigned                             widthInCtus;
+  std::vector<std::vector<CUAnalysis>> ctuCUs;                ///< luma CUs in coding order, per CTU in raster scan
+
+  /// the recorded CU covering the whole area, NULL if the reference split the area further
+  const CUAnalysis* getCoveringCU( const Area& area ) const;
+};
+
+/// analysis store, filled by the reference encode and read by the dependent encodes
+/// The analysis file holds the pictures in POC order, each with its CTUs in raster scan and their luma CUs in coding order.
+/// The positions of the CUs are relative to their CTU, all values are stored in little endian.
+class EncAnalysis
+{
+private:
+  std::map<int, PicAnalysis> m_pictures;                      ///< per POC
+  std::mutex                 m_mutex;
+
+public:
+  EncAnalysis() {}
+  ~EncAnalysis() {}
+
+  void               addPicture( const CodingStructure& cs );
+  const PicAnalysis* getPicture( int poc ) const;
+  void               clear     () { m_pictures.clear(); }
+
+  void               write     ( const std::string& fileName ) const;
+  void               read      ( const std::string& fileName, const Size& picSize );
+};
+
+//! \}
+
+#endif // __ENCANALYSIS__
@@ -47,6 +47,9 @@
 
 #include "CommonLib/Unit.h"
 
+class EncAnalysis;
+class EncRCStats;
+
 struct GOPEntry
 {
   int m_POC;
@@ -524,6 +527,8 @@ protected:
   bool      m_RCUseLCUSeparateModel;
   int       m_RCInitialQP;
   bool      m_RCForceIntraQP;
+  int         m_RCPass;                                       ///< 0: single pass; 1: first pass gathering statistics; 2: second pass using them
+  EncRCStats* m_RCStats;                                      ///< first-pass statistics, owned by the application
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;
   uint32_t      m_RCCpbSize;
@@ -596,11 +601,14 @@ protected:
   int         m_fastForwardToPOC;                             ///<
   bool        m_stopAfterFFtoPOC;                             ///<
   bool        m_bs2ModPOCAndType;
+  EncAnalysisMode m_analysisMode;                             ///< use of the analysis shared between the encodes of a multi-rate ladder
+  EncAnalysis*    m_analysis;                                 ///< analysis store, owned by the application
 
 
 
 #if ENABLE_SPLIT_PARALLELISM
   int         m_numSplitThreads;
+  int         m_numSplitLevels;
   bool        m_forceSingleSplitThread;
 #endif
 #if ENABLE_WPP_PARALLELISM
@@ -608,6 +616,18 @@ protected:
   int         m_numWppExtraLines;
   bool        m_ensureWppBitEqual;
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  int         m_numFrameThreads;
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  int         m_numDeltaQpRDThreads;
+#endif
+#if ENABLE_ME_PARALLELISM
+  int         m_numMEThreads;
+#endif
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  int         m_numLoopFilterThreads;
+#endif
 
 #if JVET_K0371_ALF
   bool        m_alf;                                          ///< Adaptive Loop Filter
@@ -622,6 +642,10 @@ public:
   {
     m_PCMBitDepth[CHANNEL_TYPE_LUMA]=8;
     m_PCMBitDepth[CHANNEL_TYPE_CHROMA]=8;
+    m_analysisMode = ANALYSIS_OFF;
+    m_analysis     = NULL;
+    m_RCPass       = 0;
+    m_RCStats      = NULL;
   }
 
   virtual ~EncCfg()
@@ -1372,6 +1396,9 @@ public:
   void         setInitialQP           ( int QP )                     { m_RCInitialQP = QP;             }
   bool         getForceIntraQP        ()                             { return m_RCForceIntraQP;        }
   void         setForceIntraQP        ( bool b )                     { m_RCForceIntraQP = b;           }
+  int          getRCPass              ()                       const { return m_RCPass;                }
+  EncRCStats*  getRCStats             ()                       const { return m_RCStats;               }
+  void         setRCStats             ( int pass, EncRCStats* stats ) { m_RCPass = pass; m_RCStats = stats; }
 #if U0132_TARGET_BITS_SATURATION
   bool         getCpbSaturationEnabled()                             { return m_RCCpbSaturationEnabled;}
   void         setCpbSaturationEnabled( bool b )                     { m_RCCpbSaturationEnabled = b;   }
@@ -1534,11 +1561,16 @@ public:
   bool         getStopAfterFFtoPOC()                           const { return m_stopAfterFFtoPOC; }
   void         setBs2ModPOCAndType( bool b )                         { m_bs2ModPOCAndType = b; }
   bool         getBs2ModPOCAndType()                           const { return m_bs2ModPOCAndType; }
+  void         setAnalysis( EncAnalysisMode mode, EncAnalysis* analysis ) { m_analysisMode = mode; m_analysis = analysis; }
+  EncAnalysisMode getAnalysisMode()                            const { return m_analysisMode; }
+  EncAnalysis* getAnalysis()                                   const { return m_analysis; }
 
 
 #if ENABLE_SPLIT_PARALLELISM
   void         setNumSplitThreads( int n )                           { m_numSplitThreads = n; }
   int          getNumSplitThreads()                            const { return m_numSplitThreads; }
+  void         setNumSplitLevels( int n )                            { m_numSplitLevels = n; }
+  int          getNumSplitLevels()                             const { return m_numSplitLevels; }
   void         setForceSingleSplitThread( bool b )                   { m_forceSingleSplitThread = b; }
   int          getForceSingleSplitThread()                     const { return m_forceSingleSplitThread; }
 #endif
@@ -1550,6 +1582,24 @@ public:
   void         setEnsureWppBitEqual( bool b)                         { m_ensureWppBitEqual = b; }
   bool         getEnsureWppBitEqual()                          const { return m_ensureWppBitEqual; }
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  void         setNumFrameThreads( int n )                           { m_numFrameThreads = n; }
+  int          getNumFrameThreads()                            const { return m_numFrameThreads; }
+  //! number of pictures passed to one call of the GOP encoder, all-intra pictures are collected for the frame threads
+  int          getNumPicsPerGOP()                              const { return m_uiIntraPeriod == 1 && m_iGOPSize == 1 ? m_numFrameThreads : m_iGOPSize; }
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  void         setNumDeltaQpRDThreads( int n )                       { m_numDeltaQpRDThreads = n; }
+  int          getNumDeltaQpRDThreads()                        const { return m_numDeltaQpRDThreads; }
+#endif
+#if ENABLE_ME_PARALLELISM
+  void         setNumMEThreads( int n )                              { m_numMEThreads = n; }
+  int          getNumMEThreads()                               const { return m_numMEThreads; }
+#endif
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  void         setNumLoopFilterThreads( int n )                      { m_numLoopFilterThreads = n; }
+  int          getNumLoopFilterThreads()                       const { return m_numLoopFilterThreads; }
+#endif
 #if JVET_K0371_ALF
   void        setUseALF( bool b ) { m_alf = b; }
   bool        getUseALF()                                      const { return m_alf; }
@@ -321,9 +321,7 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
   m_modeCtrl->init( m_pcEncCfg, m_pcRateCtrl, m_pcRdCost );
 
   m_pcInterSearch->setModeCtrl( m_modeCtrl );
-#if !JVET_K0220_ENC_CTRL
   m_pcIntraSearch->setModeCtrl( m_modeCtrl );
-#endif
 #if JVET_K0346
   ::memset(m_subMergeBlkSize, 0, sizeof(m_subMergeBlkSize));
   ::memset(m_subMergeBlkNum, 0, sizeof(m_subMergeBlkNum));
@@ -355,14 +353,23 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
 #if ENABLE_SPLIT_PARALLELISM
   if( m_pcEncCfg->getNumSplitThreads() > 1 )
   {
-    for( int jId = 1; jId < NUM_RESERVERD_SPLIT_JOBS; jId++ )
+    const int numJobSlots = Scheduler::getNumSplitJobSlots( m_pcEncCfg->getNumSplitLevels() );
+
+    for( int jId = 1; jId < numJobSlots; jId++ )
     {
-      EncCu*            jobEncCu  = m_pcEncLib->getCuEncoder( cs.picture->scheduler.getSplitDataId( jId ) );
+      EncCu*            jobEncCu  = m_pcEncLib->getCuEncoder( cs.picture->scheduler.getSplitDataId() + jId );
       CacheBlkInfoCtrl* cacheCtrl = dynamic_cast< CacheBlkInfoCtrl* >( jobEncCu->m_modeCtrl );
       if( cacheCtrl )
       {
         cacheCtrl->init( *cs.slice );
       }
+#if REUSE_CU_RESULTS
+      BestEncInfoCache* bestCache = dynamic_cast< BestEncInfoCache* >( jobEncCu->m_modeCtrl );
+      if( bestCache )
+      {
+        bestCache->init( *cs.slice );
+      }
+#endif
     }
   }
 
@@ -614,12 +621,13 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 #if ENABLE_SPLIT_PARALLELISM
   CHECK( m_dataId != tempCS->picture->scheduler.getDataId(), "Working in the wrong dataId!" );
 
-  if( m_pcEncCfg->getNumSplitThreads() != 1 && tempCS->picture->scheduler.getSplitJobId() == 0 )
+  if( m_pcEncCfg->getNumSplitThreads() != 1 && tempCS->picture->scheduler.getSplitLevel() < m_pcEncCfg->getNumSplitLevels() )
   {
     if( m_modeCtrl->isParallelSplit( *tempCS, partitioner ) )
     {
       m_modeCtrl->setParallelSplit( true );
       xCompressCUParallel( tempCS, bestCS, partitioner );
+      m_modeCtrl->setParallelSplit( false );
       return;
     }
   }
@@ -640,6 +648,9 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 #endif
 
   const UnitArea currCsArea = clipArea( CS::getArea( *bestCS, bestCS->area, partitioner.chType ), *tempCS->picture );
+#if JEM_TOOLS
+  m_pcInterSearch->resetOBMCCache();
+#endif
 #if JVET_K0357_AMVR
   if( m_pImvTempCS && !slice.isIntra() )
   {
@@ -931,24 +942,28 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   const int      wppTId   = picture->scheduler.getWppThreadId();
 #endif
   const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread();
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-#pragma omp parallel for schedule(dynamic,1) num_threads(NUM_SPLIT_THREADS_IF_MSVC) if(doParallel)
-#else
-  omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
+  const bool isNested     = picture->scheduler.getSplitLevel() > 0;
+  const int  parentPicId  = picture->scheduler.getSplitPicId();
 
-#pragma omp parallel for schedule(dynamic,1) if(doParallel)
-#endif
-  for( int jId = 1; jId <= numJobs; jId++ )
+  auto runJob = [&]( const int jId, const unsigned jobPath )
   {
     // thread start
 #if ENABLE_WPP_PARALLELISM
     picture->scheduler.setWppThreadId( wppTId );
 #endif
+    // the thread might be waiting for its own nested jobs and resume its previous job afterwards
+    const unsigned prevJobPath = picture->scheduler.getSplitJobPath();
+
     picture->scheduler.setSplitThreadId();
-    picture->scheduler.setSplitJobId( jId );
+    picture->scheduler.setSplitJobPath( jobPath );
+
+    if( isNested && picture->scheduler.getSplitPicId() != parentPicId )
+    {
+      picture->initParallelPart( currArea, parentPicId );
+    }
 
     Partitioner* jobPartitioner = PartitionerFactory::get( *tempCS->slice );
-    EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
+    EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId() );
     auto*        jobBlkCache    = dynamic_cast<CacheBlkInfoCtrl*>( jobCuEnc->m_modeCtrl );
 
     jobPartitioner->copyState( partitioner );
@@ -968,10 +983,43 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
 
     delete jobPartitioner;
 
-    picture->scheduler.setSplitJobId( 0 );
+    picture->scheduler.setSplitJobPath( prevJobPath );
     // thread stop
+  };
+
+  if( !isNested )
+  {
+#if _MSC_VER && ENABLE_WPP_PARALLELISM
+#pragma omp parallel for schedule(dynamic,1) num_threads(NUM_SPLIT_THREADS_IF_MSVC) if(doParallel)
+#else
+    omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
+
+#pragma omp parallel for schedule(dynamic,1) if(doParallel)
+#endif
+    for( int jId = 1; jId <= numJobs; jId++ )
+    {
+      runJob( jId, picture->scheduler.getSplitJobPath( jId ) );
+    }
+
+    picture->scheduler.setSplitThreadId( 0 );
+  }
+  else
+  {
+    // nested jobs are spawned as tasks into the team of the outermost level, idle threads of that team pick them up
+    for( int jId = 1; jId <= numJobs; jId++ )
+    {
+      const unsigned jobPath = picture->scheduler.getSplitJobPath( jId );
+
+#if !_MSC_VER
+#pragma omp task firstprivate(jId, jobPath) if(doParallel)
+#endif
+      runJob( jId, jobPath );
+    }
+
+#if !_MSC_VER
+#pragma omp taskwait
+#endif
   }
-  picture->scheduler.setSplitThreadId( 0 );
 
   int    bestJId  = 0;
   double bestCost = bestCS->cost;
@@ -1000,7 +1048,10 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
 
   CHECK( calcCheckSum( picture->getRecoBuf( clipdArea.Y() ), bitDepthY ) != calcCheckSum( bestCS->getRecoBuf( clipdArea.Y() ), bitDepthY ), "Data copied incorrectly!" );
 
-  picture->finishParallelPart( currArea );
+  if( !isNested )
+  {
+    picture->finishParallelPart( currArea );
+  }
 
   if( auto *blkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_modeCtrl ) )
   {
@@ -2740,12 +2791,20 @@ void EncCu::xCheckRDCostInterWoOBMC( CodingStructure *&tempCS, CodingStructure *
   cu->obmcFlag = false;
   CHECK( cu->firstPU->mergeFlag && cu->partSize == SIZE_2Nx2N, "Merge2Nx2Ns is on" );
 
+#if JVET_K0248_GBI
+  // the motion search has already decided on the GBi weights, the cost of the re-check is not used to skip any of them
+  double equGBiCost = MAX_DOUBLE;
+#endif
   xEncodeInterResidual(tempCS, bestCS, partitioner, encTestMode, 0
 #if JEM_TOOLS || JVET_K0357_AMVR
     , m_pImvTempCS ? m_pImvTempCS[wIdx][encTestMode.partSize] : NULL
 #endif
 #if JEM_TOOLS || JVET_K1000_SIMPLIFIED_EMT
     , !m_pcEncCfg->getFastInterEMT()
+#endif
+    , NULL
+#if JVET_K0248_GBI
+    , &equGBiCost
 #endif
   );
 }
@@ -42,6 +42,7 @@
 #include "EncLib.h"
 #include "EncGOP.h"
 #include "Analyze.h"
+#include "EncAnalysis.h"
 #include "libmd5/MD5.h"
 #include "CommonLib/SEI.h"
 #include "CommonLib/NAL.h"
@@ -58,10 +59,54 @@
 
 #include "DecoderLib/DecLib.h"
 
+#if ENABLE_FRAME_PARALLELISM || ENABLE_LOOP_FILTER_PARALLELISM
+#include <omp.h>
+#endif
+#if ENABLE_FRAME_PARALLELISM
+#include <mutex>
+#include <condition_variable>
+#endif
+
 #define ENCODE_SUB_SET 0
 
 using namespace std;
 
+#if ENABLE_FRAME_PARALLELISM
+/**
+ - Orders the sequential steps of the pictures compressed by the frame threads
+ - the steps of a batch are: the setup of each picture, followed by the finishing (loop filters, writing) of each
+   picture, both in coding order; the compression of the pictures runs concurrently in between
+ .
+ */
+class FrameStepSync
+{
+public:
+  FrameStepSync() : m_step( 0 ) {}
+
+  void wait( int step )
+  {
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while( m_step < step )
+    {
+      m_cv.wait( lock );
+    }
+  }
+
+  void done()
+  {
+    std::unique_lock< std::mutex > lock( m_mutex );
+    m_step++;
+    m_cv.notify_all();
+  }
+
+private:
+  int                     m_step;
+  std::condition_variable m_cv;
+  std::mutex              m_mutex;
+};
+#endif
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -280,6 +325,9 @@ EncGOP::EncGOP()
 
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
+#if ENABLE_FRAME_PARALLELISM
+  m_encCABACTableIdx    = I_SLICE;
+#endif
   m_pcListPic           = NULL;
   m_HLSWriter           = NULL;
   m_bSeqFirst           = true;
@@ -293,9 +341,9 @@ EncGOP::EncGOP()
   m_bufferingPeriodSEIPresentInAU = false;
   m_associatedIRAPType  = NAL_UNIT_CODED_SLICE_IDR_N_LP;
   m_associatedIRAPPOC   = 0;
-#if W0038_DB_OPT
-  m_pcDeblockingTempPicYuv = NULL;
-#endif
+  m_picSSEPic           = NULL;
+  ::memset(m_layerBits, 0, sizeof(m_layerBits));
+  ::memset(m_layerNumPics, 0, sizeof(m_layerNumPics));
 
   m_bInitAMaxBT         = true;
 #if JVET_K0157
@@ -311,7 +359,7 @@ EncGOP::EncGOP()
 
 EncGOP::~EncGOP()
 {
-  if( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() )
+  if( m_pcCfg && ( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() ) )
   {
     // reset potential decoder resources
     tryDecodePicture( NULL, 0, std::string("") );
@@ -328,13 +376,21 @@ void  EncGOP::create()
 
 void  EncGOP::destroy()
 {
+  if( m_picSSEJob.valid() )
+  {
+    m_picSSEJob.wait();
+  }
+  m_picSSEPic = NULL;
 #if W0038_DB_OPT
-  if (m_pcDeblockingTempPicYuv)
+  for( size_t i = 0; i < m_deblockingTrialPicYuv.size(); i++ )
   {
-    m_pcDeblockingTempPicYuv->destroy();
-    delete m_pcDeblockingTempPicYuv;
-    m_pcDeblockingTempPicYuv = NULL;
+    m_deblockingTrialPicYuv[i]->destroy();
+    delete m_deblockingTrialPicYuv[i];
+    m_deblockingTrialFilters[i]->destroy();
+    delete m_deblockingTrialFilters[i];
   }
+  m_deblockingTrialPicYuv.clear();
+  m_deblockingTrialFilters.clear();
 #endif
 #if JVET_K0157
   if (m_picBg)
@@ -1517,8 +1573,6 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 {
   // TODO: Split this function up.
 
-  Picture*        pcPic = NULL;
-  Slice*      pcSlice;
   OutputBitstream  *pcBitstreamRedirect;
   pcBitstreamRedirect = new OutputBitstream;
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
@@ -1549,8 +1603,41 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
+#if ENABLE_FRAME_PARALLELISM
+  // in all-intra coding, the pictures collected for the frame threads are all coded with the single GOP entry
+  const int numGOPPics = !isField && iNumPicRcvd > m_iGopSize ? iNumPicRcvd : m_iGopSize;
+  std::vector<int> batchStart, batchSize;
+  const int numFrameJobs = xInitFrameBatches( isField, numGOPPics, batchStart, batchSize );
+  FrameStepSync frameSync;
+
+#pragma omp parallel num_threads( numFrameJobs ) if( numFrameJobs > 1 )
+  {
+  const int frameJobId = omp_get_thread_num();
+
+  for( int picIdx = 0; picIdx < numGOPPics; picIdx++ )
+  {
+    int iGOPid = numGOPPics > m_iGopSize ? 0 : picIdx;
+
+    // the k-th picture of a batch is compressed by the k-th frame thread using its own encoder stack
+    if( picIdx - batchStart[picIdx] != frameJobId )
+    {
+      continue;
+    }
+    const int setupStep    = batchStart[picIdx] + picIdx;
+    const int compressStep = batchStart[picIdx] * 2 + batchSize[picIdx];
+    const int finishStep   = setupStep + batchSize[picIdx];
+    const bool lastInBatch = picIdx - batchStart[picIdx] == batchSize[picIdx] - 1;
+
+    frameSync.wait( setupStep );
+    EncSlice* pcSliceEncoder = m_pcEncLib->getFrameEncoder( frameJobId )->getSliceEncoder();
+#else
   for ( int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
+    EncSlice* pcSliceEncoder = m_pcSliceEncoder;
+#endif
+    Picture*  pcPic          = NULL;
+    Slice*    pcSlice        = NULL;
+
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
       iGOPid=effFieldIRAPMap.adjustGOPid(iGOPid);
@@ -1592,6 +1679,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - ((isField && m_iGopSize>1) ? 1:0);
 #endif
       iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
+#if ENABLE_FRAME_PARALLELISM
+      pocCurr     += picIdx - iGOPid;
+      iTimeOffset += picIdx - iGOPid;
+#endif
     }
 
 #if JVET_K0157
@@ -1609,6 +1700,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       {
         iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
       }
+#if ENABLE_FRAME_PARALLELISM
+      frameSync.done();
+      frameSync.wait( finishStep );
+      frameSync.done();
+#endif
       continue;
     }
 
@@ -1636,9 +1732,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
 
 #if ENABLE_SPLIT_PARALLELISM && ENABLE_WPP_PARALLELISM
-    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), m_pcCfg->getNumSplitThreads() );
+    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), m_pcCfg->getNumSplitThreads(), m_pcCfg->getNumSplitLevels() );
 #elif ENABLE_SPLIT_PARALLELISM
-    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, 1                          , 0                             , m_pcCfg->getNumSplitThreads() );
+    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, 1                          , 0                             , m_pcCfg->getNumSplitThreads(), m_pcCfg->getNumSplitLevels() );
 #elif ENABLE_WPP_PARALLELISM
     pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), 1                             );
 #endif
@@ -1648,9 +1744,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
-    m_pcSliceEncoder->setSliceSegmentIdx(0);
+    pcSliceEncoder->setSliceSegmentIdx(0);
 
-    m_pcSliceEncoder->initEncSlice(pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField
+    pcSliceEncoder->initEncSlice(pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField
 #if JVET_K0157
       , isEncodeLtRef
 #endif
@@ -1917,8 +2013,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
             pcSlice->setMaxBTSize( 128 > MAX_BT_SIZE_INTER ? MAX_BT_SIZE_INTER : 128 );
           }
 
-          m_uiBlkSize[refLayer] = 0;
-          m_uiNumBlk [refLayer] = 0;
+#if ENABLE_FRAME_PARALLELISM
+          // the pictures of a batch share the statistics of the previously coded pictures of their layer
+          if( lastInBatch )
+#endif
+          {
+            m_uiBlkSize[refLayer] = 0;
+            m_uiNumBlk [refLayer] = 0;
+          }
         }
       }
       else
@@ -1939,7 +2041,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     {
       pcSlice->setSliceType ( P_SLICE );
     }
-#if JVET_K0076_CPR
+#if JVET_K0076_CPR && !ENABLE_FRAME_PARALLELISM
     if (pcSlice->getSPS()->getSpsNext().getIBCMode() && pcSlice->isIRAP())
     {
       m_pcSliceEncoder->setEncCABACTableIdx(P_SLICE);
@@ -1955,6 +2057,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
 #endif
 
+#if ENABLE_FRAME_PARALLELISM
+    xSetEncCABACTableIdx( pcSlice, pcSliceEncoder );
+#else
     if ( pcSlice->getPendingRasInit() )
     {
       // this ensures that independently encoded bitstream chunks can be combined to bit-equal
@@ -1964,6 +2069,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     {
       pcSlice->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
     }
+#endif
 
     if (pcSlice->getSliceType() == B_SLICE)
     {
@@ -2060,7 +2166,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && !pcSlice->isIRAP())
     {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
+      pcSliceEncoder->setSearchRange(pcSlice);
     }
 
     bool bGPBcheck=false;
@@ -2126,6 +2232,16 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       m_pcRateCtrl->initRCPic( frameLevel );
       estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
+      const EncRCStats* stats = m_pcRateCtrl->getRCSeq()->getFirstPassStats();
+      if ( stats )
+      {
+        const TRCPicStats& picStats = stats->getPicture( m_pcRateCtrl->getRCPic()->getCodingIdx() );
+        if ( picStats.m_POC != pcSlice->getPOC() || picStats.m_LCUBits.size() != pcPic->cs->pcv->sizeInCtus )
+        {
+          EXIT( "The rate control statistics do not match POC " << pcSlice->getPOC() << ", the first pass has to use the same configuration" );
+        }
+      }
+
 #if U0132_TARGET_BITS_SATURATION
       if (m_pcRateCtrl->getCpbSaturationEnabled() && frameLevel != 0)
       {
@@ -2179,9 +2295,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
-        if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+        // do not refine allocated bits for all intra case or when they come from first-pass statistics
+        if ( m_pcCfg->getIntraPeriod() != 1 && !m_pcRateCtrl->getRCSeq()->getFirstPassStats() )
         {
           int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
           bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
@@ -2235,7 +2352,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+      pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+    }
+    else if ( m_pcCfg->getRCPass() == 1 )
+    {
+      m_pcCfg->getRCStats()->initPicture( pcPic->cs->pcv->sizeInCtus );
     }
 
     uint32_t uiNumSliceSegments = 1;
@@ -2310,8 +2431,13 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       // overwrite chroma qp offset for dual tree
       pcSlice->setSliceChromaQpDelta(COMPONENT_Cb, m_pcCfg->getChromaCbQpOffsetDualTree());
       pcSlice->setSliceChromaQpDelta(COMPONENT_Cr, m_pcCfg->getChromaCrQpOffsetDualTree());
-      m_pcSliceEncoder->setUpLambda(pcSlice, pcSlice->getLambdas()[0], pcSlice->getSliceQp());
+      pcSliceEncoder->setUpLambda(pcSlice, pcSlice->getLambdas()[0], pcSlice->getSliceQp());
     }
+#if ENABLE_FRAME_PARALLELISM
+    // the compression of a batch starts as soon as all of its pictures are set up
+    frameSync.done();
+    frameSync.wait( compressStep );
+#endif
     if( encPic )
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
@@ -2324,8 +2450,8 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
       for(uint32_t nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
       {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        pcSliceEncoder->precompressSlice( pcPic );
+        pcSliceEncoder->compressSlice   ( pcPic, false, false );
 
 #if HEVC_DEPENDENT_SLICES
         const uint32_t curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
@@ -2336,7 +2462,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
           uint32_t independentSliceIdx                = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
           // prepare for next slice
-          m_pcSliceEncoder->setSliceSegmentIdx      ( uiNumSliceSegments   );
+          pcSliceEncoder->setSliceSegmentIdx        ( uiNumSliceSegments   );
           pcSlice = pcPic->slices                   [ uiNumSliceSegments   ];
           CHECK(!(pcSlice->getPPS()!=0), "Unspecified error");
           pcSlice->copySliceInfo                    ( pcPic->slices[uiNumSliceSegments-1]  );
@@ -2365,7 +2491,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           uint32_t independentSliceIdx = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
-          m_pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
+          pcSliceEncoder->setSliceSegmentIdx        (uiNumSliceSegments);
           // prepare for next slice
           pcSlice = pcPic->slices[uiNumSliceSegments];
           CHECK(!(pcSlice->getPPS() != 0), "Unspecified error");
@@ -2380,6 +2506,16 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #endif
       }
 
+#if ENABLE_FRAME_PARALLELISM
+      frameSync.wait( finishStep );
+
+      // the pictures of a batch following the first were compressed before their predecessor was written, they are written
+      // with the table of their predecessor like in a sequential encode
+      for( auto slice : pcPic->slices )
+      {
+        xSetEncCABACTableIdx( slice, pcSliceEncoder );
+      }
+#endif
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
@@ -2485,6 +2621,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
     else // skip enc picture
     {
+#if ENABLE_FRAME_PARALLELISM
+      frameSync.wait( finishStep );
+#endif
       pcSlice->setSliceQpBase( pcSlice->getSliceQp() );
 #if JEM_TOOLS
 #if JEM_TOOLS
@@ -2530,6 +2669,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
     }
 
+    if( encPic && m_pcCfg->getAnalysisMode() == ANALYSIS_RECORD )
+    {
+      m_pcCfg->getAnalysis()->addPicture( *pcPic->cs );
+    }
+
     if( encPic || decPic )
     {
 #if JEM_TOOLS && !JVET_K0371_ALF
@@ -2537,6 +2681,13 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #endif
       pcSlice = pcPic->slices[0];
 
+      // the reconstruction is final, measure its distortion on a helper thread while the access unit is written
+      m_picSSEPic = pcPic;
+      m_picSSEJob = std::async( std::launch::async, [this, pcPic]()
+      {
+        xCalculatePicSSEs( pcPic, pcPic->getRecoBuf(), m_picSSE, m_picSSEWeighted );
+      } );
+
       /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
 
       // write various parameter sets
@@ -2756,6 +2907,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         }
   #endif
       }
+      else if ( m_pcCfg->getRCPass() == 1 )
+      {
+        m_pcCfg->getRCStats()->addPicture( pcSlice->getPOC(), pcSlice->getSliceQp(), actualHeadBits, actualTotalBits );
+      }
 
       xCreatePictureTimingSEI( m_pcCfg->getEfficientFieldIRAPEnabled() ? effFieldIRAPMap.GetIRAPGOPid() : 0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData );
       if( m_pcCfg->getScalableNestingSEIEnabled() )
@@ -2794,7 +2949,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyCoeffs();
     pcPic->cs->releaseIntermediateData();
+#if ENABLE_FRAME_PARALLELISM
+    m_encCABACTableIdx = m_pcSliceEncoder->getEncCABACTableIdx();
+    frameSync.done();
+#endif
   } // iGOPid-loop
+#if ENABLE_FRAME_PARALLELISM
+  }
+#endif
 
   delete pcBitstreamRedirect;
 
@@ -2902,13 +3064,16 @@ void EncGOP::printOutSummary(uint32_t uiNumAllPicCoded, bool isField, const bool
 }
 
 #if W0038_DB_OPT
-uint64_t EncGOP::preLoopFilterPicAndCalcDist( Picture* pcPic )
+uint64_t EncGOP::preLoopFilterPicAndCalcDist( Picture* pcPic, const int threadId, const int betaOffsetDiv2, const int tcOffsetDiv2 )
 {
   CodingStructure& cs = *pcPic->cs;
-  m_pcLoopFilter->loopFilterPic( cs );
+  PelUnitBuf picRec   = *m_deblockingTrialPicYuv[threadId];
+
+  // the trial deblocks a copy of the reconstruction, the picture itself is not touched
+  picRec.copyFrom( pcPic->getRecoBuf() );
+  m_deblockingTrialFilters[threadId]->loopFilterPicTrial( cs, picRec, betaOffsetDiv2, tcOffsetDiv2 );
 
-  const CPelUnitBuf picOrg = pcPic->getRecoBuf();
-  const CPelUnitBuf picRec = cs.getRecoBuf();
+  const CPelUnitBuf picOrg = pcPic->getOrigBuf();
 
   uint64_t uiDist = 0;
   for( uint32_t comp = 0; comp < (uint32_t)picRec.bufs.size(); comp++)
@@ -3003,6 +3168,80 @@ void EncGOP::xGetBuffer( PicList&                  rcListPic,
   return;
 }
 
+#if ENABLE_FRAME_PARALLELISM
+/** Groups the pictures of the GOP into batches of consecutive pictures, that can be compressed concurrently.
+ * The pictures of a batch belong to the same temporal layer and do not reference each other,
+ * all-intra pictures (more pictures than GOP entries) are always independent.
+ * \returns the number of frame threads needed for the largest batch
+ */
+int EncGOP::xInitFrameBatches( bool isField, int numPics, std::vector<int>& batchStart, std::vector<int>& batchSize ) const
+{
+  const int maxBatchSize = isField ? 1 : m_pcCfg->getNumFrameThreads();
+  const bool allIntra    = numPics > m_iGopSize;
+  int       numJobs      = 1;
+
+  batchStart.resize( numPics );
+  batchSize .resize( numPics );
+
+  for( int start = 0; start < numPics; )
+  {
+    int size = 1;
+
+    while( start + size < numPics && size < maxBatchSize )
+    {
+      const GOPEntry& cand = m_pcCfg->getGOPEntry( allIntra ? 0 : start + size );
+      bool independent     = allIntra || cand.m_temporalId == m_pcCfg->getGOPEntry( start ).m_temporalId;
+
+      for( int i = start; i < start + size && independent && !allIntra; i++ )
+      {
+        const GOPEntry& pic = m_pcCfg->getGOPEntry( i );
+
+        for( int j = 0; j < cand.m_numRefPics && independent; j++ )
+        {
+          independent = cand.m_POC + cand.m_referencePics[j] != pic.m_POC;
+        }
+        for( int j = 0; j < pic.m_numRefPics && independent; j++ )
+        {
+          independent = pic.m_POC + pic.m_referencePics[j] != cand.m_POC;
+        }
+      }
+      if( !independent )
+      {
+        break;
+      }
+      size++;
+    }
+
+    for( int i = start; i < start + size; i++ )
+    {
+      batchStart[i] = start;
+      batchSize [i] = size;
+    }
+    numJobs = std::max( numJobs, size );
+    start  += size;
+  }
+
+  return numJobs;
+}
+
+/** Sets the CABAC initialization table of a slice from the table chosen when writing the previously written picture.
+ * The table is kept by the slice encoder of the frame thread, so that the IRAP pictures with CPR only affect their own slices.
+ */
+void EncGOP::xSetEncCABACTableIdx( Slice* pcSlice, EncSlice* pcSliceEncoder ) const
+{
+  pcSliceEncoder->setEncCABACTableIdx( m_encCABACTableIdx );
+#if JVET_K0076_CPR
+  if( pcSlice->getSPS()->getSpsNext().getIBCMode() && pcSlice->isIRAP() )
+  {
+    pcSliceEncoder->setEncCABACTableIdx( P_SLICE );
+  }
+#endif
+
+  // the slice type ensures that independently encoded bitstream chunks can be combined to bit-equal
+  pcSlice->setEncCABACTableIdx( pcSlice->getPendingRasInit() ? pcSlice->getSliceType() : pcSliceEncoder->getEncCABACTableIdx() );
+}
+#endif
+
 #if ENABLE_QPA
 
 #ifndef BETA
@@ -3100,18 +3339,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            uiTotalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return RdCost::getSSEPlane(pic0, pic1);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -3166,17 +3394,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    uiTotalDiff = RdCost::getSSEPlane(pic0, pic1);
   }
 
   return uiTotalDiff;
@@ -3318,6 +3536,45 @@ void EncGOP::xCalculateAddPSNRs( const bool isField, const bool isFieldTopFieldF
   }
 }
 
+void EncGOP::xCalculatePicSSEs( const Picture* pcPic, const CPelUnitBuf& pic, uint64_t* picSSE, double* picSSEWeighted )
+{
+  const CPelUnitBuf& org        = pcPic->getOrigBuf();
+  const ChromaFormat format     = pcPic->cs->sps->getChromaFormatIdc();
+  const bool         bPicIsField = pcPic->fieldPic;
+#if ENABLE_QPA
+  const bool         useWPSNR   = m_pcEncLib->getUseWPSNR();
+#endif
+
+  for (int comp = 0; comp < ::getNumberValidComponents(pic.chromaFormat); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf&    p = pic.get(compID);
+    const CPelBuf&    o = org.get(compID);
+
+    CHECK(!( p.width  == o.width), "Unspecified error");
+    CHECK(!( p.height == o.height), "Unspecified error");
+
+    const uint32_t   width  = p.width  - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(compID, format));
+    const uint32_t   height = p.height - (m_pcEncLib->getPad(1) >> (!!bPicIsField+::getComponentScaleY(compID,format)));
+
+    // create new buffers with correct dimensions
+    const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
+    const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
+#if ENABLE_QPA
+    const uint32_t    bitDepth = pcPic->cs->sps->getBitDepth(toChannelType(compID));
+    picSSE[comp] = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format));
+    picSSEWeighted[comp] = 0.0;
+#else
+    picSSE[comp] = xFindDistortionPlane(recPB, orgPB, 0);
+#if WCG_WPSNR
+    picSSEWeighted[comp] = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+#else
+    picSSEWeighted[comp] = 0.0;
+#endif
+#endif
+  }
+}
+
 void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit& accessUnit, double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, double* PSNR_Y
 #if JVET_K0157
                               , bool isEncodeLtRef
@@ -3327,9 +3584,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   const SPS&         sps = *pcPic->cs->sps;
   const CPelUnitBuf& pic = cPicD;
   CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
-//  const CPelUnitBuf& org = (conversion != IPCOLOURSPACE_UNCHANGED) ? pcPic->getPicYuvTrueOrg()->getBuf() : pcPic->getPicYuvOrg()->getBuf();
-  const CPelUnitBuf& org = pcPic->getOrigBuf();
-#if ENABLE_QPA
+#if ENABLE_QPA && FRAME_WEIGHTING
   const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
 #endif
   double  dPSNR[MAX_NUM_COMPONENT];
@@ -3357,6 +3612,24 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
   const CPelUnitBuf& picC = (conversion == IPCOLOURSPACE_UNCHANGED) ? pic : interm;
 
+  uint64_t picSSE        [MAX_NUM_COMPONENT] = { 0, 0, 0 };
+  double   picSSEWeighted[MAX_NUM_COMPONENT] = { 0.0, 0.0, 0.0 };
+
+  if( m_picSSEJob.valid() )
+  {
+    m_picSSEJob.get();
+  }
+  if( m_picSSEPic == pcPic && picC.Y().buf == pcPic->getRecoBuf().Y().buf )
+  {
+    std::copy( m_picSSE,         m_picSSE         + MAX_NUM_COMPONENT, picSSE );
+    std::copy( m_picSSEWeighted, m_picSSEWeighted + MAX_NUM_COMPONENT, picSSEWeighted );
+  }
+  else
+  {
+    xCalculatePicSSEs( pcPic, picC, picSSE, picSSEWeighted );
+  }
+  m_picSSEPic = NULL;
+
   //===== calculate PSNR =====
   double MSEyuvframe[MAX_NUM_COMPONENT] = {0, 0, 0};
   const ChromaFormat formatD = pic.chromaFormat;
@@ -3374,25 +3647,17 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   {
     const ComponentID compID = ComponentID(comp);
     const CPelBuf&    p = picC.get(compID);
-    const CPelBuf&    o = org.get(compID);
-
-    CHECK(!( p.width  == o.width), "Unspecified error");
-    CHECK(!( p.height == o.height), "Unspecified error");
 
     const uint32_t   width  = p.width  - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(compID, format));
     const uint32_t   height = p.height - (m_pcEncLib->getPad(1) >> (!!bPicIsField+::getComponentScaleY(compID,format)));
 
-    // create new buffers with correct dimensions
-    const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
-    const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
     const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    const uint64_t uiSSDtemp = picSSE[comp];
 #if ENABLE_QPA
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format));
     const uint32_t maxval = /*useWPSNR ? (1 << bitDepth) - 1 :*/ 255 << (bitDepth - 8); // fix with WPSNR: 1023 (4095) instead of 1020 (4080) for bit-depth 10 (12)
 #else
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, 0);
 #if WCG_WPSNR
-    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+    const double uiSSDtempWeighted = picSSEWeighted[comp];
 #endif
     const uint32_t maxval = 255 << (bitDepth - 8);
 #endif
@@ -3471,6 +3736,11 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     m_ext360.addResult(m_gcAnalyzeI);
 #endif
   }
+  else
+  {
+    m_layerBits   [pcSlice->getTLayer()] += uibits;
+    m_layerNumPics[pcSlice->getTLayer()]++;
+  }
   if (pcSlice->isInterP())
   {
     m_gcAnalyzeP.addResult(dPSNR, (double)uibits, MSEyuvframe
@@ -4276,22 +4546,28 @@ void EncGOP::applyDeblockingFilterParameterSelection( Picture* pcPic, const uint
   const int MAX_TC_OFFSET = 3;
   const int MIN_TC_OFFSET = -3;
 
-  PelUnitBuf reco = pcPic->getRecoBuf();
-
   const int currQualityLayer = (!pcPic->slices[0]->isIRAP()) ? m_pcCfg->getGOPEntry(gopID).m_temporalId+1 : 0;
   CHECK(!(currQualityLayer <MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS), "Unspecified error");
 
   CodingStructure& cs = *pcPic->cs;
 
-  if(!m_pcDeblockingTempPicYuv)
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  const int numThreads = std::min( m_pcCfg->getNumLoopFilterThreads(), MAX_TC_OFFSET - MIN_TC_OFFSET + 1 );
+#else
+  const int numThreads = 1;
+#endif
+
+  if( m_deblockingTrialPicYuv.empty() )
   {
-    m_pcDeblockingTempPicYuv = new PelStorage;
-    m_pcDeblockingTempPicYuv->create( cs.area );
     memset(m_DBParam, 0, sizeof(m_DBParam));
   }
-
-  //preserve current reconstruction
-  m_pcDeblockingTempPicYuv->copyFrom ( reco );
+  while( (int)m_deblockingTrialPicYuv.size() < numThreads )
+  {
+    m_deblockingTrialPicYuv.push_back( new PelStorage );
+    m_deblockingTrialPicYuv.back()->create( cs.area );
+    m_deblockingTrialFilters.push_back( new LoopFilter );
+    m_deblockingTrialFilters.back()->create( m_pcCfg->getMaxCodingDepth() );
+  }
 
   const bool bNoFiltering      = m_DBParam[currQualityLayer][DBFLT_PARAM_AVAILABLE] && m_DBParam[currQualityLayer][DBFLT_DISABLE_FLAG]==false /*&& pcPic->getTLayer()==0*/;
   const int  maxBetaOffsetDiv2 = bNoFiltering? Clip3(MIN_BETA_OFFSET, MAX_BETA_OFFSET, m_DBParam[currQualityLayer][DBFLT_BETA_OFFSETD2]+1) : MAX_BETA_OFFSET;
@@ -4307,22 +4583,28 @@ void EncGOP::applyDeblockingFilterParameterSelection( Picture* pcPic, const uint
 
   for(int betaOffsetDiv2=maxBetaOffsetDiv2; betaOffsetDiv2>=minBetaOffsetDiv2; betaOffsetDiv2--)
   {
+    // all tc offsets of a beta offset are tried at once, concurrently if possible, the search below can stop a row only
+    // after the smallest tc offset, so exactly the same trials are evaluated as in a sequential search
+    const int numTcOffsets = maxTcOffsetDiv2 - minTcOffsetDiv2 + 1;
+    uint64_t  distTc[MAX_TC_OFFSET - MIN_TC_OFFSET + 1];
+
+#if ENABLE_LOOP_FILTER_PARALLELISM
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+#endif
+    for( int tcIdx = 0; tcIdx < numTcOffsets; tcIdx++ )
+    {
+#if ENABLE_LOOP_FILTER_PARALLELISM
+      const int threadId = omp_get_thread_num();
+#else
+      const int threadId = 0;
+#endif
+      distTc[tcIdx] = preLoopFilterPicAndCalcDist( pcPic, threadId, betaOffsetDiv2, maxTcOffsetDiv2 - tcIdx );
+    }
+
     uint64_t distTcMin = std::numeric_limits<uint64_t>::max();
     for(int tcOffsetDiv2=maxTcOffsetDiv2; tcOffsetDiv2 >= minTcOffsetDiv2; tcOffsetDiv2--)
     {
-      for (int i=0; i<numSlices; i++)
-      {
-        Slice* pcSlice = pcPic->slices[i];
-        pcSlice->setDeblockingFilterOverrideFlag  ( true);
-        pcSlice->setDeblockingFilterDisable       ( false);
-        pcSlice->setDeblockingFilterBetaOffsetDiv2( betaOffsetDiv2 );
-        pcSlice->setDeblockingFilterTcOffsetDiv2  ( tcOffsetDiv2 );
-      }
-
-      // restore reconstruction
-      reco.copyFrom( *m_pcDeblockingTempPicYuv );
-
-      const uint64_t dist = preLoopFilterPicAndCalcDist( pcPic );
+      const uint64_t dist = distTc[maxTcOffsetDiv2 - tcOffsetDiv2];
 
       if(dist < distMin)
       {
@@ -4353,9 +4635,6 @@ void EncGOP::applyDeblockingFilterParameterSelection( Picture* pcPic, const uint
   m_DBParam[currQualityLayer][DBFLT_BETA_OFFSETD2]   = betaOffsetDiv2Best;
   m_DBParam[currQualityLayer][DBFLT_TC_OFFSETD2]     = tcOffsetDiv2Best;
 
-  // restore reconstruction
-  reco.copyFrom( *m_pcDeblockingTempPicYuv );
-
   const PPS* pcPPS = pcPic->slices[0]->getPPS();
   if(bDBFilterDisabledBest)
   {
@@ -39,6 +39,7 @@
 #define __ENCGOP__
 
 #include <list>
+#include <future>
 
 #include <stdlib.h>
 
@@ -99,6 +100,8 @@ private:
 #if WCG_WPSNR
   Analyze                 m_gcAnalyzeWPSNR;
 #endif
+  double                  m_layerBits[MAX_TLAYER];      ///< bits of the non-intra pictures of each temporal layer
+  int                     m_layerNumPics[MAX_TLAYER];   ///< number of non-intra pictures of each temporal layer
   Analyze                 m_gcAnalyzeAll_in;
 #if EXTENSION_360_VIDEO
   TExt360EncGop           m_ext360;
@@ -161,15 +164,23 @@ private:
   bool                    m_bufferingPeriodSEIPresentInAU;
   SEIEncoder              m_seiEncoder;
 #if W0038_DB_OPT
-  PelStorage*             m_pcDeblockingTempPicYuv;
+  std::vector<PelStorage*> m_deblockingTrialPicYuv;                              ///< trial reconstructions of the deblocking parameter selection, one per thread
+  std::vector<LoopFilter*> m_deblockingTrialFilters;
   int                     m_DBParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS][4];   //[layer_id][0: available; 1: bDBDisabled; 2: Beta Offset Div2; 3: Tc Offset Div2;]
 #endif
+  std::future<void>       m_picSSEJob;                                           ///< distortion of the final reconstruction, measured while the access unit is written
+  const Picture*          m_picSSEPic;
+  uint64_t                m_picSSE[MAX_NUM_COMPONENT];
+  double                  m_picSSEWeighted[MAX_NUM_COMPONENT];
 
   // members needed for adaptive max BT size
   uint32_t                    m_uiBlkSize[10];
   uint32_t                    m_uiNumBlk[10];
   uint32_t                    m_uiPrevISlicePOC;
   bool                    m_bInitAMaxBT;
+#if ENABLE_FRAME_PARALLELISM
+  SliceType               m_encCABACTableIdx;   ///< CABAC initialization table chosen when writing the last picture
+#endif
 
   AUWriterIf*             m_AUWriterIf;
 
@@ -212,7 +223,7 @@ public:
 #endif
   void  printOutSummary      ( uint32_t uiNumAllPicCoded, bool isField, const bool printMSEBasedSNR, const bool printSequenceMSE, const bool printHexPsnr, const BitDepths &bitDepths );
 #if W0038_DB_OPT
-  uint64_t  preLoopFilterPicAndCalcDist( Picture* pcPic );
+  uint64_t  preLoopFilterPicAndCalcDist( Picture* pcPic, const int threadId, const int betaOffsetDiv2, const int tcOffsetDiv2 );
 #endif
   EncSlice*  getSliceEncoder()   { return m_pcSliceEncoder; }
   NalUnitType getNalUnitType( int pocCurr, int lastIdr, bool isField );
@@ -222,8 +233,9 @@ public:
   void updateCompositeReference(Slice* pcSlice, PicList& rcListPic, int pocCurr);
 #endif
 
-#if EXTENSION_360_VIDEO
   Analyze& getAnalyzeAllData() { return m_gcAnalyzeAll; }
+  double   getLayerBits( int tId ) const { return m_layerNumPics[tId] ? m_layerBits[tId] / m_layerNumPics[tId] : 0.0; }   ///< average bits per non-intra picture of temporal layer tId
+#if EXTENSION_360_VIDEO
   Analyze& getAnalyzeIData() { return m_gcAnalyzeI; }
   Analyze& getAnalyzePData() { return m_gcAnalyzeP; }
   Analyze& getAnalyzeBData() { return m_gcAnalyzeB; }
@@ -241,6 +253,10 @@ protected:
   );
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                             int iNumPicRcvd, int iTimeOffset, Picture*& rpcPic, int pocCurr, bool isField );
+#if ENABLE_FRAME_PARALLELISM
+  int   xInitFrameBatches ( bool isField, int numPics, std::vector<int>& batchStart, std::vector<int>& batchSize ) const;
+  void  xSetEncCABACTableIdx( Slice* pcSlice, EncSlice* pcSliceEncoder ) const;
+#endif
 
   void  xCalculateAddPSNRs(const bool isField, const bool isFieldTopFieldFirst, const int iGOPid, Picture* pcPic, const AccessUnit&accessUnit, PicList &rcListPic, int64_t dEncTime, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, double* PSNR_Y
 #if JVET_K0157
@@ -260,6 +276,7 @@ protected:
 #endif
   );
 
+  void  xCalculatePicSSEs( const Picture* pcPic, const CPelUnitBuf& pic, uint64_t* picSSE, double* picSSEWeighted );
   uint64_t xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift
 #if ENABLE_QPA
                             , const uint32_t chromaShift = 0
@@ -70,6 +70,9 @@ EncLib::EncLib()
   m_uiNumAllPicCoded  =  0;
 
   m_iMaxRefPicNum     = 0;
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  m_isFrameEncoder    = false;
+#endif
 
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
@@ -83,6 +86,9 @@ EncLib::~EncLib()
 void EncLib::create ()
 {
   // initialize global variables
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  if( !m_isFrameEncoder )
+#endif
   initROM();
 
 
@@ -95,7 +101,7 @@ void EncLib::create ()
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if ENABLE_SPLIT_PARALLELISM
-  m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
+  m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : Scheduler::getNumSplitJobSlots( m_numSplitLevels );
 #else
   m_numCuEncStacks  = 1;
 #endif
@@ -138,6 +144,9 @@ void EncLib::create ()
   {
     m_cEncSAO.create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, m_log2SaoOffsetScale[CHANNEL_TYPE_LUMA], m_log2SaoOffsetScale[CHANNEL_TYPE_CHROMA] );
     m_cEncSAO.createEncData(getSaoCtuBoundary(), numCtuInFrame);
+#if ENABLE_LOOP_FILTER_PARALLELISM
+    m_cEncSAO.setNumThreads( m_numLoopFilterThreads );
+#endif
   }
 
   m_cLoopFilter.create( m_maxTotalCUDepth );
@@ -146,6 +155,9 @@ void EncLib::create ()
   if( m_alf )
   {
     m_cEncALF.create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, m_bitDepth, m_inputBitDepth );
+#if ENABLE_LOOP_FILTER_PARALLELISM
+    m_cEncALF.setNumThreads( m_numLoopFilterThreads );
+#endif
   }
 #elif JEM_TOOLS
 
@@ -164,12 +176,62 @@ void EncLib::create ()
     m_cRateCtrl.init( m_framesToBeEncoded, m_RCTargetBitrate, (int)( (double)m_iFrameRate/m_temporalSubsampleRatio + 0.5), m_iGOPSize, m_iSourceWidth, m_iSourceHeight,
                       m_maxCUWidth, m_maxCUHeight,m_RCKeepHierarchicalBit, m_RCUseLCUSeparateModel, m_GOPList );
 #endif
+    if ( m_RCPass == 2 )
+    {
+      m_cRateCtrl.getRCSeq()->setFirstPassStats( m_RCStats );
+    }
   }
 
+#if ENABLE_FRAME_PARALLELISM
+  // every additional frame thread compresses its pictures with a complete encoder stack of its own
+  for( int fId = 1; fId < m_numFrameThreads; fId++ )
+  {
+    EncLib* frameEncoder = new EncLib;
+    static_cast<EncCfg&>( *frameEncoder ) = *this;
+    frameEncoder->setNumFrameThreads( 1 );
+    frameEncoder->m_isFrameEncoder = true;
+    frameEncoder->create();
+    m_frameEncoders.push_back( frameEncoder );
+  }
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+
+  // the slice QP candidates of DeltaQpRD are compressed with encoder stacks of their own, frame threads are not used together with them
+  for( int cId = 1; cId < m_numDeltaQpRDThreads; cId++ )
+  {
+    EncLib* qpCandEncoder = new EncLib;
+    static_cast<EncCfg&>( *qpCandEncoder ) = *this;
+#if ENABLE_FRAME_PARALLELISM
+    qpCandEncoder->setNumFrameThreads( 1 );
+#endif
+    qpCandEncoder->setNumDeltaQpRDThreads( 1 );
+    qpCandEncoder->m_isFrameEncoder = true;
+    qpCandEncoder->create();
+    m_qpCandEncoders.push_back( qpCandEncoder );
+  }
+#endif
 }
 
 void EncLib::destroy ()
 {
+#if ENABLE_FRAME_PARALLELISM
+  for( auto frameEncoder : m_frameEncoders )
+  {
+    frameEncoder->destroy();
+    delete frameEncoder;
+  }
+  m_frameEncoders.clear();
+
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  for( auto qpCandEncoder : m_qpCandEncoders )
+  {
+    qpCandEncoder->destroy();
+    delete qpCandEncoder;
+  }
+  m_qpCandEncoders.clear();
+
+#endif
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
   m_cSliceEncoder.      destroy();
@@ -227,6 +289,9 @@ void EncLib::destroy ()
 
 
   // destroy ROM
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  if( !m_isFrameEncoder )
+#endif
   destroyROM();
   return;
 }
@@ -452,6 +517,23 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
     m_cGOPEncoder.setPicOrig(picOrig);
   }
 #endif
+#if ENABLE_FRAME_PARALLELISM
+
+  for( auto frameEncoder : m_frameEncoders )
+  {
+    frameEncoder->init( isFieldCoding, auWriterIf );
+    // the GOP structure is only tracked by the GOP encoder of the main encoder
+    frameEncoder->m_cSliceEncoder.setGOPEncoder( &m_cGOPEncoder );
+  }
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+
+  for( auto qpCandEncoder : m_qpCandEncoders )
+  {
+    qpCandEncoder->init( isFieldCoding, auWriterIf );
+    qpCandEncoder->m_cSliceEncoder.setGOPEncoder( &m_cGOPEncoder );
+  }
+#endif
 }
 
 #if HEVC_USE_SCALING_LISTS
@@ -572,6 +654,22 @@ void EncLib::deletePicBuffer()
   }
 }
 
+void EncLib::createAQpLayers( std::vector<AQpLayer*>& aqLayers )
+{
+  const PPS *pps = m_ppsMap.getFirstPS();
+  const SPS *sps = m_spsMap.getPS( pps->getSPSId() );
+
+  if( getUseAdaptiveQP() )
+  {
+    const uint32_t iMaxDQPLayer = pps->getMaxCuDQPDepth()+1;
+    aqLayers.resize( iMaxDQPLayer );
+    for( uint32_t d = 0; d < iMaxDQPLayer; d++ )
+    {
+      aqLayers[d] = new AQpLayer( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getMaxCUWidth()>>d, sps->getMaxCUHeight()>>d );
+    }
+  }
+}
+
 /**
  - Application has picture buffer list with size of GOP + 1
  - Picture buffer list acts like as ring buffer
@@ -586,7 +684,7 @@ void EncLib::deletePicBuffer()
  \retval  iNumEncoded         number of encoded pictures
  */
 void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTrueOrg, const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
-                     int& iNumEncoded )
+                     int& iNumEncoded, const std::vector<AQpLayer*>* preanalyzedAQLayers )
 {
 #if JVET_K0157
   if (m_compositeRefEnabled && m_cGOPEncoder.getPicBg()->getSpliceFull() && m_iPOCLast >= 10 && m_iNumPicRcvd == 0 && m_cGOPEncoder.getEncodedLTRef() == false)
@@ -656,13 +754,25 @@ void EncLib::encode( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTru
     pcPicCurr->poc = m_iPOCLast;
 
     // compute image characteristics
-    if ( getUseAdaptiveQP() )
+    if ( getUseAdaptiveQP() && preanalyzedAQLayers )
+    {
+      CHECK( preanalyzedAQLayers->size() != pcPicCurr->aqlayer.size(), "Pre-analysis does not match the AQp layers of the picture" );
+      for( uint32_t d = 0; d < pcPicCurr->aqlayer.size(); d++ )
+      {
+        *pcPicCurr->aqlayer[d] = *( *preanalyzedAQLayers )[d];
+      }
+    }
+    else if ( getUseAdaptiveQP() )
     {
       AQpPreanalyzer::preanalyze( pcPicCurr );
     }
   }
 
+#if ENABLE_FRAME_PARALLELISM
+  if ((m_iNumPicRcvd == 0) || (!flush && (m_iPOCLast != 0) && (m_iNumPicRcvd != getNumPicsPerGOP()) && (m_iGOPSize != 0)))
+#else
   if ((m_iNumPicRcvd == 0) || (!flush && (m_iPOCLast != 0) && (m_iNumPicRcvd != m_iGOPSize) && (m_iGOPSize != 0)))
+#endif
   {
     iNumEncoded = 0;
     return;
@@ -811,7 +921,11 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   Slice::sortPicList(m_cListPic);
 
   // use an entry in the buffered list if the maximum number that need buffering has been reached:
+#if ENABLE_FRAME_PARALLELISM
+  if (m_cListPic.size() >= (uint32_t)(getNumPicsPerGOP() + getMaxDecPicBuffering(MAX_TLAYER-1) + 2) )
+#else
   if (m_cListPic.size() >= (uint32_t)(m_iGOPSize + getMaxDecPicBuffering(MAX_TLAYER-1) + 2) )
+#endif
   {
     PicList::iterator iterPic  = m_cListPic.begin();
     int iSize = int( m_cListPic.size() );
@@ -141,6 +141,15 @@ private:
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int                       m_numCuEncStacks;
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  std::vector<EncLib*>      m_frameEncoders;                      ///< encoder stacks of the additional frame threads
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  std::vector<EncLib*>      m_qpCandEncoders;                     ///< encoder stacks of the additional DeltaQpRD candidate threads
+#endif
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  bool                      m_isFrameEncoder;                     ///< encoder stack owned by another encoder, no global data
+#endif
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel                m_cacheModel;
@@ -249,6 +258,12 @@ public:
   void                   setNumCuEncStacks( int n )             { m_numCuEncStacks = n; }
   int                    getNumCuEncStacks()              const { return m_numCuEncStacks; }
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  EncLib*                getFrameEncoder( int fId )             { return fId == 0 ? this : m_frameEncoders[fId - 1]; }
+#endif
+#if ENABLE_DQP_RD_PARALLELISM
+  EncLib*                getQpCandEncoder( int cId )            { return cId == 0 ? this : m_qpCandEncoders[cId - 1]; }
+#endif
 
   // -------------------------------------------------------------------------------------------------------------------
   // encoder function
@@ -259,7 +274,11 @@ public:
                PelStorage* pcPicYuvOrg,
                PelStorage* pcPicYuvTrueOrg, const InputColourSpaceConversion snrCSC, // used for SNR calculations. Picture in original colour space.
                std::list<PelUnitBuf*>& rcListPicYuvRecOut,
-               int& iNumEncoded );
+               int& iNumEncoded,
+               const std::vector<AQpLayer*>* preanalyzedAQLayers = NULL ); // AQp pre-analysis of pcPicYuvOrg done by the caller
+
+  /// create the AQp layers of a source picture, for the pre-analysis of input pictures before they are passed to encode()
+  void createAQpLayers( std::vector<AQpLayer*>& aqLayers );
 
   /// encode several number of pictures until end-of-sequence
   void encode( bool bEos,
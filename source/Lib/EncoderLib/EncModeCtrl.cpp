@@ -36,6 +36,7 @@
 */
 
 #include "EncModeCtrl.h"
+#include "EncAnalysis.h"
 
 #include "AQp.h"
 #include "RateCtrl.h"
@@ -732,6 +733,65 @@ void BestEncInfoCache::init( const Slice &slice )
   }
 }
 
+#if ENABLE_SPLIT_PARALLELISM
+void BestEncInfoCache::copyState( const BestEncInfoCache &other, const UnitArea& area )
+{
+  m_slice_bencinf = other.m_slice_bencinf;
+
+  const int cuSizeMask = m_slice_bencinf->getSPS()->getMaxCUWidth() - 1;
+
+  const int minPosX = ( area.lx() & cuSizeMask ) >> MIN_CU_LOG2;
+  const int minPosY = ( area.ly() & cuSizeMask ) >> MIN_CU_LOG2;
+  const int maxPosX = ( area.Y().bottomRight().x & cuSizeMask ) >> MIN_CU_LOG2;
+  const int maxPosY = ( area.Y().bottomRight().y & cuSizeMask ) >> MIN_CU_LOG2;
+
+  for( unsigned x = minPosX; x <= maxPosX; x++ )
+  {
+    for( unsigned y = minPosY; y <= maxPosY; y++ )
+    {
+      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
+      {
+        const int width = gp_sizeIdxInfo->sizeFrom( wIdx );
+
+        if( m_bestEncInfo[x][y][wIdx] && width <= area.lwidth() && x + ( width >> MIN_CU_LOG2 ) <= ( maxPosX + 1 ) )
+        {
+          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
+          {
+            const int height = gp_sizeIdxInfo->sizeFrom( hIdx );
+
+            if( m_bestEncInfo[x][y][wIdx][hIdx] && height <= area.lheight() && y + ( height >> MIN_CU_LOG2 ) <= ( maxPosY + 1 ) )
+            {
+                    BestEncodingInfo& encInfo = *m_bestEncInfo[x][y][wIdx][hIdx];
+              const BestEncodingInfo& srcInfo = *other.m_bestEncInfo[x][y][wIdx][hIdx];
+
+              encInfo.poc            =  srcInfo.poc;
+              encInfo.cu.repositionTo( srcInfo.cu );
+              encInfo.pu.repositionTo( srcInfo.pu );
+              encInfo.tu.repositionTo( srcInfo.tu );
+              encInfo.cu             =  srcInfo.cu;
+              encInfo.pu             =  srcInfo.pu;
+              for( auto &blk : srcInfo.tu.blocks )
+              {
+                if( blk.valid() ) encInfo.tu.copyComponentFrom( srcInfo.tu, blk.compID );
+              }
+              encInfo.testMode       =  srcInfo.testMode;
+            }
+            else if( y + ( height >> MIN_CU_LOG2 ) > maxPosY + 1 )
+            {
+              break;
+            }
+          }
+        }
+        else if( x + ( width >> MIN_CU_LOG2 ) > maxPosX + 1 )
+        {
+          break;
+        }
+      }
+    }
+  }
+}
+
+#endif
 bool BestEncInfoCache::setFromCs( const CodingStructure& cs, const Partitioner& partitioner )
 {
   if( cs.cus.size() != 1 || cs.tus.size() != 1 || cs.pus.size() != 1 )
@@ -952,6 +1012,7 @@ static bool interHadActive( const ComprCUCtx& ctx )
 //////////////////////////////////////////////////////////////////////////
 
 EncModeCtrlMTnoRQT::EncModeCtrlMTnoRQT()
+  : m_refAnalysis( NULL )
 {
 #if !REUSE_CU_RESULTS
   CacheBlkInfoCtrl::create();
@@ -1004,6 +1065,13 @@ void EncModeCtrlMTnoRQT::initCTUEncoding( const Slice &slice )
   CHECK( !m_ComprCUCtxList.empty(), "Mode list is not empty at the beginning of a CTU" );
 
   m_slice             = &slice;
+  m_refAnalysis       = m_pcEncCfg->getAnalysisMode() == ANALYSIS_REUSE ? m_pcEncCfg->getAnalysis()->getPicture( slice.getPOC() ) : NULL;
+
+  if( m_refAnalysis && ( m_refAnalysis->ctuSizeLog2 != slice.getPPS()->pcv->maxCUWidthLog2 || m_refAnalysis->widthInCtus != slice.getPPS()->pcv->widthInCtus ) )
+  {
+    // the analysis belongs to a differently sized picture or CTU grid
+    m_refAnalysis = NULL;
+  }
 #if ENABLE_SPLIT_PARALLELISM
   m_runNextInParallel      = false;
 #endif
@@ -1052,10 +1120,12 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
 #if ENABLE_SPLIT_PARALLELISM
   if( m_runNextInParallel )
   {
+    int numParallelLevels = 1;
     for( auto &level : m_ComprCUCtxList )
     {
-      CHECK( level.isLevelSplitParallel, "Tring to parallelize a level within parallel execution!" );
+      numParallelLevels += level.isLevelSplitParallel ? 1 : 0;
     }
+    CHECK( numParallelLevels > m_pcEncCfg->getNumSplitLevels(), "Tring to parallelize more levels than configured!" );
     CHECK( cs.picture->scheduler.getSplitJobId() == 0, "Trying to run a parallel level although jobId is 0!" );
     m_runNextInParallel                          = false;
     m_ComprCUCtxList.back().isLevelSplitParallel = true;
@@ -1106,6 +1176,7 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
   const bool isReusingCu = isValid( cs, partitioner );
   cuECtx.set( IS_REUSING_CU,        isReusingCu );
 #endif
+  xInitRefCU( cs, partitioner, cuECtx );
 
 #if !JVET_K0220_ENC_CTRL
   DTRACE( g_trace_ctx, D_SAVE_LOAD, "SaveLoadTag at %d,%d (%dx%d): %d, Split: %d\n",
@@ -1398,6 +1469,55 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
   m_ComprCUCtxList.back().lastTestMode = EncTestMode();
 }
 
+const CUAnalysis* EncModeCtrlMTnoRQT::getRefCU( const CodingStructure& cs ) const
+{
+  return m_refAnalysis && cs.area.Y().valid() ? m_refAnalysis->getCoveringCU( cs.area.Y() ) : NULL;
+}
+
+void EncModeCtrlMTnoRQT::xInitRefCU( const CodingStructure& cs, const Partitioner& partitioner, ComprCUCtx& cuECtx )
+{
+  const CUAnalysis* refCU = partitioner.chType == CHANNEL_TYPE_LUMA ? getRefCU( cs ) : NULL;
+
+  cuECtx.set( REF_CU_MODE,    REF_CU_NONE );
+  cuECtx.set( REF_SKIP_SPLIT, false );
+  cuECtx.set( REF_CU_AFFINE,  false );
+
+  if( !refCU )
+  {
+    return;
+  }
+
+  // a coarser dependent encode does not split deeper than the reference did
+  cuECtx.set( REF_SKIP_SPLIT, m_slice->getSliceQp() >= m_refAnalysis->sliceQp );
+  cuECtx.set( REF_CU_AFFINE,  refCU->affine );
+
+  if( refCU->ibc )
+  {
+    cuECtx.set( REF_CU_MODE,  REF_CU_OTHER );
+  }
+  else if( refCU->predMode == MODE_INTRA )
+  {
+    cuECtx.set( REF_CU_MODE,  REF_CU_INTRA );
+  }
+  else
+  {
+    cuECtx.set( REF_CU_MODE,  refCU->skip ? REF_CU_SKIP : REF_CU_INTER );
+
+    // start the motion search of the uni-directional predictions at the motion of the reference
+    for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      const RefPicList eRefPicList = RefPicList( refList );
+      const int        refIdx      = refCU->refIdx[refList];
+      Mv               cachedMv;
+
+      if( refIdx >= 0 && refIdx < m_slice->getNumRefIdx( eRefPicList ) && !getMv( cs.area, eRefPicList, refIdx, cachedMv ) )
+      {
+        setMv( cs.area, eRefPicList, refIdx, refCU->mv[refList] );
+      }
+    }
+  }
+}
+
 void EncModeCtrlMTnoRQT::finishCULevel( Partitioner &partitioner )
 {
 #if !JVET_K0220_ENC_CTRL
@@ -1557,6 +1677,35 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     cuECtx.set( BEST_NON_SPLIT_COST, bestCS->cost );
   }
 
+  // restrict the search to the decisions of the reference encode
+  const int refCUMode = cuECtx.get<int>( REF_CU_MODE );
+
+  if( refCUMode != REF_CU_NONE )
+  {
+    if( isModeSplit( encTestmode ) && cuECtx.get<bool>( REF_SKIP_SPLIT ) )
+    {
+      return false;
+    }
+
+    if( ( refCUMode == REF_CU_INTRA || refCUMode == REF_CU_SKIP ) && encTestmode.type == ETM_INTER_ME )
+    {
+      return false;
+    }
+
+#if JEM_TOOLS || JVET_K_AFFINE
+    if( refCUMode != REF_CU_OTHER && encTestmode.type == ETM_AFFINE && !cuECtx.get<bool>( REF_CU_AFFINE ) )
+    {
+      return false;
+    }
+
+#endif
+
+    if( ( refCUMode == REF_CU_INTER || refCUMode == REF_CU_SKIP ) && ( encTestmode.type == ETM_INTRA || encTestmode.type == ETM_IPCM ) )
+    {
+      return false;
+    }
+  }
+
   if( encTestmode.type == ETM_INTRA )
   {
     if( getFastDeltaQp() )
@@ -2305,6 +2454,9 @@ void EncModeCtrlMTnoRQT::copyState( const EncModeCtrl& other, const UnitArea& ar
   this->SaveLoadEncInfoCtrl::copyState( *pOther, area );
 #endif
   this->CacheBlkInfoCtrl   ::copyState( *pOther, area );
+#if REUSE_CU_RESULTS
+  this->BestEncInfoCache   ::copyState( *pOther, area );
+#endif
 
   m_skipThreshold = pOther->m_skipThreshold;
 }
@@ -2345,10 +2497,14 @@ int EncModeCtrlMTnoRQT::getNumParallelJobs( const CodingStructure &cs, Partition
 
 bool EncModeCtrlMTnoRQT::isParallelSplit( const CodingStructure &cs, Partitioner& partitioner ) const
 {
-  if( partitioner.getImplicitSplit( cs ) != CU_DONT_SPLIT || cs.picture->scheduler.getSplitJobId() != 0 ) return false;
+  // the block a job was started for is not parallelized again by the job itself
+  if( partitioner.getImplicitSplit( cs ) != CU_DONT_SPLIT || m_runNextInParallel ) return false;
+  const int splitLvl = cs.picture->scheduler.getSplitLevel();
+  if( splitLvl >= m_pcEncCfg->getNumSplitLevels() ) return false;
   const int numJobs = getNumParallelJobs( cs, partitioner );
   const int numPxl  = partitioner.currArea().Y().area();
-  const int parlAt  = m_pcEncCfg->getNumSplitThreads() <= 3 ? 1024 : 256;
+  // outer levels are parallelized at larger blocks, leaving the nested levels a quarter of the area each
+  const int parlAt  = ( m_pcEncCfg->getNumSplitThreads() <= 3 ? 1024 : 256 ) << ( 2 * ( m_pcEncCfg->getNumSplitLevels() - 1 - splitLvl ) );
   if(  cs.slice->isIntra() && numJobs > 2 && ( numPxl == parlAt || !partitioner.canSplit( CU_QUAD_SPLIT, cs ) ) ) return true;
   if( !cs.slice->isIntra() && numJobs > 1 && ( numPxl == parlAt || !partitioner.canSplit( CU_QUAD_SPLIT, cs ) ) ) return true;
   return false;
@@ -47,6 +47,9 @@
 #include <typeinfo>
 #include <vector>
 
+struct PicAnalysis;
+struct CUAnalysis;
+
 //////////////////////////////////////////////////////////////////////////
 // Encoder modes to try out
 //////////////////////////////////////////////////////////////////////////
@@ -514,13 +517,18 @@ protected:
 
   void create   ( const ChromaFormat chFmt );
   void destroy  ();
+#if ENABLE_SPLIT_PARALLELISM
+public:
+#endif
   void init     ( const Slice &slice );
+#if ENABLE_SPLIT_PARALLELISM
+  void copyState( const BestEncInfoCache &other, const UnitArea& area );
+protected:
+#endif
 
   bool setFromCs( const CodingStructure& cs, const Partitioner& partitioner );
   bool isValid  ( const CodingStructure& cs, const Partitioner& partitioner );
 
-  // TODO: implement copyState
-
 public:
 
   BestEncInfoCache() : m_slice_bencinf( nullptr ), m_dummyCS( m_dummyCache.cuCache, m_dummyCache.puCache, m_dummyCache.tuCache ) {}
@@ -579,10 +587,26 @@ class EncModeCtrlMTnoRQT : public EncModeCtrl, public SaveLoadEncInfoCtrl, publi
 #if REUSE_CU_RESULTS
     IS_REUSING_CU,
 #endif
+    REF_CU_MODE,
+    REF_SKIP_SPLIT,
+    REF_CU_AFFINE,
     NUM_EXTRA_FEATURES
   };
 
-  unsigned m_skipThreshold;
+  /// coding mode of the CU of the multi-rate reference encode covering the current area
+  enum RefCUMode
+  {
+    REF_CU_NONE = 0,    ///< no analysis, or the reference split the area further
+    REF_CU_INTRA,
+    REF_CU_INTER,
+    REF_CU_SKIP,
+    REF_CU_OTHER        ///< covered, but no mode restriction applies (e.g. IBC)
+  };
+
+  unsigned           m_skipThreshold;
+  const PicAnalysis* m_refAnalysis;
+
+  void xInitRefCU         ( const CodingStructure& cs, const Partitioner& partitioner, ComprCUCtx& cuECtx );
 
 public:
 
@@ -600,6 +624,9 @@ public:
   virtual bool tryMode            ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner );
   virtual bool useModeResult      ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner );
 
+  /// CU of the reference encode (multi-rate or analysis file) covering the luma area of cs, NULL if there is none
+  const CUAnalysis* getRefCU      ( const CodingStructure& cs ) const;
+
 #if ENABLE_SPLIT_PARALLELISM
   virtual void copyState          ( const EncModeCtrl& other, const UnitArea& area );
 
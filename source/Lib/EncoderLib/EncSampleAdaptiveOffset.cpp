@@ -83,6 +83,9 @@ inline double xRoundIbdi(int bitDepth, double x)
 EncSampleAdaptiveOffset::EncSampleAdaptiveOffset()
 {
   m_CABACEstimator = NULL;
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  m_numThreads = 1;
+#endif
 }
 
 EncSampleAdaptiveOffset::~EncSampleAdaptiveOffset()
@@ -285,54 +288,48 @@ void EncSampleAdaptiveOffset::addPreDBFStatistics(std::vector<SAOStatData**>& bl
 
 void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats, PelUnitBuf& orgYuv, PelUnitBuf& srcYuv, CodingStructure& cs, bool isCalculatePreDeblockSamples)
 {
-  bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
-
   const PreCalcValues& pcv = *cs.pcv;
   const int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
+  // every CTU writes only its own statistics, the CTUs are shared between the threads
+#if ENABLE_LOOP_FILTER_PARALLELISM
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for( int ctuRsAddr = 0; ctuRsAddr < (int)pcv.sizeInCtus; ctuRsAddr++ )
   {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
+    bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
-  {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const uint32_t xPos   = ( ctuRsAddr % pcv.widthInCtus ) * pcv.maxCUWidth;
+    const uint32_t yPos   = ( ctuRsAddr / pcv.widthInCtus ) * pcv.maxCUHeight;
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
+    deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
 
-      //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
-      //For simplicity, here only picture boundaries are considered.
+    //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
+    //For simplicity, here only picture boundaries are considered.
 
-      isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
-      isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
-      isAboveRightAvail = ((yPos > 0) && (isRightAvail));
+    isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
+    isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
+    isAboveRightAvail = ((yPos > 0) && (isRightAvail));
 
-      for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-      {
-        const ComponentID compID = ComponentID(compIdx);
-        const CompArea& compArea = area.block( compID );
+    for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+    {
+      const ComponentID compID = ComponentID(compIdx);
+      const CompArea& compArea = area.block( compID );
 
-        int  srcStride  = srcYuv.get(compID).stride;
-        Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
+      int  srcStride  = srcYuv.get(compID).stride;
+      Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
 
-        int  orgStride  = orgYuv.get(compID).stride;
-        Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
+      int  orgStride  = orgYuv.get(compID).stride;
+      Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
 
-        getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
-                  , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
-                  , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
-                  , isCalculatePreDeblockSamples
-                  );
-      }
-      ctuRsAddr++;
+      getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
+                , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
+                , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                , isCalculatePreDeblockSamples
+                );
     }
   }
 }
@@ -1133,8 +1130,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                         , bool isCalculatePreDeblockSamples
                         )
 {
-  int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  int8_t signLeft, signRight, signDown;
+  int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   int64_t *diff, *count;
   Pel *srcLine, *orgLine;
   int* skipLinesR = m_skipLinesR[compIdx];
@@ -1162,21 +1158,10 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
+        m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, endY, -1, 1, diff, count);
+        srcLine  += endY * srcStride;
+        orgLine  += endY * orgStride;
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1184,21 +1169,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
             startX = isLeftAvail  ? 0 : 1;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, skipLinesB[typeIdx], -1, 1, diff, count);
           }
         }
       }
@@ -1207,7 +1178,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[0];
 
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
@@ -1223,50 +1193,15 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
           orgLine += orgStride;
         }
 
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-        }
-
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
+        m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, endY - startY, -srcStride, srcStride, diff, count);
+        srcLine += (endY - startY) * srcStride;
+        orgLine += (endY - startY) * orgStride;
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
-            startX = 0;
-            endX   = width;
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_calcEOStats(srcLine, srcStride, orgLine, orgStride, width, skipLinesB[typeIdx], -srcStride, srcStride, diff, count);
           }
         }
 
@@ -1276,10 +1211,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1290,50 +1221,18 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
+        m_calcEOStats(srcLine + firstLineStartX, srcStride, orgLine + firstLineStartX, orgStride, firstLineEndX - firstLineStartX, 1, -srcStride - 1, srcStride + 1, diff, count);
         srcLine  += srcStride;
         orgLine  += orgStride;
 
-
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
+        m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, endY - 1, -srcStride - 1, srcStride + 1, diff, count);
+        srcLine += (endY - 1) * srcStride;
+        orgLine += (endY - 1) * orgStride;
 
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1341,20 +1240,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, skipLinesB[typeIdx], -srcStride - 1, srcStride + 1, diff, count);
           }
         }
       }
@@ -1363,7 +1249,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[1];
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1373,51 +1258,22 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
+        m_calcEOStats(srcLine + firstLineStartX, srcStride, orgLine + firstLineStartX, orgStride, firstLineEndX - firstLineStartX, 1, -srcStride + 1, srcStride - 1, diff, count);
         srcLine += srcStride;
         orgLine += orgStride;
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
+        m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, endY - 1, -srcStride + 1, srcStride - 1, diff, count);
+        srcLine  += (endY - 1) * srcStride;
+        orgLine  += (endY - 1) * orgStride;
 
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1425,20 +1281,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_calcEOStats(srcLine + startX, srcStride, orgLine + startX, orgStride, endX - startX, skipLinesB[typeIdx], -srcStride + 1, srcStride - 1, diff, count);
           }
         }
       }
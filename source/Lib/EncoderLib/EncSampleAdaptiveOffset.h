@@ -101,6 +101,9 @@ public:
 
   void disabledRate( CodingStructure& cs, SAOBlkParam* reconParams, const double saoEncodingRate, const double saoEncodingRateChroma );
   void getPreDBFStatistics(CodingStructure& cs);
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  void setNumThreads( int numThreads ) { m_numThreads = numThreads; }
+#endif
 private: //methods
 
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const;
@@ -132,6 +135,9 @@ private: //members
   double                 m_saoDisabledRate[MAX_NUM_COMPONENT][MAX_TLAYER];
   int                    m_skipLinesR[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
   int                    m_skipLinesB[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
+#if ENABLE_LOOP_FILTER_PARALLELISM
+  int                    m_numThreads;
+#endif
 };
 
 
@@ -60,6 +60,9 @@ extern recursive_mutex g_cache_mutex;
 
 EncSlice::EncSlice()
  : m_encCABACTableIdx(I_SLICE)
+#if ENABLE_DQP_RD_PARALLELISM
+ , m_qpCandPic(nullptr)
+#endif
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -81,6 +84,17 @@ void EncSlice::destroy()
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
+#if ENABLE_DQP_RD_PARALLELISM
+
+  if( m_qpCandPic )
+  {
+    // the AQ layers belong to the copied picture
+    m_qpCandPic->aqlayer.clear();
+    m_qpCandPic->destroy();
+    delete m_qpCandPic;
+    m_qpCandPic = nullptr;
+  }
+#endif
 }
 
 void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
@@ -1134,6 +1148,63 @@ void EncSlice::precompressSlice( Picture* pcPic )
     dFrameLambda = 0.68 * pow (2, (m_viRdPicQp[0] - SHIFT_QP) / 3.0);
   }
 
+#if ENABLE_DQP_RD_PARALLELISM
+  const int numQpCands   = 2 * m_pcCfg->getDeltaQpRD() + 1;
+  const int numCandJobs  = std::min( m_pcCfg->getNumDeltaQpRDThreads(), numQpCands );
+
+  // the candidates are compressed concurrently on copies of the picture, each job with its own encoder stack, the k-th
+  // job compresses the candidates k, k + numCandJobs, ..., so the result does not depend on the thread scheduling
+  if( numCandJobs > 1 )
+  {
+    std::vector<double> picRdCost( numQpCands );
+
+    for( int cId = 1; cId < numCandJobs; cId++ )
+    {
+      m_pcLib->getQpCandEncoder( cId )->getSliceEncoder()->xInitQpCandPic( pcPic );
+    }
+
+#pragma omp parallel for schedule(static,1) num_threads(numCandJobs)
+    for( int cId = 0; cId < numCandJobs; cId++ )
+    {
+      EncSlice* sliceEncoder = m_pcLib->getQpCandEncoder( cId )->getSliceEncoder();
+      Picture*  candPic      = cId == 0 ? pcPic : sliceEncoder->m_qpCandPic;
+      Slice*    candSlice    = candPic->slices[getSliceSegmentIdx()];
+
+      sliceEncoder->setSliceSegmentIdx( getSliceSegmentIdx() );
+
+      for( int qpIdx = cId; qpIdx < numQpCands; qpIdx += numCandJobs )
+      {
+        candSlice   ->setSliceQp  ( m_viRdPicQp[qpIdx] );
+        sliceEncoder->setUpLambda ( candSlice, m_vdRdPicLambda[qpIdx], m_viRdPicQp[qpIdx] );
+        sliceEncoder->compressSlice( candPic, true, m_pcCfg->getFastDeltaQp() );
+
+        picRdCost[qpIdx] = double( sliceEncoder->m_uiPicDist ) + dFrameLambda * double( sliceEncoder->m_uiPicTotalBits );
+      }
+    }
+
+    for( int cId = 1; cId < numCandJobs; cId++ )
+    {
+      Picture* candPic = m_pcLib->getQpCandEncoder( cId )->getSliceEncoder()->m_qpCandPic;
+      candPic->destroyTempBuffers();
+      candPic->cs->destroyCoeffs();
+      candPic->cs->releaseIntermediateData();
+    }
+
+    for( int qpIdx = 0; qpIdx < numQpCands; qpIdx++ )
+    {
+      if( picRdCost[qpIdx] < dPicRdCostBest )
+      {
+        uiQpIdxBest    = qpIdx;
+        dPicRdCostBest = picRdCost[qpIdx];
+      }
+    }
+
+    pcSlice       ->setSliceQp             ( m_viRdPicQp    [uiQpIdxBest] );
+    setUpLambda(pcSlice, m_vdRdPicLambda[uiQpIdxBest], m_viRdPicQp    [uiQpIdxBest]);
+    return;
+  }
+
+#endif
   // for each QP candidate
   for ( uint32_t uiQpIdx = 0; uiQpIdx < 2 * m_pcCfg->getDeltaQpRD() + 1; uiQpIdx++ )
   {
@@ -1211,6 +1282,75 @@ void EncSlice::calCostSliceI(Picture* pcPic) // TODO: this only analyses the fir
 
 /** \param pcPic   picture class
  */
+#if ENABLE_DQP_RD_PARALLELISM
+/** prepares the picture copy of a DeltaQpRD candidate thread: it shares the original samples, the slice and the references
+    of the current picture, but has a coding structure and reconstruction of its own (and references itself with CPR)
+ */
+Picture* EncSlice::xInitQpCandPic( Picture* pcPic )
+{
+  const PreCalcValues& pcv = *pcPic->cs->pcv;
+
+  if( !m_qpCandPic )
+  {
+    m_qpCandPic = new Picture;
+    m_qpCandPic->create( pcPic->chromaFormat, pcPic->lumaSize(), pcv.maxCUWidth, pcPic->margin, false );
+  }
+
+  m_qpCandPic->getOrigBuf().copyFrom( pcPic->getOrigBuf() );
+  m_qpCandPic->finalInit( *pcPic->cs->sps, *pcPic->cs->pps );
+  m_qpCandPic->poc       = pcPic->poc;
+  m_qpCandPic->layer     = pcPic->layer;
+  m_qpCandPic->depth     = pcPic->depth;
+  m_qpCandPic->fieldPic  = pcPic->fieldPic;
+  m_qpCandPic->topField  = pcPic->topField;
+  m_qpCandPic->aqlayer   = pcPic->aqlayer;
+  m_qpCandPic->m_prevQP[0] = pcPic->m_prevQP[0];
+  m_qpCandPic->m_prevQP[1] = pcPic->m_prevQP[1];
+  m_qpCandPic->longTerm  = pcPic->longTerm;
+#if ENABLE_QPA
+  m_qpCandPic->m_uEnerHpCtu = pcPic->m_uEnerHpCtu;
+  m_qpCandPic->m_iOffsetCtu = pcPic->m_iOffsetCtu;
+#endif
+  m_qpCandPic->m_sao[0]  = pcPic->m_sao[0];
+  m_qpCandPic->m_sao[1]  = pcPic->m_sao[1];
+#if JVET_K0371_ALF
+  for( int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+  {
+    m_qpCandPic->m_alfCtuEnableFlag[compIdx] = pcPic->m_alfCtuEnableFlag[compIdx];
+  }
+#endif
+
+  for( auto slice : pcPic->slices )
+  {
+    m_qpCandPic->allocateNewSlice();
+    Slice* candSlice = m_qpCandPic->slices.back();
+    *candSlice = *slice;
+    candSlice->setPic( m_qpCandPic );
+#if JVET_K0076_CPR
+    // with current picture referencing the picture itself is in the reference list, it has to point to the copy
+    for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+    {
+      for( int refIdx = 0; refIdx < candSlice->getNumRefIdx( RefPicList( list ) ); refIdx++ )
+      {
+        if( candSlice->getRefPic( RefPicList( list ), refIdx ) == pcPic )
+        {
+          candSlice->setRefPic( m_qpCandPic, RefPicList( list ), refIdx );
+        }
+      }
+    }
+#endif
+  }
+  m_qpCandPic->cs->slice = m_qpCandPic->slices.back();
+#if ENABLE_SPLIT_PARALLELISM
+  m_qpCandPic->scheduler.init( pcv.heightInCtus, pcv.widthInCtus, 1, 0, 1 );
+#endif
+  m_qpCandPic->createTempBuffers( pcv.maxCUWidth );
+  m_qpCandPic->cs->createCoeffs();
+
+  return m_qpCandPic;
+}
+
+#endif
 void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP )
 {
   // if bCompressEntireSlice is true, then the entire slice (not slice segment) is compressed,
@@ -1835,10 +1975,10 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 #pragma omp critical
 #endif
     pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
+#if HEVC_DEPENDENT_SLICES
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
 #pragma omp critical
 #endif
-#if HEVC_DEPENDENT_SLICES
     pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + numberOfWrittenBits );
 #endif
 
@@ -1906,6 +2046,10 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 #endif
 
 #if !ENABLE_WPP_PARALLELISM
+    if ( pCfg->getRCPass() == 1 )
+    {
+      pCfg->getRCStats()->setLCU( ctuRsAddr, actualBits, int64_t( cs.dist - m_uiPicDist ) );
+    }
     m_uiPicTotalBits += actualBits;
     m_uiPicDist       = cs.dist;
 #endif
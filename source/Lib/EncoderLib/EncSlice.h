@@ -103,6 +103,9 @@ private:
 #if SHARP_LUMA_DELTA_QP
   int                     m_gopID;
 #endif
+#if ENABLE_DQP_RD_PARALLELISM
+  Picture*                m_qpCandPic;                          ///< copy of the current picture compressed by a DeltaQpRD candidate thread
+#endif
 
 #if SHARP_LUMA_DELTA_QP
 public:
@@ -160,13 +163,19 @@ public:
   void    xDetermineStartAndBoundingCtuTsAddr  ( uint32_t& startCtuTsAddr, uint32_t& boundingCtuTsAddr, Picture* pcPic );
   uint32_t    getSliceSegmentIdx  ()                    { return m_uiSliceSegmentIdx;       }
   void    setSliceSegmentIdx  (uint32_t i)              { m_uiSliceSegmentIdx = i;          }
+#if ENABLE_FRAME_PARALLELISM || ENABLE_DQP_RD_PARALLELISM
+  void    setGOPEncoder       (EncGOP* pcGOPEncoder)    { m_pcGOPEncoder = pcGOPEncoder;    }
+#endif
 
   SliceType getEncCABACTableIdx() const             { return m_encCABACTableIdx;        }
-#if JVET_K0076_CPR
+#if JVET_K0076_CPR || ENABLE_FRAME_PARALLELISM
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 #endif
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+#if ENABLE_DQP_RD_PARALLELISM
+  Picture* xInitQpCandPic     ( Picture* pcPic );
+#endif
 };
 
 //! \}
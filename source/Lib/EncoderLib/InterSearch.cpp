@@ -50,10 +50,14 @@
 #endif
 
 #include "EncModeCtrl.h"
+#include "EncAnalysis.h"
 #include "EncLib.h"
 
 #include <math.h>
 #include <limits>
+#if ENABLE_ME_PARALLELISM
+#include <omp.h>
+#endif
 
 
  //! \ingroup EncoderLib
@@ -102,6 +106,9 @@ InterSearch::InterSearch()
   , m_CtxCache                    (nullptr)
   , m_pTempPel                    (nullptr)
   , m_isInitialized               (false)
+#if ENABLE_ME_PARALLELISM
+  , m_isMEWorker                  (false)
+#endif
 {
   for (int i=0; i<MAX_NUM_REF_LIST_ADAPT_SR; i++)
   {
@@ -150,6 +157,16 @@ void InterSearch::destroy()
   }
 #if JEM_TOOLS
   m_obmcOrgMod.destroy();
+#endif
+#if ENABLE_ME_PARALLELISM
+  for( size_t i = 0; i < m_meWorkers.size(); i++ )
+  {
+    m_meWorkers[i]->destroy();
+    delete m_meWorkers[i];
+    delete m_meWorkerRdCost[i];
+  }
+  m_meWorkers.clear();
+  m_meWorkerRdCost.clear();
 #endif
   m_isInitialized = false;
 }
@@ -265,6 +282,28 @@ void InterSearch::init( EncCfg*        pcEncCfg,
 #endif
   m_pTempPel = new Pel[maxCUWidth*maxCUHeight];
 
+#if ENABLE_ME_PARALLELISM
+  // every worker gets its own cost calculator and prediction buffers, coding tools are only used by the master
+  // the configuration only allows more than one thread if there is a single encoder stack, so the workers exist once per encoder
+  const int numMEWorkers = m_isMEWorker ? 0 : pcEncCfg->getNumMEThreads();
+
+  for( int i = 0; i < ( numMEWorkers > 1 ? numMEWorkers : 0 ); i++ )
+  {
+    InterSearch* worker = new InterSearch;
+    RdCost*      rdCost = new RdCost;
+
+    worker->m_isMEWorker = true;
+    worker->init( pcEncCfg, pcTrQuant,
+#if JEM_TOOLS
+                  bilateralFilter,
+#endif
+                  iSearchRange, bipredSearchRange, motionEstimationSearchMethod, maxCUWidth, maxCUHeight, maxTotalCUDepth, rdCost, CABACEstimator, ctxCache );
+
+    m_meWorkers     .push_back( worker );
+    m_meWorkerRdCost.push_back( rdCost );
+  }
+
+#endif
   m_isInitialized = true;
 }
 
@@ -1833,6 +1872,10 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 #endif
 #if JVET_K0357_AMVR
     unsigned imvShift = pu.cu->imv << 1;
+#endif
+#if ENABLE_ME_PARALLELISM
+    // the searches are run concurrently up front, the loop below only collects their results in the serial order
+    const bool parallelME = xParallelUniME( pu, origBuf, iNumPredDir, uiMbBits );
 #endif
       //  Uni-directional prediction
       for ( int iRefList = 0; iRefList < iNumPredDir; iRefList++ )
@@ -1858,6 +1901,19 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
               uiBitsTemp--;
             }
           }
+#if ENABLE_ME_PARALLELISM
+          if( parallelME )
+          {
+            const UniMEResult& res = m_uniMEResults[iRefList][iRefIdxTemp];
+
+            cMvPred[iRefList][iRefIdxTemp] = res.mvPredAMVP;
+            amvp   [eRefPicList]           = res.amvpInfo;
+            pu.mvpIdx[eRefPicList]         = res.mvpIdxAMVP;
+            pu.mvpNum[eRefPicList]         = res.mvpNum;
+            biPDistTemp                    = res.biPDist;
+          }
+          else
+#endif
           xEstimateMvPredAMVP( pu, origBuf, eRefPicList, iRefIdxTemp, cMvPred[iRefList][iRefIdxTemp], amvp[eRefPicList], false, &biPDistTemp);
 
           aaiMvpIdx[iRefList][iRefIdxTemp] = pu.mvpIdx[eRefPicList];
@@ -1891,10 +1947,23 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
               uiCostTemp += m_pcRdCost->getCost( uiBitsTemp );
             }
             else
+#if ENABLE_ME_PARALLELISM
+            if( parallelME )
+            {
+              xApplyUniMEResult( m_uniMEResults[iRefList][iRefIdxTemp], cMvPred[iRefList][iRefIdxTemp], cMvTemp[iRefList][iRefIdxTemp], aaiMvpIdx[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp );
+            }
+            else
+#endif
             {
               xMotionEstimation( pu, origBuf, eRefPicList, cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp], aaiMvpIdx[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp, amvp[eRefPicList] );
             }
           }
+#if ENABLE_ME_PARALLELISM
+          else if( parallelME )
+          {
+            xApplyUniMEResult( m_uniMEResults[iRefList][iRefIdxTemp], cMvPred[iRefList][iRefIdxTemp], cMvTemp[iRefList][iRefIdxTemp], aaiMvpIdx[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp );
+          }
+#endif
           else
           {
             xMotionEstimation( pu, origBuf, eRefPicList, cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp], aaiMvpIdx[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp, amvp[eRefPicList] );
@@ -2348,32 +2417,37 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 #endif
     CHECK( !( !cu.cs->pcv->only2Nx2N || cu.partSize == SIZE_2Nx2N ), "Unexpected part size for QTBT." );
 #if JEM_TOOLS || JVET_K_AFFINE
+    // with the analysis of a reference encode, the affine models it did not choose are not searched
+    const EncModeCtrlMTnoRQT* refModeCtrl        = m_pcEncCfg->getAnalysisMode() == ANALYSIS_REUSE ? dynamic_cast<EncModeCtrlMTnoRQT*>( m_modeCtrl ) : NULL;
+    const CUAnalysis*         refCU              = refModeCtrl ? refModeCtrl->getRefCU( *cu.cs ) : NULL;
+    const bool                refSkipAffine      = refCU && !refCU->ibc && !refCU->affine;
+    const bool                refSkipAffine6Para = refCU && refCU->affine && refCU->affineType == AFFINEMODEL_4PARAM;
 #if JEM_TOOLS
 #if JVET_K0220_ENC_CTRL
 #if JVET_K0357_AMVR
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && cu.imv == 0)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && cu.imv == 0 && !refSkipAffine)
 #else
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && !refSkipAffine)
 #endif
 #else
 #if JVET_K0357_AMVR
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && cu.imv == 0 && !bFastSkipAffine)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && cu.imv == 0 && !bFastSkipAffine && !refSkipAffine)
 #else
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && !bFastSkipAffine)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !cu.LICFlag && !bFastSkipAffine && !refSkipAffine)
 #endif
 #endif
 #else
 #if JVET_K0220_ENC_CTRL
 #if JVET_K0357_AMVR
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0 && !refSkipAffine)
 #else
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine())
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !refSkipAffine)
 #endif
 #else
 #if JVET_K0357_AMVR
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0 && !bFastSkipAffine)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && cu.imv == 0 && !bFastSkipAffine && !refSkipAffine)
 #else
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !bFastSkipAffine)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.partSize == SIZE_2Nx2N && cu.slice->getSPS()->getSpsNext().getUseAffine() && !bFastSkipAffine && !refSkipAffine)
 #endif
 #endif
 #endif
@@ -2417,7 +2491,7 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
       xPredAffineInterSearch(pu, origBuf, puIdx, uiLastModeTemp, uiAffineCost, cMvHevcTemp, bFastSkipBi, acMvAffine4Para, refIdx4Para);
 #endif
 #endif
-      if ( cu.slice->getSPS()->getSpsNext().getUseAffineType() )
+      if ( cu.slice->getSPS()->getSpsNext().getUseAffineType() && !refSkipAffine6Para )
       {
         if ( uiAffineCost < uiHevcCost * 1.05 ) ///< condition for 6 parameter affine ME
         {
@@ -3003,6 +3077,126 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
 #endif
 }
 
+#if ENABLE_ME_PARALLELISM
+bool InterSearch::xParallelUniME( const PredictionUnit& pu, PelUnitBuf& origBuf, const int numPredDir, const uint32_t mbBits[3] )
+{
+  const Slice& slice = *pu.cs->slice;
+
+  int jobs[NUM_REF_PIC_LIST_01 * MAX_NUM_REF][2];
+  int numJobs = 0;
+
+  for( int refList = 0; refList < numPredDir; refList++ )
+  {
+    const RefPicList eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+    int refPicNumber = slice.getNumRefIdx( eRefPicList );
+#if JVET_K0076_CPR
+    if( slice.getSPS()->getSpsNext().getIBCMode() && eRefPicList == REF_PIC_LIST_0 )
+    {
+      refPicNumber--;
+    }
+#endif
+    for( int refIdx = 0; refIdx < refPicNumber; refIdx++ )
+    {
+      jobs[numJobs][0] = refList;
+      jobs[numJobs][1] = refIdx;
+      numJobs++;
+    }
+  }
+
+  if( m_meWorkers.empty() || numJobs < 2 || pu.lumaSize().area() < PARL_ME_MIN_PU_SIZE )
+  {
+    return false;
+  }
+
+  const int numThreads = std::min( ( int ) m_meWorkers.size(), numJobs );
+
+  for( int i = 0; i < numThreads; i++ )
+  {
+    InterSearch& worker = *m_meWorkers[i];
+
+    *worker.m_pcRdCost       = *m_pcRdCost;
+    worker.m_modeCtrl        = m_modeCtrl;
+    worker.m_maxCompIDToPred = m_maxCompIDToPred;
+    memcpy( worker.m_aaiAdaptSR,     m_aaiAdaptSR,     sizeof( m_aaiAdaptSR ) );
+    memcpy( worker.m_integerMv2Nx2N, m_integerMv2Nx2N, sizeof( m_integerMv2Nx2N ) );
+#if JVET_K0248_GBI
+    worker.m_cUniMotions     = m_cUniMotions;
+#endif
+  }
+
+  const bool fastMEForGenB = m_pcEncCfg->getFastMEForGenBLowDelayEnabled();
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads)
+  for( int jId = 0; jId < numJobs; jId++ )
+  {
+    InterSearch&     worker      = *m_meWorkers[omp_get_thread_num()];
+    const int        refList     = jobs[jId][0];
+    const int        refIdx      = jobs[jId][1];
+    const RefPicList eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+    UniMEResult&     res         = m_uniMEResults[refList][refIdx];
+    PredictionUnit   puJob       = pu;
+
+    res.biPDist = std::numeric_limits<Distortion>::max();
+    worker.xEstimateMvPredAMVP( puJob, origBuf, eRefPicList, refIdx, res.mvPredAMVP, res.amvpInfo, false, &res.biPDist );
+
+    res.mvpIdxAMVP = puJob.mvpIdx[eRefPicList];
+    res.mvpNum     = puJob.mvpNum[eRefPicList];
+
+    // list 1 searches copied from list 0 depend on the list 0 results and are done while collecting
+    res.searched   = !( fastMEForGenB && refList == 1 && slice.getList1IdxToList0Idx( refIdx ) >= 0 );
+
+    if( res.searched )
+    {
+      res.bits = mbBits[refList];
+      if( slice.getNumRefIdx( eRefPicList ) > 1 )
+      {
+        res.bits += refIdx + 1;
+        if( refIdx == slice.getNumRefIdx( eRefPicList ) - 1 )
+        {
+          res.bits--;
+        }
+      }
+      res.bits  += m_auiMVPIdxCost[res.mvpIdxAMVP][AMVP_MAX_NUM_CANDS];
+      res.mvPred = res.mvPredAMVP;
+      res.mvpIdx = res.mvpIdxAMVP;
+
+      worker.xMotionEstimation( puJob, origBuf, eRefPicList, res.mvPred, refIdx, res.mv, res.mvpIdx, res.bits, res.cost, res.amvpInfo );
+
+      res.rdCost         = *worker.m_pcRdCost;
+      res.distParam      = worker.m_cDistParam;
+      res.integerMv2Nx2N = worker.m_integerMv2Nx2N[eRefPicList][refIdx];
+    }
+  }
+
+  for( int jId = 0; jId < numJobs; jId++ )
+  {
+    const UniMEResult& res = m_uniMEResults[jobs[jId][0]][jobs[jId][1]];
+
+    if( res.searched )
+    {
+      m_integerMv2Nx2N[jobs[jId][0]][jobs[jId][1]] = res.integerMv2Nx2N;
+    }
+  }
+
+  return true;
+}
+
+void InterSearch::xApplyUniMEResult( const UniMEResult& res, Mv& rcMvPred, Mv& rcMv, int& riMVPIdx, uint32_t& ruiBits, Distortion& ruiCost )
+{
+  CHECK( !res.searched, "Motion search was not run in parallel" );
+
+  rcMvPred     = res.mvPred;
+  rcMv         = res.mv;
+  riMVPIdx     = res.mvpIdx;
+  ruiBits      = res.bits;
+  ruiCost      = res.cost;
+
+  // leave the cost calculator in the state of a serial search, the following checks rely on it
+  *m_pcRdCost  = res.rdCost;
+  m_cDistParam = res.distParam;
+}
+#endif
+
 
 
 void InterSearch::xSetSearchRange ( const PredictionUnit& pu,
@@ -157,6 +157,34 @@ protected:
   unsigned int    m_uiNumBVs, m_uiNumBV16s;
   Mv              m_acBVs[IBC_NUM_CANDIDATES];
 #endif
+#if ENABLE_ME_PARALLELISM
+
+  // parallel uni-directional motion estimation
+  struct UniMEResult
+  {
+    AMVPInfo      amvpInfo;
+    Mv            mvPredAMVP;   ///< predictor chosen by the AMVP estimation
+    int           mvpIdxAMVP;
+    int           mvpNum;
+    Distortion    biPDist;
+    bool          searched;     ///< false if the search is derived from list 0 (fast ME for generalized B)
+    Mv            mvPred;       ///< predictor after the motion search
+    int           mvpIdx;
+    Mv            mv;
+    uint32_t      bits;
+    Distortion    cost;
+    RdCost        rdCost;       ///< state of the cost calculator after the search, as left by a serial search
+    DistParam     distParam;
+    Mv            integerMv2Nx2N;
+  };
+
+  std::vector<InterSearch*>
+                  m_meWorkers;
+  std::vector<RdCost*>
+                  m_meWorkerRdCost;
+  bool            m_isMEWorker;
+  UniMEResult     m_uniMEResults                [NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+#endif
 public:
   InterSearch();
   virtual ~InterSearch();
@@ -189,6 +217,10 @@ public:
 #endif
 
 protected:
+#if ENABLE_ME_PARALLELISM
+  bool xParallelUniME               ( const PredictionUnit& pu, PelUnitBuf& origBuf, const int numPredDir, const uint32_t mbBits[3] );
+  void xApplyUniMEResult            ( const UniMEResult& res, Mv& rcMvPred, Mv& rcMv, int& riMVPIdx, uint32_t& ruiBits, Distortion& ruiCost );
+#endif
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
   Distortion  xPatternRefinement    ( const CPelBuf* pcPatternKey, Mv baseRefMv, int iFrac, Mv& rcMvFrac, bool bAllowUseOfHadamard );
@@ -471,7 +503,7 @@ public:
   );
   void xEncodeInterResidualQT     (CodingStructure &cs, Partitioner &partitioner, const ComponentID &compID);
   void xEstimateInterResidualQT   (CodingStructure &cs, Partitioner &partitioner, Distortion *puiZeroDist = NULL
-#if JVET_ K0076_CPR_DT
+#if JVET_K0076_CPR_DT
     , const bool luma = true, const bool chroma = true
 #endif
   );
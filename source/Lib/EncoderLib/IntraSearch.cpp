@@ -38,6 +38,7 @@
 #include "IntraSearch.h"
 
 #include "EncModeCtrl.h"
+#include "EncAnalysis.h"
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Rom.h"
@@ -57,12 +58,8 @@
  //! \{
 
 IntraSearch::IntraSearch()
-#if JVET_K0220_ENC_CTRL
-  : m_pSplitCS      (nullptr)
-#else
   : m_modeCtrl      (nullptr)
   , m_pSplitCS      (nullptr)
-#endif
   , m_pFullCS       (nullptr)
   , m_pBestCS       (nullptr)
   , m_pcEncCfg      (nullptr)
@@ -724,6 +721,29 @@ void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
           uiRdModeList.push_back( i );
         }
       }
+
+      // with the analysis of a reference encode, only its mode and the best SATD candidate are checked with RD
+      const EncModeCtrlMTnoRQT* refModeCtrl = m_pcEncCfg->getAnalysisMode() == ANALYSIS_REUSE ? dynamic_cast<EncModeCtrlMTnoRQT*>( m_modeCtrl ) : NULL;
+      const CUAnalysis*         refCU       = refModeCtrl ? refModeCtrl->getRefCU( cs ) : NULL;
+
+      if( refCU && refCU->predMode == MODE_INTRA && !refCU->ibc && refCU->intraDir < numModesAvailable
+#if JEM_TOOLS
+          && !( cu.partSize == SIZE_2Nx2N && cu.nsstIdx >= ( refCU->intraDir <= DC_IDX ? 3 : 4 ) )
+#endif
+        )
+      {
+        const uint32_t refMode      = refCU->intraDir;
+        const uint32_t bestSatdMode = uiRdModeList.empty() ? refMode : uiRdModeList[0];
+
+        uiRdModeList.clear();
+        uiRdModeList.push_back( refMode );
+        if( bestSatdMode != refMode )
+        {
+          uiRdModeList.push_back( bestSatdMode );
+        }
+        numModesForFullRD = int( uiRdModeList.size() );
+      }
+
 #if JEM_TOOLS || JVET_K1000_SIMPLIFIED_EMT
       if( emtUsageFlag == 1 )
       {
@@ -38,6 +38,8 @@
 #include "../CommonLib/ChromaFormat.h"
 
 #include <cmath>
+#include <fstream>
+#include <sstream>
 
 #if JVET_K0390_RATECTRL
 #define LAMBDA_PREC                                           1000000
@@ -45,6 +47,100 @@
 
 using namespace std;
 
+//first pass statistics
+void EncRCStats::initPicture( int numberOfLCU )
+{
+  m_currPic.m_LCUBits.assign( numberOfLCU, 0 );
+  m_currPic.m_LCUDist.assign( numberOfLCU, 0 );
+}
+
+void EncRCStats::setLCU( int LCUIdx, int bits, int64_t dist )
+{
+  CHECK( LCUIdx >= (int)m_currPic.m_LCUBits.size(), "LCU id exceeds number of LCU" );
+  m_currPic.m_LCUBits[LCUIdx] = bits;
+  m_currPic.m_LCUDist[LCUIdx] = dist;
+}
+
+void EncRCStats::addPicture( int POC, int QP, int headerBits, int totalBits )
+{
+  m_currPic.m_POC        = POC;
+  m_currPic.m_QP         = QP;
+  m_currPic.m_headerBits = headerBits;
+  m_currPic.m_totalBits  = totalBits;
+  m_pictures.push_back( m_currPic );
+}
+
+int64_t EncRCStats::getBits( int firstPic, int numPic ) const
+{
+  int64_t bits = 0;
+  for ( int i = max( firstPic, 0 ); i < min( firstPic + numPic, getNumPictures() ); i++ )
+  {
+    bits += max( 1, m_pictures[i].m_totalBits );
+  }
+  return bits;
+}
+
+// one line per picture in coding order: POC QP headerBits totalBits numberOfLCU, followed by the bits and the distortion of each CTU
+void EncRCStats::write( const std::string& fileName ) const
+{
+  ofstream file( fileName.c_str() );
+  if ( !file )
+  {
+    EXIT( "Failed to open rate control statistics file " << fileName << " for writing" );
+  }
+
+  file << "# POC QP headerBits totalBits numberOfLCU { LCUBits LCUDist }\n";
+  for ( const TRCPicStats& pic : m_pictures )
+  {
+    file << pic.m_POC << " " << pic.m_QP << " " << pic.m_headerBits << " " << pic.m_totalBits << " " << pic.m_LCUBits.size();
+    for ( size_t i = 0; i < pic.m_LCUBits.size(); i++ )
+    {
+      file << " " << pic.m_LCUBits[i] << " " << pic.m_LCUDist[i];
+    }
+    file << "\n";
+  }
+}
+
+void EncRCStats::read( const std::string& fileName )
+{
+  ifstream file( fileName.c_str() );
+  if ( !file )
+  {
+    EXIT( "Failed to open rate control statistics file " << fileName << " for reading" );
+  }
+
+  m_pictures.clear();
+  string line;
+  while ( getline( file, line ) )
+  {
+    if ( line.empty() || line[0] == '#' )
+    {
+      continue;
+    }
+
+    istringstream picLine( line );
+    TRCPicStats   pic;
+    int           numberOfLCU = 0;
+    picLine >> pic.m_POC >> pic.m_QP >> pic.m_headerBits >> pic.m_totalBits >> numberOfLCU;
+    if ( !picLine || numberOfLCU <= 0 || pic.m_totalBits < 0 )
+    {
+      EXIT( "Invalid picture entry in rate control statistics file " << fileName );
+    }
+
+    pic.m_LCUBits.resize( numberOfLCU );
+    pic.m_LCUDist.resize( numberOfLCU );
+    for ( int i = 0; i < numberOfLCU; i++ )
+    {
+      picLine >> pic.m_LCUBits[i] >> pic.m_LCUDist[i];
+    }
+    if ( !picLine )
+    {
+      EXIT( "Truncated picture entry in rate control statistics file " << fileName );
+    }
+    m_pictures.push_back( pic );
+  }
+}
+
 //sequence level
 EncRCSeq::EncRCSeq()
 {
@@ -73,6 +169,7 @@ EncRCSeq::EncRCSeq()
 #if RATECTRL_FIX_FULLNBIT
   m_bitDepth          = 0;
 #endif
+  m_firstPassStats      = NULL;
 }
 
 EncRCSeq::~EncRCSeq()
@@ -342,6 +439,7 @@ EncRCGOP::EncRCGOP()
   m_targetBits = 0;
   m_picLeft    = 0;
   m_bitsLeft   = 0;
+  m_firstPicIdx = 0;
 }
 
 EncRCGOP::~EncRCGOP()
@@ -352,9 +450,12 @@ EncRCGOP::~EncRCGOP()
 void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
 {
   destroy();
+  m_encRCSeq    = encRCSeq;
+  m_firstPicIdx = encRCSeq->getFramesCoded();
   int targetBits = xEstGOPTargetBits( encRCSeq, numPic );
 
-  if ( encRCSeq->getAdaptiveBits() > 0 && encRCSeq->getLastLambda() > 0.1 )
+  // with first-pass statistics the pictures are weighted with their first-pass bits instead of the model ratios
+  if ( encRCSeq->getAdaptiveBits() > 0 && encRCSeq->getLastLambda() > 0.1 && !encRCSeq->getFirstPassStats() )
   {
     double targetBpp = (double)targetBits / encRCSeq->getNumPixel();
     double basicLambda = 0.0;
@@ -482,19 +583,18 @@ void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
 
   m_picTargetBitInGOP = new int[numPic];
   int i;
-  int totalPicRatio = 0;
-  int currPicRatio = 0;
+  double totalPicRatio = 0;
+  double currPicRatio = 0;
   for ( i=0; i<numPic; i++ )
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    totalPicRatio += getPicRatio( i );
   }
   for ( i=0; i<numPic; i++ )
   {
-    currPicRatio = encRCSeq->getBitRatio( i );
+    currPicRatio = getPicRatio( i );
     m_picTargetBitInGOP[i] = (int)( ((double)targetBits) * currPicRatio / totalPicRatio );
   }
 
-  m_encRCSeq    = encRCSeq;
   m_numPic       = numPic;
   m_targetBits   = targetBits;
   m_picLeft      = m_numPic;
@@ -573,12 +673,37 @@ void EncRCGOP::updateAfterPicture( int bitsCost )
   m_picLeft--;
 }
 
+double EncRCGOP::getPicRatio( int i )
+{
+  const EncRCStats* stats = m_encRCSeq->getFirstPassStats();
+  if ( stats )
+  {
+    return (double)max( 1, stats->getPicture( m_firstPicIdx + i ).m_totalBits );
+  }
+  return m_encRCSeq->getBitRatio( i );
+}
+
 int EncRCGOP::xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize )
 {
   int realInfluencePicture = min( g_RCSmoothWindowSize, encRCSeq->getFramesLeft() );
-  int averageTargetBitsPerPic = (int)( encRCSeq->getTargetBits() / encRCSeq->getTotalFrames() );
-  int currentTargetBitsPerPic = (int)( ( encRCSeq->getBitsLeft() - averageTargetBitsPerPic * (encRCSeq->getFramesLeft() - realInfluencePicture) ) / realInfluencePicture );
-  int targetBits = currentTargetBitsPerPic * GOPSize;
+  int targetBits;
+  const EncRCStats* stats = encRCSeq->getFirstPassStats();
+  if ( stats )
+  {
+    // share of the GOP in the first-pass bits, corrected by the deviation of the bits spent so far,
+    // which is spread over the pictures of the smoothing window
+    double bitsPerStatsBit = (double)encRCSeq->getTargetBits() / (double)stats->getBits( 0, encRCSeq->getTotalFrames() );
+    double remainingBits   = bitsPerStatsBit * stats->getBits( m_firstPicIdx, encRCSeq->getFramesLeft() );
+    double windowBits      = bitsPerStatsBit * stats->getBits( m_firstPicIdx, realInfluencePicture );
+    double GOPBits         = bitsPerStatsBit * stats->getBits( m_firstPicIdx, GOPSize );
+    targetBits = (int)( GOPBits + ( encRCSeq->getBitsLeft() - remainingBits ) * GOPBits / windowBits );
+  }
+  else
+  {
+    int averageTargetBitsPerPic = (int)( encRCSeq->getTargetBits() / encRCSeq->getTotalFrames() );
+    int currentTargetBitsPerPic = (int)( ( encRCSeq->getBitsLeft() - averageTargetBitsPerPic * (encRCSeq->getFramesLeft() - realInfluencePicture) ) / realInfluencePicture );
+    targetBits = currentTargetBitsPerPic * GOPSize;
+  }
 
   if ( targetBits < 200 )
   {
@@ -594,6 +719,7 @@ EncRCPic::EncRCPic()
   m_encRCSeq = NULL;
   m_encRCGOP = NULL;
 
+  m_codingIdx     = 0;
   m_frameLevel    = 0;
   m_numberOfPixel = 0;
   m_numberOfLCU   = 0;
@@ -629,11 +755,11 @@ int EncRCPic::xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP )
 
   int i;
   int currPicPosition = encRCGOP->getNumPic()-encRCGOP->getPicLeft();
-  int currPicRatio    = encRCSeq->getBitRatio( currPicPosition );
-  int totalPicRatio   = 0;
+  double currPicRatio = encRCGOP->getPicRatio( currPicPosition );
+  double totalPicRatio = 0;
   for ( i=currPicPosition; i<encRCGOP->getNumPic(); i++ )
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    totalPicRatio += encRCGOP->getPicRatio( i );
   }
 
   targetBits  = int( ((double)GOPbitsLeft) * currPicRatio / totalPicRatio );
@@ -682,12 +808,12 @@ int EncRCPic::xEstPicLowerBound(EncRCSeq* encRCSeq, EncRCGOP* encRCGOP)
   int GOPbitsLeft = encRCGOP->getBitsLeft();
 
   const int nextPicPosition = (encRCGOP->getNumPic() - encRCGOP->getPicLeft() + 1) % encRCGOP->getNumPic();
-  const int nextPicRatio = encRCSeq->getBitRatio(nextPicPosition);
+  const double nextPicRatio = encRCGOP->getPicRatio(nextPicPosition);
 
-  int totalPicRatio = 0;
+  double totalPicRatio = 0;
   for (int i = nextPicPosition; i < encRCGOP->getNumPic(); i++)
   {
-    totalPicRatio += encRCSeq->getBitRatio(i);
+    totalPicRatio += encRCGOP->getPicRatio(i);
   }
 
   if (nextPicPosition == 0)
@@ -733,6 +859,7 @@ void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, l
   destroy();
   m_encRCSeq = encRCSeq;
   m_encRCGOP = encRCGOP;
+  m_codingIdx = encRCSeq->getFramesCoded();
 
   int targetBits    = xEstPicTargetBits( encRCSeq, encRCGOP );
   int estHeaderBits = xEstPicHeaderBits( listPreviousPictures, frameLevel );
@@ -885,23 +1012,32 @@ double EncRCPic::estimatePicLambda( list<EncRCPic*>& listPreviousPictures, bool
 #endif
   m_estPicLambda = estLambda;
 
+  const EncRCStats* stats = m_encRCSeq->getFirstPassStats();
   double totalWeight = 0.0;
   // initial BU bit allocation weight
   for ( int i=0; i<m_numberOfLCU; i++ )
   {
-    double alphaLCU, betaLCU;
-    if ( m_encRCSeq->getUseLCUSeparateModel() )
+    if ( stats )
     {
-      alphaLCU = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_alpha;
-      betaLCU  = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_beta;
+      // the CTU bits of the first pass
+      m_LCUs[i].m_bitWeight = stats->getPicture( m_codingIdx ).m_LCUBits[i];
     }
     else
     {
-      alphaLCU = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
-      betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
-    }
+      double alphaLCU, betaLCU;
+      if ( m_encRCSeq->getUseLCUSeparateModel() )
+      {
+        alphaLCU = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_alpha;
+        betaLCU  = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_beta;
+      }
+      else
+      {
+        alphaLCU = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
+        betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
+      }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+      m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    }
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -979,7 +1115,8 @@ double EncRCPic::getLCUTargetBpp(bool isIRAP)
   double bpp      = -1.0;
   int avgBits     = 0;
 
-  if (isIRAP)
+  // with first-pass statistics the intra CTUs are also allocated with their first-pass bits
+  if (isIRAP && !m_encRCSeq->getFirstPassStats())
   {
     int noOfLCUsLeft = m_numberOfLCU - LCUIdx + 1;
     int bitrateWindow = min(4,noOfLCUsLeft);
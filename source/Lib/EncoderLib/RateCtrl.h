@@ -55,6 +55,7 @@ using namespace std;
 
 #include "../EncoderLib/EncCfg.h"
 #include <list>
+#include <string>
 
 const int g_RCInvalidQPValue = -999;
 const int g_RCSmoothWindowSize = 40;
@@ -99,6 +100,36 @@ struct TRCParameter
 #endif
 };
 
+struct TRCPicStats
+{
+  int m_POC;
+  int m_QP;
+  int m_headerBits;
+  int m_totalBits;
+  vector<int>     m_LCUBits;  // estimated bits of each CTU
+  vector<int64_t> m_LCUDist;  // distortion of each CTU, the complexity at the first-pass QP
+};
+
+/// statistics of a first rate control pass, in coding order, used for the bit allocation of the second pass
+class EncRCStats
+{
+public:
+  void initPicture( int numberOfLCU );
+  void setLCU     ( int LCUIdx, int bits, int64_t dist );
+  void addPicture ( int POC, int QP, int headerBits, int totalBits );
+
+  void write( const std::string& fileName ) const;
+  void read ( const std::string& fileName );
+
+  int                getNumPictures()                const { return (int)m_pictures.size(); }
+  const TRCPicStats& getPicture( int codingIdx )     const { CHECK( codingIdx < 0 || codingIdx >= getNumPictures(), "No statistics of the picture" ); return m_pictures[codingIdx]; }
+  int64_t            getBits( int firstPic, int numPic ) const;
+
+private:
+  TRCPicStats         m_currPic;
+  vector<TRCPicStats> m_pictures;
+};
+
 class EncRCSeq
 {
 public:
@@ -154,6 +185,10 @@ public:
   int    getAdaptiveBits()              { return m_adaptiveBit;  }
   double getLastLambda()                { return m_lastLambda;   }
   void   setLastLambda( double lamdba ) { m_lastLambda = lamdba; }
+
+  const EncRCStats* getFirstPassStats()                            { return m_firstPassStats; }
+  void              setFirstPassStats( const EncRCStats* stats )   { m_firstPassStats = stats; }
+  int               getFramesCoded()                               { return m_totalFrames - m_framesLeft; }
 #if RATECTRL_FIX_FULLNBIT
   void setBitDepth(int bitDepth) { m_bitDepth = bitDepth; }
   int getbitDepth() { return m_bitDepth; }
@@ -191,6 +226,7 @@ private:
 #if RATECTRL_FIX_FULLNBIT
   int m_bitDepth;
 #endif
+  const EncRCStats* m_firstPassStats;
 };
 
 class EncRCGOP
@@ -220,10 +256,12 @@ public:
   int  getPicLeft()               { return m_picLeft; }
   int  getBitsLeft()              { return m_bitsLeft; }
   int  getTargetBitInGOP( int i ) { return m_picTargetBitInGOP[i]; }
+  double getPicRatio( int i );
 
 private:
   EncRCSeq* m_encRCSeq;
   int* m_picTargetBitInGOP;
+  int m_firstPicIdx;
   int m_numPic;
   int m_targetBits;
   int m_picLeft;
@@ -286,6 +324,7 @@ public:
   TRCLCU* getLCU()                                        { return m_LCUs; }
   TRCLCU& getLCU( int LCUIdx )                            { return m_LCUs[LCUIdx]; }
   int  getPicActualHeaderBits()                           { return m_picActualHeaderBits; }
+  int  getCodingIdx()                                     { return m_codingIdx; }
 #if U0132_TARGET_BITS_SATURATION
   void setBitLeft(int bits)                               { m_bitsLeft = bits; }
 #endif
@@ -309,6 +348,7 @@ private:
   EncRCSeq* m_encRCSeq;
   EncRCGOP* m_encRCGOP;
 
+  int m_codingIdx;
   int m_frameLevel;
   int m_numberOfPixel;
   int m_numberOfLCU;
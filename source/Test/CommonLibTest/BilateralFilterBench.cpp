@@ -0,0 +1,219 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     BilateralFilterBench.cpp
+    \brief    checks the SIMD bilateral filter against the C++ version on random blocks and measures both
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/BilateralFilter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if JEM_TOOLS
+/// bilateral filter running the C++ kernel
+class BilateralFilterScalar : public BilateralFilter
+{
+public:
+  BilateralFilterScalar() { m_smoothBlock = smoothBlockBilateralFilterCore; }
+};
+
+static void fillRandom( std::vector<Pel>& block, std::mt19937& rng, const int bitDepth )
+{
+  const int maxVal    = ( 1 << bitDepth ) - 1;
+  const int amplitude = rng() % 4 == 0 ? maxVal + 1 : 1 + rng() % ( rng() % 2 ? 8 : 64 );
+  const int base      = rng() % ( maxVal + 1 );
+
+  for( Pel& sample : block )
+  {
+    sample = Pel( std::min( maxVal, std::max( 0, base + int( rng() % amplitude ) - amplitude / 2 ) ) );
+  }
+}
+
+static int checkBitExact( BilateralFilter& simdFilter, BilateralFilter& scalarFilter, std::mt19937& rng )
+{
+  int numMismatches = 0;
+
+  std::vector<Pel> pred( MAX_CU_SIZE * MAX_CU_SIZE ), blockSimd( MAX_CU_SIZE * MAX_CU_SIZE ), blockScalar( MAX_CU_SIZE * MAX_CU_SIZE );
+
+  for( int bitDepth = 8; bitDepth <= 10; bitDepth += 2 )
+  {
+    const ClpRng clpRng = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+
+    for( unsigned width = 4; width <= MAX_CU_SIZE; width <<= 1 )
+    {
+      for( unsigned height = 4; height <= MAX_CU_SIZE; height <<= 1 )
+      {
+        for( int qp = 18; qp <= MAX_QP; qp++ )
+        {
+          const int numSamples = width * height;
+
+          // intra, the reconstruction is filtered in place
+          fillRandom( blockSimd, rng, bitDepth );
+          std::copy( blockSimd.begin(), blockSimd.begin() + numSamples, blockScalar.begin() );
+
+          PelBuf recoSimd  ( blockSimd  .data(), width, height );
+          PelBuf recoScalar( blockScalar.data(), width, height );
+          simdFilter  .bilateralFilterIntra( recoSimd,   qp );
+          scalarFilter.bilateralFilterIntra( recoScalar, qp );
+
+          if( !std::equal( blockSimd.begin(), blockSimd.begin() + numSamples, blockScalar.begin() ) )
+          {
+            printf( "intra %3dx%-3d qp %d bit depth %d: mismatch\n", width, height, qp, bitDepth );
+            numMismatches++;
+          }
+
+          // inter, the residual is replaced by the filtered reconstruction minus the prediction, only for the block sizes
+          // that have an inter center weight
+          if( std::min( width, height ) >= 16 )
+          {
+            continue;
+          }
+
+          fillRandom( pred, rng, bitDepth );
+          fillRandom( blockSimd, rng, bitDepth );
+          for( int i = 0; i < numSamples; i++ )
+          {
+            blockSimd[i] -= pred[i];
+          }
+          std::copy( blockSimd.begin(), blockSimd.begin() + numSamples, blockScalar.begin() );
+
+          const CPelBuf predBuf   ( pred       .data(), width, height );
+          PelBuf        resiSimd  ( blockSimd  .data(), width, height );
+          PelBuf        resiScalar( blockScalar.data(), width, height );
+          simdFilter  .bilateralFilterInter( resiSimd,   predBuf, qp, clpRng );
+          scalarFilter.bilateralFilterInter( resiScalar, predBuf, qp, clpRng );
+
+          if( !std::equal( blockSimd.begin(), blockSimd.begin() + numSamples, blockScalar.begin() ) )
+          {
+            printf( "inter %3dx%-3d qp %d bit depth %d: mismatch\n", width, height, qp, bitDepth );
+            numMismatches++;
+          }
+        }
+      }
+    }
+  }
+
+  return numMismatches;
+}
+
+static double measure( BilateralFilter& filter, std::vector<Pel>& block, const unsigned size, const int qp )
+{
+  static const int NUM_BENCH_SAMPLES = 1 << 22;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for( int i = 0; i < NUM_BENCH_SAMPLES; i += size * size )
+  {
+    PelBuf reco( block.data(), size, size );
+    filter.bilateralFilterIntra( reco, qp );
+  }
+
+  return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if JEM_TOOLS
+  // optional arguments: --check, which skips the measurements, and the SIMD extension to use (SSE41, AVX2, ...), default:
+  // the highest supported extension
+  bool        checkOnly = false;
+  std::string extension;
+  for( int i = 1; i < argc; i++ )
+  {
+    if( std::string( argv[i] ) == "--check" )
+    {
+      checkOnly = true;
+    }
+    else
+    {
+      extension = argv[i];
+    }
+  }
+
+#if ENABLE_SIMD_OPT_BIF && defined( TARGET_SIMD_X86 )
+  printf( "SIMD extension %s\n", read_x86_extension( extension ) );
+
+#endif
+  BilateralFilter       simdFilter;
+  BilateralFilterScalar scalarFilter;
+  simdFilter  .create();
+  scalarFilter.create();
+
+  std::mt19937 rng( 42 );
+
+  const int numMismatches = checkBitExact( simdFilter, scalarFilter, rng );
+
+  printf( "%d blocks differ from the C++ filter\n", numMismatches );
+
+  if( !checkOnly )
+  {
+    // filter the same samples repeatedly, as in the encoder most of them are smooth
+    printf( "\n block   C++ [ms]   SIMD [ms]   speed-up\n" );
+
+    for( unsigned size = 4; size <= MAX_CU_SIZE; size <<= 1 )
+    {
+      std::vector<Pel> blockSimd( size * size ), blockScalar( size * size );
+
+      for( size_t i = 0; i < blockSimd.size(); i++ )
+      {
+        blockSimd[i] = blockScalar[i] = Pel( 512 + rng() % 40 );
+      }
+
+      const double timeScalar = measure( scalarFilter, blockScalar, size, 32 );
+      const double timeSimd   = measure( simdFilter,   blockSimd,   size, 32 );
+
+      printf( "%3dx%-3d %10.1f  %10.1f  %8.2fx\n", size, size, timeScalar, timeSimd, timeScalar / timeSimd );
+    }
+  }
+
+  simdFilter  .destroy();
+  scalarFilter.destroy();
+
+  return numMismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "The bilateral filter is disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}
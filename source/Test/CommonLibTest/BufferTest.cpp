@@ -0,0 +1,285 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     BufferTest.cpp
+    \brief    compares the SIMD weighted averaging kernels with the C++ code on random input
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+#include "CommonLib/InterpolationFilter.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+static const int NUM_RUNS = 4000;
+
+static int randomRange( std::mt19937& rng, const int minVal, const int maxVal )
+{
+  return minVal + int( rng() % ( maxVal - minVal + 1 ) );
+}
+
+/// fills the prediction with values of the intermediate precision around a random level, including the overshoot of the
+/// interpolation filters
+static void fillRandom( std::vector<Pel>& buf, std::mt19937& rng )
+{
+  const int maxAbs    = 14400;
+  const int amplitude = rng() % 3 == 0 ? maxAbs : 1 + rng() % 2000;
+  const int level     = int( rng() % 16384 ) - 8192;
+
+  for( Pel& val : buf )
+  {
+    val = Pel( Clip3( -maxAbs, maxAbs, level + int( rng() % ( 2 * amplitude + 1 ) ) - amplitude ) );
+  }
+}
+
+// the weighted prediction of a sample as in WeightPrediction.cpp
+static inline Pel weightBidir( int w0, Pel P0, int w1, Pel P1, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  return ClipPel( ( ( w0 * ( P0 + IF_INTERNAL_OFFS ) + w1 * ( P1 + IF_INTERNAL_OFFS ) + round + ( offset << ( shift - 1 ) ) ) >> shift ), clpRng );
+}
+
+static inline Pel weightUnidir( int w0, Pel P0, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  return ClipPel( ( ( w0 * ( P0 + IF_INTERNAL_OFFS ) + round ) >> shift ) + offset, clpRng );
+}
+
+/// a block of random size, the width is a multiple of four as required by the kernels
+struct TestBlock
+{
+  int              width;
+  int              height;
+  int              srcStride;
+  int              dstStride;
+  ClpRng           clpRng;
+  std::vector<Pel> src[2];
+  std::vector<Pel> dst;
+  std::vector<Pel> simdDst;
+
+  TestBlock( std::mt19937& rng )
+  {
+    width     = 4 * randomRange( rng, 1, MAX_CU_SIZE / 8 );
+    height    = randomRange( rng, 1, MAX_CU_SIZE / 4 );
+    srcStride = width + randomRange( rng, 0, 7 );
+    dstStride = width + randomRange( rng, 0, 7 );
+
+    const int bitDepth = 8 + 2 * int( rng() % 3 );
+    clpRng.min = 0;
+    clpRng.max = ( 1 << bitDepth ) - 1;
+    clpRng.bd  = bitDepth;
+
+    for( int i = 0; i < 2; i++ )
+    {
+      src[i].resize( srcStride * height );
+      fillRandom( src[i], rng );
+    }
+    dst    .assign( dstStride * height, 0x5a5a );
+    simdDst.assign( dstStride * height, 0x5a5a );
+  }
+};
+
+#if JVET_K0248_GBI
+/// GBi averaging with the parameters of AreaBuf::addWeightedAvg, checked against the C++ kernel
+static bool testGbi( PelBufferOps& scalarOps, PelBufferOps& simdOps, std::mt19937& rng )
+{
+  TestBlock b( rng );
+  bool      ok = true;
+
+  for( int gbiIdx = 0; gbiIdx < GBI_NUM; gbiIdx++ )
+  {
+    const int w0       = getGbiWeight( gbiIdx, REF_PIC_LIST_0 );
+    const int w1       = getGbiWeight( gbiIdx, REF_PIC_LIST_1 );
+    const int shiftNum = std::max<int>( 2, IF_INTERNAL_PREC - b.clpRng.bd ) + g_GbiLog2WeightBase;
+    const int offset   = ( 1 << ( shiftNum - 1 ) ) + ( IF_INTERNAL_OFFS << g_GbiLog2WeightBase );
+
+    scalarOps.addAvg4GBI( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.dst.data(), b.dstStride, b.width, b.height, shiftNum, offset, b.clpRng, gbiIdx );
+
+    if( ( b.width & 7 ) == 0 )
+    {
+      simdOps.wghtAvg8( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, w0, w1, shiftNum, offset, b.clpRng );
+    }
+    else
+    {
+      simdOps.wghtAvg4( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, w0, w1, shiftNum, offset, b.clpRng );
+    }
+
+    if( b.dst != b.simdDst )
+    {
+      printf( "GBi averaging: mismatch for %dx%d, bit depth %d, GBi index %d\n", b.width, b.height, b.clpRng.bd, gbiIdx );
+      ok = false;
+    }
+
+    // the 4x4 averaging of the BIO sub-blocks
+    std::fill( b.simdDst.begin(), b.simdDst.end(), 0x5a5a );
+    simdOps.addAvg4GBI( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, shiftNum, offset, b.clpRng, gbiIdx );
+
+    if( b.dst != b.simdDst )
+    {
+      printf( "GBi averaging of 4x4 blocks: mismatch for %dx%d, bit depth %d, GBi index %d\n", b.width, b.height, b.clpRng.bd, gbiIdx );
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+#endif
+
+/// bi-directional weighted prediction with the parameters of WeightPrediction::addWeightBi
+static bool testWeightBi( PelBufferOps& simdOps, std::mt19937& rng )
+{
+  TestBlock b( rng );
+
+  // the weights are the coded deltas plus the identity weight of the denominator, the offsets are scaled to the bit depth
+  const int  log2Denom = randomRange( rng, 0, 7 );
+  const int  w0        = ( 1 << log2Denom ) + randomRange( rng, -128, 127 );
+  const int  w1        = ( 1 << log2Denom ) + randomRange( rng, -128, 127 );
+  const int  offset    = ( randomRange( rng, -128, 127 ) + randomRange( rng, -128, 127 ) ) << ( b.clpRng.bd - 8 );
+  const bool rounding  = rng() % 2 == 0;
+
+  const int shiftNum = std::max<int>( 2, IF_INTERNAL_PREC - b.clpRng.bd );
+  const int shift    = log2Denom + 1 + shiftNum;
+  const int round    = rounding ? 1 << ( shift - 1 ) : 0;
+  const int add      = w0 * IF_INTERNAL_OFFS + w1 * IF_INTERNAL_OFFS + round + ( offset << ( shift - 1 ) );
+
+  for( int y = 0; y < b.height; y++ )
+  {
+    for( int x = 0; x < b.width; x++ )
+    {
+      b.dst[y * b.dstStride + x] = weightBidir( w0, b.src[0][y * b.srcStride + x], w1, b.src[1][y * b.srcStride + x], round, shift, offset, b.clpRng );
+    }
+  }
+
+  if( ( b.width & 7 ) == 0 )
+  {
+    simdOps.wghtAvg8( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, w0, w1, shift, add, b.clpRng );
+  }
+  else
+  {
+    simdOps.wghtAvg4( b.src[0].data(), b.srcStride, b.src[1].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, w0, w1, shift, add, b.clpRng );
+  }
+
+  if( b.dst != b.simdDst )
+  {
+    printf( "weighted bi-prediction: mismatch for %dx%d, bit depth %d, weights %d %d, denominator %d, offset %d, rounding %d\n", b.width, b.height, b.clpRng.bd,
+            w0, w1, log2Denom, offset, rounding );
+    return false;
+  }
+
+  return true;
+}
+
+/// uni-directional weighted prediction with the parameters of WeightPrediction::addWeightUni, an identity weight is
+/// applied with the reduced shift, the rounding is also checked switched off
+static bool testWeightUni( PelBufferOps& simdOps, std::mt19937& rng )
+{
+  TestBlock b( rng );
+
+  const int  log2Denom = randomRange( rng, 0, 7 );
+  const int  w0        = rng() % 4 == 0 ? 1 << log2Denom : ( 1 << log2Denom ) + randomRange( rng, -128, 127 );
+  const int  offset    = randomRange( rng, -128, 127 ) << ( b.clpRng.bd - 8 );
+  const bool rounding  = rng() % 2 == 0;
+
+  const int  shiftNum = std::max<int>( 2, IF_INTERNAL_PREC - b.clpRng.bd );
+  const bool weighted = w0 != 1 << log2Denom;
+  const int  scale    = weighted ? w0 : 1;
+  const int  rshift   = weighted ? log2Denom + shiftNum : shiftNum;
+  const int  round    = rounding && rshift > 0 ? 1 << ( rshift - 1 ) : 0;
+  const int  add      = scale * IF_INTERNAL_OFFS + round;
+
+  for( int y = 0; y < b.height; y++ )
+  {
+    for( int x = 0; x < b.width; x++ )
+    {
+      b.dst[y * b.dstStride + x] = weightUnidir( scale, b.src[0][y * b.srcStride + x], round, rshift, offset, b.clpRng );
+    }
+  }
+
+  if( ( b.width & 7 ) == 0 )
+  {
+    simdOps.wghtUni8( b.src[0].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, scale, add, rshift, offset, b.clpRng );
+  }
+  else
+  {
+    simdOps.wghtUni4( b.src[0].data(), b.srcStride, b.simdDst.data(), b.dstStride, b.width, b.height, scale, add, rshift, offset, b.clpRng );
+  }
+
+  if( b.dst != b.simdDst )
+  {
+    printf( "weighted uni-prediction: mismatch for %dx%d, bit depth %d, weight %d, denominator %d, offset %d, rounding %d\n", b.width, b.height, b.clpRng.bd,
+            w0, log2Denom, offset, rounding );
+    return false;
+  }
+
+  return true;
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+  // optional SIMD extension to test (SSE41, AVX2, ...), default: the highest supported extension
+  printf( "SIMD extension %s\n", read_x86_extension( argc > 1 ? argv[1] : "" ) );
+
+  PelBufferOps scalarOps;
+  PelBufferOps simdOps;
+  simdOps.initPelBufOpsX86();
+
+  std::mt19937 rng( 42 );
+  int          numFailed = 0;
+
+  for( int run = 0; run < NUM_RUNS; run++ )
+  {
+#if JVET_K0248_GBI
+    numFailed += testGbi( scalarOps, simdOps, rng ) ? 0 : 1;
+#endif
+    numFailed += testWeightBi ( simdOps, rng ) ? 0 : 1;
+    numFailed += testWeightUni( simdOps, rng ) ? 0 : 1;
+  }
+
+  printf( "%d blocks differ from the C++ code\n", numFailed );
+
+  return numFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "SIMD buffer kernels are disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}
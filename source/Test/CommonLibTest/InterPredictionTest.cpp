@@ -0,0 +1,394 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InterPredictionTest.cpp
+    \brief    compares the SIMD BIO, LIC and OBMC kernels with the C++ code on random input
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/InterPrediction.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if ( ENABLE_SIMD_OPT_BIO || ENABLE_SIMD_OPT_LIC || ENABLE_SIMD_OPT_OBMC ) && defined( TARGET_SIMD_X86 )
+static const int NUM_RUNS = 4000;
+
+/// inter prediction exposing the BIO, LIC and OBMC kernels, which are replaced by the SIMD versions in the constructor
+class InterPredictionSIMD : public InterPrediction
+{
+public:
+  InterPredictionSIMD()
+  {
+#if ENABLE_SIMD_OPT_BIO
+    bioGradFilter      = gradFilter;
+    bioDotProducts     = dotProducts;
+    bioCalcBlkGradient = calcBlkGradient;
+#endif
+#if ENABLE_SIMD_OPT_LIC
+    licCalcSums        = calcLICSums;
+#endif
+#if ENABLE_SIMD_OPT_OBMC
+    obmcBlend          = blendOBMC;
+#endif
+
+    initInterPredictionX86();
+  }
+
+#if ENABLE_SIMD_OPT_BIO
+  using InterPrediction::bioGradFilter;
+  using InterPrediction::bioDotProducts;
+  using InterPrediction::bioCalcBlkGradient;
+#endif
+#if ENABLE_SIMD_OPT_LIC
+  using InterPrediction::licCalcSums;
+#endif
+#if ENABLE_SIMD_OPT_OBMC
+  using InterPrediction::obmcBlend;
+#endif
+};
+
+static int randomRange( std::mt19937& rng, const int minVal, const int maxVal )
+{
+  return minVal + int( rng() % ( maxVal - minVal + 1 ) );
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BIO && defined( TARGET_SIMD_X86 )
+static const int EXT_SIZE = JVET_K0485_BIO_EXTEND_SIZE;
+
+/// fills the prediction with values of the intermediate precision around a random level
+static void fillRandom( std::vector<Pel>& buf, std::mt19937& rng )
+{
+  const int maxAbs    = 14400;
+  const int amplitude = rng() % 3 == 0 ? maxAbs : 1 + rng() % 2000;
+  const int level     = int( rng() % 16384 ) - 8192;
+
+  for( Pel& val : buf )
+  {
+    val = Pel( Clip3( -maxAbs, maxAbs, level + int( rng() % ( 2 * amplitude + 1 ) ) - amplitude ) );
+  }
+}
+
+/// runs the kernels in the order and with the buffer layout of applyBiOptFlow for a random block size
+static bool testBIO( InterPredictionSIMD& interPred, PelBufferOps& scalarOps, PelBufferOps& simdOps, std::mt19937& rng )
+{
+  const int width        = 4 * randomRange( rng, 1, MAX_CU_SIZE / 4 );
+  const int height       = 4 * randomRange( rng, 1, MAX_CU_SIZE / 4 );
+  const int widthG       = width  + 2 * EXT_SIZE;
+  const int heightG      = height + 2 * EXT_SIZE;
+  const int stridePredMC = widthG + 2;
+  const int offsetPos    = widthG * EXT_SIZE + EXT_SIZE;
+
+  std::vector<Pel> pred[2];
+  std::vector<Pel> gradX[2], gradY[2];
+  bool             ok = true;
+
+  // gradients, the prediction has a margin of one sample around the extended block
+  for( int refList = 0; refList < 2; refList++ )
+  {
+    pred[refList].resize( stridePredMC * ( heightG + 2 ) );
+    fillRandom( pred[refList], rng );
+
+    std::vector<Pel> simdGradX( widthG * heightG, 0x5a5a ), simdGradY( widthG * heightG, 0x5a5a );
+    gradX[refList].assign( widthG * heightG, 0x5a5a );
+    gradY[refList].assign( widthG * heightG, 0x5a5a );
+
+    Pel* src = &pred[refList][stridePredMC + 1];
+    InterPrediction::gradFilter( src, stridePredMC, widthG, heightG, widthG, gradX[refList].data(), gradY[refList].data() );
+    interPred.bioGradFilter    ( src, stridePredMC, widthG, heightG, widthG, simdGradX     .data(), simdGradY     .data() );
+
+    if( gradX[refList] != simdGradX || gradY[refList] != simdGradY )
+    {
+      printf( "gradient filter: mismatch for %dx%d\n", widthG, heightG );
+      ok = false;
+    }
+  }
+
+  const Pel* src0 = &pred[0][stridePredMC + 1];
+  const Pel* src1 = &pred[1][stridePredMC + 1];
+
+  // correlation products
+  std::vector<int64_t> dotProducts[5], simdDotProducts[5];
+  for( int k = 0; k < 5; k++ )
+  {
+    dotProducts    [k].assign( widthG * heightG, 0x5a5a5a5a );
+    simdDotProducts[k].assign( widthG * heightG, 0x5a5a5a5a );
+  }
+
+  InterPrediction::dotProducts( src0, stridePredMC, src1, stridePredMC, gradX[0].data(), gradX[1].data(), gradY[0].data(), gradY[1].data(), widthG, widthG, heightG,
+                                dotProducts[0].data(), dotProducts[1].data(), dotProducts[2].data(), dotProducts[3].data(), dotProducts[4].data() );
+  interPred.bioDotProducts    ( src0, stridePredMC, src1, stridePredMC, gradX[0].data(), gradX[1].data(), gradY[0].data(), gradY[1].data(), widthG, widthG, heightG,
+                                simdDotProducts[0].data(), simdDotProducts[1].data(), simdDotProducts[2].data(), simdDotProducts[3].data(), simdDotProducts[4].data() );
+
+  for( int k = 0; k < 5; k++ )
+  {
+    if( dotProducts[k] != simdDotProducts[k] )
+    {
+      printf( "dot products: mismatch of product %d for %dx%d\n", k, widthG, heightG );
+      ok = false;
+    }
+  }
+
+  // sums over the extended 4x4 units and the averaging of the units
+  const int bitDepth = rng() % 2 ? 8 : 10;
+  const int limit    = 16 << ( IF_INTERNAL_PREC - int( rng() % 2 ) - bitDepth );
+#if JVET_K0248_GBI
+  const int gbiIdx   = randomRange( rng, 0, GBI_NUM - 1 );
+#else
+  const int gbiIdx   = GBI_DEFAULT;
+#endif
+  const int shiftNum = IF_INTERNAL_PREC + ( gbiIdx != GBI_DEFAULT ? g_GbiLog2WeightBase : 1 ) - bitDepth;
+  const int offset   = ( 1 << ( shiftNum - 1 ) ) + ( gbiIdx != GBI_DEFAULT ? ( IF_INTERNAL_OFFS << g_GbiLog2WeightBase ) : 2 * IF_INTERNAL_OFFS );
+
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bitDepth ) - 1;
+  clpRng.bd  = bitDepth;
+
+  std::vector<Pel> dst( width * height, 0x5a5a ), simdDst( width * height, 0x5a5a );
+
+  for( int yu = 0; yu < ( height >> 2 ); yu++ )
+  {
+    for( int xu = 0; xu < ( width >> 2 ); xu++ )
+    {
+      const int posG = offsetPos + ( ( yu * widthG + xu ) << 2 );
+
+      // the callers start from zero, a non-zero start also checks the accumulation into the outputs
+      int64_t sums[5], simdSums[5];
+      for( int k = 0; k < 5; k++ )
+      {
+        sums[k] = simdSums[k] = int64_t( rng() ) - ( 1ll << 31 );
+      }
+
+      InterPrediction::calcBlkGradient( xu << 2, yu << 2, &dotProducts[0][posG], &dotProducts[1][posG], &dotProducts[2][posG], &dotProducts[3][posG], &dotProducts[4][posG],
+                                        sums[0], sums[1], sums[2], sums[3], sums[4], widthG, heightG, 1 << 2 );
+      interPred.bioCalcBlkGradient    ( xu << 2, yu << 2, &dotProducts[0][posG], &dotProducts[1][posG], &dotProducts[2][posG], &dotProducts[3][posG], &dotProducts[4][posG],
+                                        simdSums[0], simdSums[1], simdSums[2], simdSums[3], simdSums[4], widthG, heightG, 1 << 2 );
+
+      if( !std::equal( sums, sums + 5, simdSums ) )
+      {
+        printf( "block gradient sums: mismatch for unit %d,%d of %dx%d\n", xu, yu, width, height );
+        ok = false;
+      }
+
+      const int tmpx = randomRange( rng, -limit, limit );
+      const int tmpy = randomRange( rng, -limit, limit );
+
+      const int posSrc = stridePredMC + 1 + ( ( yu * stridePredMC + xu ) << 2 );
+      const int posDst = ( yu * width + xu ) << 2;
+
+#if JVET_K0248_GBI
+      if( gbiIdx != GBI_DEFAULT )
+      {
+        scalarOps.addBIOAvg4GBI( src0 + posSrc, stridePredMC, src1 + posSrc, stridePredMC, &dst    [posDst], width, &gradX[0][posG], &gradX[1][posG], &gradY[0][posG], &gradY[1][posG], widthG,
+                                 1 << 2, 1 << 2, tmpx, tmpy, shiftNum, offset, clpRng, gbiIdx );
+        simdOps  .addBIOAvg4GBI( src0 + posSrc, stridePredMC, src1 + posSrc, stridePredMC, &simdDst[posDst], width, &gradX[0][posG], &gradX[1][posG], &gradY[0][posG], &gradY[1][posG], widthG,
+                                 1 << 2, 1 << 2, tmpx, tmpy, shiftNum, offset, clpRng, gbiIdx );
+      }
+      else
+#endif
+      {
+        scalarOps.addBIOAvg4   ( src0 + posSrc, stridePredMC, src1 + posSrc, stridePredMC, &dst    [posDst], width, &gradX[0][posG], &gradX[1][posG], &gradY[0][posG], &gradY[1][posG], widthG,
+                                 1 << 2, 1 << 2, tmpx, tmpy, shiftNum, offset, clpRng );
+        simdOps  .addBIOAvg4   ( src0 + posSrc, stridePredMC, src1 + posSrc, stridePredMC, &simdDst[posDst], width, &gradX[0][posG], &gradX[1][posG], &gradY[0][posG], &gradY[1][posG], widthG,
+                                 1 << 2, 1 << 2, tmpx, tmpy, shiftNum, offset, clpRng );
+      }
+    }
+  }
+
+  if( dst != simdDst )
+  {
+    printf( "BIO averaging: mismatch for %dx%d, bit depth %d, GBi index %d\n", width, height, bitDepth, gbiIdx );
+    ok = false;
+  }
+
+  return ok;
+}
+#endif
+
+#if ENABLE_SIMD_OPT_LIC && defined( TARGET_SIMD_X86 )
+/// accumulates the template sums of the above row and the left column as xGetLICParams, for every subsampling the bit
+/// depth allows and lengths that are multiples of the number of steps or not
+static bool testLICSums( InterPredictionSIMD& interPred, std::mt19937& rng )
+{
+  const int bitDepth     = randomRange( rng, 8, 12 );
+  const int maxNumMinus1 = 30 - 2 * bitDepth - 1;
+  const int dimShift     = randomRange( rng, 0, std::min<int>( MAX_CU_DEPTH, maxNumMinus1 ) );
+  const int numSteps     = 1 << dimShift;
+  const int maxVal       = ( 1 << bitDepth ) - 1;
+  bool      ok           = true;
+
+  int length[2];
+  for( int i = 0; i < 2; i++ )
+  {
+    length[i] = rng() % 2 ? numSteps * randomRange( rng, 1, MAX_CU_SIZE >> dimShift ) : randomRange( rng, numSteps, MAX_CU_SIZE );
+  }
+
+  // the above rows are contiguous, the left columns have the strides of the reference and the current picture
+  const int refStride[2] = { 1, randomRange( rng, 2, 2 * MAX_CU_SIZE ) };
+  const int recStride[2] = { 1, randomRange( rng, 2, 2 * MAX_CU_SIZE ) };
+
+  std::vector<Pel> ref[2], rec[2];
+  for( int i = 0; i < 2; i++ )
+  {
+    const bool saturated = rng() % 4 == 0;
+
+    ref[i].resize( refStride[i] * length[i] );
+    rec[i].resize( recStride[i] * length[i] );
+    for( Pel& val : ref[i] )
+    {
+      val = Pel( saturated ? maxVal : randomRange( rng, 0, maxVal ) );
+    }
+    for( Pel& val : rec[i] )
+    {
+      val = Pel( saturated ? maxVal : randomRange( rng, 0, maxVal ) );
+    }
+  }
+
+  int sums[4]     = { 0, 0, 0, 0 };
+  int simdSums[4] = { 0, 0, 0, 0 };
+
+  for( int i = 0; i < 2; i++ )
+  {
+    InterPrediction::calcLICSums( ref[i].data(), refStride[i], rec[i].data(), recStride[i], length[i], dimShift, 0, sums    [0], sums    [1], sums    [2], sums    [3] );
+    interPred.licCalcSums       ( ref[i].data(), refStride[i], rec[i].data(), recStride[i], length[i], dimShift, 0, simdSums[0], simdSums[1], simdSums[2], simdSums[3] );
+
+    if( !std::equal( sums, sums + 4, simdSums ) )
+    {
+      printf( "LIC sums: mismatch for length %d, strides %d %d, dimShift %d, bit depth %d\n", length[i], refStride[i], recStride[i], dimShift, bitDepth );
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+#endif
+
+#if ENABLE_SIMD_OPT_OBMC && defined( TARGET_SIMD_X86 )
+/// blends or subtracts a neighbour prediction along a random boundary with the line counts of xSubblockOBMC, luma and
+/// chroma with and without the simplified OBMC, on block sizes that take the 16, 8 and 4 sample wide paths and the
+/// fallback of the widths that are no multiple of four, the samples around the block must stay untouched
+static bool testOBMCBlend( InterPredictionSIMD& interPred, std::mt19937& rng )
+{
+  static const int numLinesList[3] = { 1, 2, 4 };
+
+  const int  dir       = randomRange( rng, 0, 3 );
+  const int  numLines  = numLinesList[rng() % 3];
+  const bool subtract  = rng() % 2 != 0;
+  const int  bitDepth  = randomRange( rng, 8, 12 );
+  const int  maxVal    = ( 1 << bitDepth ) - 1;
+  const bool rows      = dir == 0 || dir == 2;
+  const int  minWidth  = rows ? 2 : std::max( numLines, 2 );
+  const int  minHeight = rows ? std::max( numLines, 2 ) : 2;
+  const int  width     = 2 * randomRange( rng, minWidth  / 2, MAX_CU_SIZE / 2 );
+  const int  height    = 2 * randomRange( rng, minHeight / 2, MAX_CU_SIZE / 2 );
+  const int  dstStride = width + randomRange( rng, 0, 16 );
+  const int  srcStride = width + randomRange( rng, 0, 16 );
+
+  std::vector<Pel> dst( dstStride * ( height + 1 ) ), src( srcStride * height );
+  for( Pel& val : dst )
+  {
+    val = Pel( randomRange( rng, 0, maxVal ) );
+  }
+  for( Pel& val : src )
+  {
+    val = Pel( randomRange( rng, 0, maxVal ) );
+  }
+
+  // the row below the block catches writes past the last line
+  std::vector<Pel> simdDst = dst;
+
+  InterPrediction::blendOBMC( dst    .data(), dstStride, src.data(), srcStride, width, height, dir, numLines, subtract );
+  interPred.obmcBlend       ( simdDst.data(), dstStride, src.data(), srcStride, width, height, dir, numLines, subtract );
+
+  if( dst != simdDst )
+  {
+    printf( "OBMC %s: mismatch for %dx%d, strides %d %d, direction %d, %d lines, bit depth %d\n", subtract ? "subtraction" : "blending",
+            width, height, dstStride, srcStride, dir, numLines, bitDepth );
+    return false;
+  }
+
+  return true;
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if ( ENABLE_SIMD_OPT_BIO || ENABLE_SIMD_OPT_LIC || ENABLE_SIMD_OPT_OBMC ) && defined( TARGET_SIMD_X86 )
+  // optional SIMD extension to test (SSE41, AVX2, ...), default: the highest supported extension
+  printf( "SIMD extension %s\n", read_x86_extension( argc > 1 ? argv[1] : "" ) );
+
+  // the kernels use large member buffers
+  InterPredictionSIMD* interPred = new InterPredictionSIMD;
+
+#if ENABLE_SIMD_OPT_BIO
+  PelBufferOps scalarOps;
+  PelBufferOps simdOps;
+  simdOps.initPelBufOpsX86();
+#endif
+
+  std::mt19937 rng( 42 );
+  int          numFailed = 0;
+
+  for( int run = 0; run < NUM_RUNS; run++ )
+  {
+#if ENABLE_SIMD_OPT_BIO
+    numFailed += testBIO( *interPred, scalarOps, simdOps, rng ) ? 0 : 1;
+#endif
+#if ENABLE_SIMD_OPT_LIC
+    numFailed += testLICSums( *interPred, rng ) ? 0 : 1;
+#endif
+#if ENABLE_SIMD_OPT_OBMC
+    numFailed += testOBMCBlend( *interPred, rng ) ? 0 : 1;
+#endif
+  }
+
+  delete interPred;
+
+  printf( "%d blocks differ from the C++ code\n", numFailed );
+
+  return numFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "SIMD BIO, LIC and OBMC kernels are disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}
@@ -0,0 +1,222 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     RdCostTest.cpp
+    \brief    compares the SIMD mean-removed SAD kernels with the C++ code on random input
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/RdCost.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if ENABLE_SIMD_OPT_DIST && defined( TARGET_SIMD_X86 )
+static const int NUM_RUNS = 4000;
+static const int NUM_DMVR_CAND = 4;
+
+/// RD cost exposing the C++ kernels, the distortion functions selected by setDistParam are the SIMD versions
+class RdCostScalar : public RdCost
+{
+public:
+  using RdCost::xGetMRSAD4;
+  using RdCost::xGetMRSAD8;
+  using RdCost::xGetMRSAD12;
+  using RdCost::xGetMRSAD16;
+  using RdCost::xGetMRSAD24;
+  using RdCost::xGetMRSAD32;
+  using RdCost::xGetMRSAD48;
+  using RdCost::xGetMRSAD64;
+  using RdCost::xGetMRSAD16N;
+#if DMVR_JVET_K0217
+  using RdCost::xGetDMVRCosts;
+#endif
+};
+
+/// the block widths with a kernel of their own and the C++ kernel setDistParam selects for them
+static const struct
+{
+  int        width;
+  FpDistFunc scalarFunc;
+} mrsadWidths[] =
+{
+  {   4, RdCostScalar::xGetMRSAD4   },
+  {   8, RdCostScalar::xGetMRSAD8   },
+  {  12, RdCostScalar::xGetMRSAD12  },
+  {  16, RdCostScalar::xGetMRSAD16  },
+  {  24, RdCostScalar::xGetMRSAD24  },
+  {  32, RdCostScalar::xGetMRSAD32  },
+  {  48, RdCostScalar::xGetMRSAD48  },
+  {  64, RdCostScalar::xGetMRSAD64  },
+  { 128, RdCostScalar::xGetMRSAD16N },
+};
+
+static int randomRange( std::mt19937& rng, const int minVal, const int maxVal )
+{
+  return minVal + int( rng() % ( maxVal - minVal + 1 ) );
+}
+
+/// fills the block with samples or, as for the DMVR search, with predictions at the intermediate precision around a
+/// random level
+static void fillRandom( std::vector<Pel>& buf, std::mt19937& rng )
+{
+  const bool internal  = rng() % 2 == 0;
+  const int  minVal    = internal ? -14400 : 0;
+  const int  maxVal    = internal ?  14400 : 1023;
+  const int  amplitude = rng() % 3 == 0 ? maxVal - minVal : 1 + rng() % 200;
+  const int  level     = randomRange( rng, minVal, maxVal );
+
+  for( Pel& val : buf )
+  {
+    val = Pel( Clip3( minVal, maxVal, level + int( rng() % ( 2 * amplitude + 1 ) ) - amplitude ) );
+  }
+}
+
+/// mean-removed SAD of a random block, every row or only every ( 1 << subShift )-th one
+static bool testMRSAD( RdCostScalar& rdCost, std::mt19937& rng )
+{
+  const auto& entry = mrsadWidths[rng() % ( sizeof( mrsadWidths ) / sizeof( mrsadWidths[0] ) )];
+  if( entry.width > MAX_CU_SIZE )
+  {
+    return true;
+  }
+
+  const int width    = entry.width;
+  const int subShift = randomRange( rng, 0, 3 );
+  const int height   = ( 1 << subShift ) * randomRange( rng, 1, MAX_CU_SIZE >> subShift );
+  const int stride   = width + randomRange( rng, 0, 7 );
+  const int bitDepth = 8 + 2 * int( rng() % 3 );
+
+  std::vector<Pel> org( stride * height ), cur( stride * height );
+  fillRandom( org, rng );
+  fillRandom( cur, rng );
+
+  DistParam distParam;
+  distParam.useMR = true;
+  rdCost.setDistParam( distParam, CPelBuf( org.data(), stride, width, height ), CPelBuf( cur.data(), stride, width, height ), bitDepth, COMPONENT_Y );
+  distParam.subShift = subShift;
+
+  const Distortion dist     = entry.scalarFunc( distParam );
+  const Distortion simdDist = distParam.distFunc( distParam );
+
+  if( dist != simdDist )
+  {
+    printf( "MRSAD: mismatch for %dx%d, sub shift %d, bit depth %d: %llu != %llu\n", width, height, subShift, bitDepth,
+            ( unsigned long long ) dist, ( unsigned long long ) simdDist );
+    return false;
+  }
+
+  return true;
+}
+
+#if DMVR_JVET_K0217
+/// costs of up to four DMVR search points, which are shifted by at most one sample against each other in both lists
+static bool testDMVRCosts( std::mt19937& rng )
+{
+  const int width   = mrsadWidths[rng() % ( sizeof( mrsadWidths ) / sizeof( mrsadWidths[0] ) - 1 )].width;
+  const int height  = randomRange( rng, 1, 64 );
+  const int stride  = width + 2 + randomRange( rng, 0, 7 );
+  const int numCand = randomRange( rng, 1, NUM_DMVR_CAND );
+
+  std::vector<Pel> src[2];
+  for( int i = 0; i < 2; i++ )
+  {
+    src[i].resize( stride * ( height + 2 ) );
+    fillRandom( src[i], rng );
+  }
+
+  const Pel* srcL0[NUM_DMVR_CAND];
+  const Pel* srcL1[NUM_DMVR_CAND];
+  int        deltas[NUM_DMVR_CAND];
+  for( int c = 0; c < numCand; c++ )
+  {
+    const int dx = randomRange( rng, -1, 1 );
+    const int dy = randomRange( rng, -1, 1 );
+
+    // the search points are mirrored in the two lists
+    srcL0[c]  = &src[0][( 1 + dy ) * stride + 1 + dx];
+    srcL1[c]  = &src[1][( 1 - dy ) * stride + 1 - dx];
+    deltas[c] = rng() % 4 == 0 ? 0 : randomRange( rng, -4000, 4000 );
+  }
+
+  Distortion costs[NUM_DMVR_CAND], simdCosts[NUM_DMVR_CAND];
+  RdCostScalar::xGetDMVRCosts( srcL0, srcL1, stride, width, height, deltas, numCand, costs );
+  RdCost::getDMVRCosts       ( srcL0, srcL1, stride, width, height, deltas, numCand, simdCosts );
+
+  if( !std::equal( costs, costs + numCand, simdCosts ) )
+  {
+    printf( "DMVR costs: mismatch for %dx%d, %d candidates\n", width, height, numCand );
+    return false;
+  }
+
+  return true;
+}
+#endif
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if ENABLE_SIMD_OPT_DIST && defined( TARGET_SIMD_X86 )
+  // optional SIMD extension to test (SSE41, AVX2, ...), default: the highest supported extension
+  printf( "SIMD extension %s\n", read_x86_extension( argc > 1 ? argv[1] : "" ) );
+
+  // the constructor selects the SIMD kernels
+  RdCostScalar rdCost;
+
+  std::mt19937 rng( 42 );
+  int          numFailed = 0;
+
+  for( int run = 0; run < NUM_RUNS; run++ )
+  {
+    numFailed += testMRSAD( rdCost, rng ) ? 0 : 1;
+#if DMVR_JVET_K0217
+    numFailed += testDMVRCosts( rng ) ? 0 : 1;
+#endif
+  }
+
+  printf( "%d blocks differ from the C++ code\n", numFailed );
+
+  return numFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "SIMD distortion kernels are disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}
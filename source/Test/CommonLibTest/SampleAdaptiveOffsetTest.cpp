@@ -0,0 +1,168 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     SampleAdaptiveOffsetTest.cpp
+    \brief    compares the SIMD SAO offset kernels with the C++ code on random input
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if ENABLE_SIMD_OPT_SAO && defined( TARGET_SIMD_X86 )
+static const int NUM_RUNS = 20000;
+static const int MAX_SIZE = 72;
+
+/// SAO exposing the block offsetting, which splits the block into the first, middle and last rectangles for the kernels
+class SampleAdaptiveOffsetSIMD : public SampleAdaptiveOffset
+{
+public:
+  using SampleAdaptiveOffset::offsetBlock;
+};
+
+static int randomRange( std::mt19937& rng, const int minVal, const int maxVal )
+{
+  return minVal + int( rng() % ( maxVal - minVal + 1 ) );
+}
+
+/// fills the samples uniformly or from a few levels, which gives flat edge classes and samples at the clipping bounds
+static void fillRandom( std::vector<Pel>& buf, const int bitDepth, std::mt19937& rng )
+{
+  const int maxVal    = ( 1 << bitDepth ) - 1;
+  const int level     = randomRange( rng, 0, maxVal );
+  const int levels[5] = { 0, 1, level, maxVal - 1, maxVal };
+  const bool uniform  = rng() % 2 == 0;
+
+  for( Pel& val : buf )
+  {
+    val = Pel( uniform ? randomRange( rng, 0, maxVal ) : levels[rng() % 5] );
+  }
+}
+
+/// offsets a block of random size, class and neighbour availability with the C++ and the SIMD kernels
+static bool testBlock( SampleAdaptiveOffsetSIMD& sao, std::mt19937& rng )
+{
+  const int bitDepth  = 8 + 2 * int( rng() % 3 );
+  const int typeIdx   = randomRange( rng, SAO_TYPE_START_EO, NUM_SAO_NEW_TYPES - 1 );
+  const int width     = randomRange( rng, 4, MAX_SIZE );
+  const int height    = randomRange( rng, 4, MAX_SIZE );
+  const int srcStride = width + 2 + randomRange( rng, 0, 7 );
+  const int resStride = width + randomRange( rng, 0, 7 );
+
+  bool avail[8];
+  for( bool& a : avail )
+  {
+    a = rng() % 2 == 0;
+  }
+
+  // the largest offsets the SPS allows, scaled to the bit depth
+  const int maxOffset = SampleAdaptiveOffset::getMaxOffsetQVal( bitDepth ) << std::max( 0, bitDepth - 10 );
+  int offset[MAX_NUM_SAO_CLASSES];
+  for( int& off : offset )
+  {
+    off = randomRange( rng, -maxOffset, maxOffset );
+  }
+
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bitDepth ) - 1;
+  clpRng.bd  = bitDepth;
+
+  // the source has a margin of one sample for the neighbours
+  std::vector<Pel> src( srcStride * ( height + 2 ) );
+  fillRandom( src, bitDepth, rng );
+
+  std::vector<Pel> res( resStride * height, 0x5a5a ), simdRes( resStride * height, 0x5a5a );
+
+  const auto simdOffsetEO = sao.m_offsetEO;
+  const auto simdOffsetBO = sao.m_offsetBO;
+
+  sao.m_offsetEO = SampleAdaptiveOffset::offsetEO;
+  sao.m_offsetBO = SampleAdaptiveOffset::offsetBO;
+  sao.offsetBlock( bitDepth, clpRng, typeIdx, offset, &src[srcStride + 1], res.data(), srcStride, resStride, width, height,
+                   avail[0], avail[1], avail[2], avail[3], avail[4], avail[5], avail[6], avail[7] );
+
+  sao.m_offsetEO = simdOffsetEO;
+  sao.m_offsetBO = simdOffsetBO;
+  sao.offsetBlock( bitDepth, clpRng, typeIdx, offset, &src[srcStride + 1], simdRes.data(), srcStride, resStride, width, height,
+                   avail[0], avail[1], avail[2], avail[3], avail[4], avail[5], avail[6], avail[7] );
+
+  if( res != simdRes )
+  {
+    printf( "SAO type %d: mismatch for %dx%d, bit depth %d, availability %d%d%d%d%d%d%d%d\n", typeIdx, width, height, bitDepth,
+            avail[0], avail[1], avail[2], avail[3], avail[4], avail[5], avail[6], avail[7] );
+    return false;
+  }
+
+  return true;
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if ENABLE_SIMD_OPT_SAO && defined( TARGET_SIMD_X86 )
+  // optional SIMD extension to test (SSE41, AVX2, ...), default: the highest supported extension
+  printf( "SIMD extension %s\n", read_x86_extension( argc > 1 ? argv[1] : "" ) );
+
+  // the constructor selects the SIMD kernels
+  SampleAdaptiveOffsetSIMD sao;
+
+  std::mt19937 rng( 42 );
+  int          numFailed = 0;
+
+  for( int run = 0; run < NUM_RUNS; run++ )
+  {
+    if( !testBlock( sao, rng ) )
+    {
+      numFailed++;
+    }
+  }
+
+  printf( "%d of %d blocks differ from the C++ code\n", numFailed, NUM_RUNS );
+
+  return numFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "SIMD SAO kernels are disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}
@@ -0,0 +1,180 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantTest.cpp
+    \brief    compares the SIMD transforms with the C++ partial butterflies on random input
+*/
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Rom.h"
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/TrQuant_EMT.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+//! \ingroup CommonLibTest
+//! \{
+
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 )
+static const int NUM_RUNS = 20;
+
+static const char* const trTypeName[NUM_TRANS_TYPE] = { "DCT-II", "DCT-VIII", "DST-VII" };
+
+/// fills the input of the reduced lines and the first cutoff positions, as the callers zero the remaining ones
+static void fillRandom( std::vector<TCoeff>& buf, std::mt19937& rng, const int range, const int trSize, const int line, const int reducedLine, const int cutoff, const bool transposed )
+{
+  std::uniform_int_distribution<int> dist( -range, range - 1 );
+
+  for( int i = 0; i < line; i++ )
+  {
+    for( int n = 0; n < trSize; n++ )
+    {
+      buf[transposed ? n * line + i : i * trSize + n] = i < reducedLine && n < cutoff ? dist( rng ) : 0;
+    }
+  }
+}
+
+static bool testTransform( const int trType, const int sizeIdx, FwdTrans* scalarFwd, FwdTrans* simdFwd, InvTrans* scalarInv, InvTrans* simdInv, std::mt19937& rng )
+{
+  const int trSize = 1 << ( sizeIdx + 1 );
+  bool      ok     = true;
+
+  std::vector<TCoeff> src( trSize * MAX_TU_SIZE ), dstScalar( trSize * MAX_TU_SIZE ), dstSimd( trSize * MAX_TU_SIZE );
+
+  for( int line = 2; line <= MAX_TU_SIZE; line <<= 1 )
+  {
+    for( int iSkipLine = 0; iSkipLine < line; iSkipLine += std::max( 1, line >> 2 ) )
+    {
+      // the callers zero out the upper half of the 64-point DCT-II and optionally of all 32-point transforms
+      for( int iSkipLine2 = trSize == 64 ? 32 : 0; iSkipLine2 <= ( trSize >= 32 ? trSize >> 1 : 0 ); iSkipLine2 += std::max( 1, trSize >> 1 ) )
+      {
+        const int reducedLine = line - iSkipLine;
+        const int cutoff      = trSize - iSkipLine2;
+
+        for( int run = 0; run < NUM_RUNS && ok; run++ )
+        {
+          const int shift = 1 + run % 12;
+
+          // forward, the lines of the input are the rows of the block
+          fillRandom( src, rng, 1 << 15, trSize, line, reducedLine, trSize, false );
+          std::fill( dstScalar.begin(), dstScalar.end(), 0x5a5a5a5a );
+          std::fill( dstSimd  .begin(), dstSimd  .end(), 0x5a5a5a5a );
+
+          scalarFwd( src.data(), dstScalar.data(), shift, line, iSkipLine, iSkipLine2 );
+          simdFwd  ( src.data(), dstSimd  .data(), shift, line, iSkipLine, iSkipLine2 );
+
+          if( dstScalar != dstSimd )
+          {
+            printf( "forward %s %d-point: mismatch for %d lines, skip line %d, skip line2 %d, shift %d\n", trTypeName[trType], trSize, line, iSkipLine, iSkipLine2, shift );
+            ok = false;
+          }
+
+          // inverse, the coefficients of a line are spread over the rows
+          fillRandom( src, rng, 1 << 15, trSize, line, reducedLine, cutoff, true );
+          std::fill( dstScalar.begin(), dstScalar.end(), 0x5a5a5a5a );
+          std::fill( dstSimd  .begin(), dstSimd  .end(), 0x5a5a5a5a );
+
+          const TCoeff outputMinimum = -( 1 << ( 8 + run % 8 ) );
+          const TCoeff outputMaximum =  ( 1 << ( 8 + run % 8 ) ) - 1;
+
+          scalarInv( src.data(), dstScalar.data(), shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum );
+          simdInv  ( src.data(), dstSimd  .data(), shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum );
+
+          if( dstScalar != dstSimd )
+          {
+            printf( "inverse %s %d-point: mismatch for %d lines, skip line %d, skip line2 %d, shift %d\n", trTypeName[trType], trSize, line, iSkipLine, iSkipLine2, shift );
+            ok = false;
+          }
+        }
+      }
+    }
+  }
+
+  return ok;
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 )
+  // optional SIMD extension to test (SSE41, AVX2, ...), default: the highest supported extension
+  printf( "SIMD extension %s\n", read_x86_extension( argc > 1 ? argv[1] : "" ) );
+
+  initROM();
+
+  FwdTrans* scalarFwd[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  InvTrans* scalarInv[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  memcpy( scalarFwd, fastFwdTrans, sizeof( scalarFwd ) );
+  memcpy( scalarInv, fastInvTrans, sizeof( scalarInv ) );
+
+  // the construction replaces the entries of the transform tables by the SIMD kernels
+  TrQuant trQuant;
+
+  std::mt19937 rng( 42 );
+  int          numFailed = 0;
+  int          numTested = 0;
+
+  for( int trType = 0; trType < NUM_TRANS_TYPE; trType++ )
+  {
+    for( int sizeIdx = 0; sizeIdx < g_numTransformMatrixSizes; sizeIdx++ )
+    {
+      if( fastFwdTrans[trType][sizeIdx] == scalarFwd[trType][sizeIdx] && fastInvTrans[trType][sizeIdx] == scalarInv[trType][sizeIdx] )
+      {
+        continue;
+      }
+
+      numTested++;
+      if( !testTransform( trType, sizeIdx, scalarFwd[trType][sizeIdx], fastFwdTrans[trType][sizeIdx], scalarInv[trType][sizeIdx], fastInvTrans[trType][sizeIdx], rng ) )
+      {
+        numFailed++;
+      }
+    }
+  }
+
+  destroyROM();
+
+  printf( "%d of %d transforms differ from the C++ code\n", numFailed, numTested );
+
+  return numFailed || !numTested ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+  printf( "SIMD transforms are disabled\n" );
+
+  return EXIT_SUCCESS;
+#endif
+}
+
+//! \}